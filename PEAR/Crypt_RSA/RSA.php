@@ -364,6 +364,7 @@ class Crypt_RSA extends Crypt_RSA_ErrorHandler
         $plain_data = $this->_math_obj->bin2int($plain_data);
         $exp = $this->_math_obj->bin2int($key->getExponent());
         $modulus = $this->_math_obj->bin2int($key->getModulus());
+        $crt_params = $this->_getCrtParams($key);
 
         // divide plain data into chunks
         $data_len = $this->_math_obj->bitLen($plain_data);
@@ -374,7 +375,7 @@ class Crypt_RSA extends Crypt_RSA_ErrorHandler
         while ($curr_pos < $data_len) {
             $tmp = $this->_math_obj->subint($plain_data, $curr_pos, $chunk_len);
             $enc_data .= str_pad(
-                $this->_math_obj->int2bin($this->_math_obj->powmod($tmp, $exp, $modulus)),
+                $this->_math_obj->int2bin($this->_powmod($tmp, $exp, $modulus, $crt_params)),
                 $block_len,
                 "\0"
             );
@@ -422,6 +423,7 @@ class Crypt_RSA extends Crypt_RSA_ErrorHandler
 
         $exp = $this->_math_obj->bin2int($key->getExponent());
         $modulus = $this->_math_obj->bin2int($key->getModulus());
+        $crt_params = $this->_getCrtParams($key);
 
         $data_len = strlen($enc_data);
         $chunk_len = $key->getKeyLength() - 1;
@@ -431,7 +433,7 @@ class Crypt_RSA extends Crypt_RSA_ErrorHandler
         $plain_data = $this->_math_obj->bin2int("\0");
         while ($curr_pos < $data_len) {
             $tmp = $this->_math_obj->bin2int(substr($enc_data, $curr_pos, $block_len));
-            $tmp = $this->_math_obj->powmod($tmp, $exp, $modulus);
+            $tmp = $this->_powmod($tmp, $exp, $modulus, $crt_params);
             $plain_data = $this->_math_obj->bitOr($plain_data, $tmp, $bit_pos);
             $bit_pos += $chunk_len;
             $curr_pos += $block_len;
@@ -532,6 +534,49 @@ class Crypt_RSA extends Crypt_RSA_ErrorHandler
 
         return $hash_func($document) == $this->decrypt($signature, $public_key);
     }
+
+    /**
+     * Returns CRT parameters of private key $key, transformed into native
+     * form of math wrapper, or null, if $key has no CRT parameters.
+     * See Crypt_RSA_Key::setCrtParams() for details.
+     *
+     * @param object $key  key (object of Crypt_RSA_Key class)
+     * @return mixed       array($p, $q, $dp, $dq, $qinv) or null
+     * @access private
+     */
+    function _getCrtParams($key)
+    {
+        $crt_params = $key->getCrtParams();
+        if (is_null($crt_params)) {
+            return null;
+        }
+        $result = array();
+        foreach ($crt_params as $param) {
+            $result[] = $this->_math_obj->bin2int($param);
+        }
+        return $result;
+    }
+
+    /**
+     * Calculates pow($num, $exp) (mod $modulus). If $crt_params
+     * isn't null, then uses them instead of $exp and $modulus
+     * for faster calculation by Chinese remainder theorem.
+     *
+     * @param mixed $num         number in native form of math wrapper
+     * @param mixed $exp         exponent in native form of math wrapper
+     * @param mixed $modulus     modulus in native form of math wrapper
+     * @param mixed $crt_params  result of _getCrtParams()
+     * @return mixed             result in native form of math wrapper
+     * @access private
+     */
+    function _powmod($num, $exp, $modulus, $crt_params)
+    {
+        if (is_null($crt_params)) {
+            return $this->_math_obj->powmod($num, $exp, $modulus);
+        }
+        list($p, $q, $dp, $dq, $qinv) = $crt_params;
+        return $this->_math_obj->powmodCrt($num, $p, $q, $dp, $dq, $qinv);
+    }
 }
 
 ?>
\ No newline at end of file
@@ -42,6 +42,8 @@ require_once 'Crypt/RSA/MathLoader.php';
  *  - getExponent() - returns key exponent as binary string
  *  - getModulus() - returns key modulus as binary string
  *  - getKeyType() - returns type of the key (public or private)
+ *  - setCrtParams($p, $q, $dp, $dq, $qinv) - sets CRT parameters of private key
+ *  - getCrtParams() - returns CRT parameters of private key as array of binary strings
  *  - toString() - returns serialized key as string
  *  - fromString($key_str) - static function; returns key, unserialized from string
  *  - isValid($key) - static function for validating of $key
@@ -129,6 +131,15 @@ class Crypt_RSA_Key extends Crypt_RSA_ErrorHandler
      */
     var $_key_type;
 
+    /**
+     * CRT parameters of private key as array of binary strings
+     * ($p, $q, $dp, $dq, $qinv) or null, if they are unknown
+     *
+     * @var array
+     * @access private
+     */
+    var $_crt_params = null;
+
     /**
      * key length in bits
      *
@@ -263,6 +274,48 @@ class Crypt_RSA_Key extends Crypt_RSA_ErrorHandler
         return $this->_key_type;
     }
 
+    /**
+     * Sets CRT parameters of private key. They allow to perform
+     * private key operation by two exponentiations with half-size
+     * moduli $p and $q, which is about 3-4 times faster. All parameters
+     * are binary strings:
+     *     $p, $q - prime factors of modulus,
+     *     $dp = $exp (mod $p - 1),
+     *     $dq = $exp (mod $q - 1),
+     *     $qinv * $q = 1 (mod $p)
+     *
+     * @param string $p
+     * @param string $q
+     * @param string $dp
+     * @param string $dq
+     * @param string $qinv
+     * @return bool         true on success or false on error
+     * @access public
+     */
+    function setCrtParams($p, $q, $dp, $dq, $qinv)
+    {
+        if ($this->_key_type != 'private') {
+            $obj = PEAR::raiseError('CRT parameters can be set only for private key', CRYPT_RSA_ERROR_NEED_PRV_KEY);
+            $this->pushError($obj); // push error object into error list
+            return false;
+        }
+        $this->_crt_params = array($p, $q, $dp, $dq, $qinv);
+        return true;
+    }
+
+    /**
+     * Returns CRT parameters of private key as array of binary strings
+     * ($p, $q, $dp, $dq, $qinv) or null, if they are unknown.
+     * See setCrtParams() for details.
+     *
+     * @return mixed  array of CRT parameters or null
+     * @access public
+     */
+    function getCrtParams()
+    {
+        return $this->_crt_params;
+    }
+
     /**
      * Returns string representation of key
      *
@@ -276,6 +329,7 @@ class Crypt_RSA_Key extends Crypt_RSA_ErrorHandler
                 $this->_modulus,
                 $this->_exp,
                 $this->_key_type,
+                $this->_crt_params,
             ))
         );
     }
@@ -297,8 +351,14 @@ class Crypt_RSA_Key extends Crypt_RSA_ErrorHandler
      */
     function &fromString($key_str, $wrapper_name = 'default')
     {
-        list($modulus, $exponent, $key_type) = unserialize(base64_decode($key_str));
+        $key_arr = unserialize(base64_decode($key_str));
+        list($modulus, $exponent, $key_type) = $key_arr;
         $obj = &new Crypt_RSA_Key($modulus, $exponent, $key_type, $wrapper_name);
+        if (!$obj->isError() && isset($key_arr[3])) {
+            // CRT parameters are missing in keys, serialized by older versions
+            list($p, $q, $dp, $dq, $qinv) = $key_arr[3];
+            $obj->setCrtParams($p, $q, $dp, $dq, $qinv);
+        }
         return $obj;
     }
 
@@ -271,6 +271,12 @@ class Crypt_RSA_KeyPair extends Crypt_RSA_ErrorHandler
         } while (true);
         $d = $this->_math_obj->invmod($e, $pq);
 
+        // CRT parameters of private key. $d (mod $p - 1) is equal to inverse
+        // of $e (mod $p - 1), because $d * $e = 1 (mod ($p - 1) * ($q - 1))
+        $dp = $this->_math_obj->invmod($e, $this->_math_obj->dec($p));
+        $dq = $this->_math_obj->invmod($e, $this->_math_obj->dec($q));
+        $qinv = $this->_math_obj->invmod($q, $p);
+
         $modulus = $this->_math_obj->int2bin($n);
         $public_exp = $this->_math_obj->int2bin($e);
         $private_exp = $this->_math_obj->int2bin($d);
@@ -303,6 +309,16 @@ class Crypt_RSA_KeyPair extends Crypt_RSA_ErrorHandler
             $this->pushError($obj->getLastError());
             return false;
         }
+        if ($this->_math_obj->cmpAbs($p, $q) != 0) {
+            // keep $p and $q in private key for fast private key operations
+            $obj->setCrtParams(
+                $this->_math_obj->int2bin($p),
+                $this->_math_obj->int2bin($q),
+                $this->_math_obj->int2bin($dp),
+                $this->_math_obj->int2bin($dq),
+                $this->_math_obj->int2bin($qinv)
+            );
+        }
         $this->_private_key = &$obj;
 
         return true; // key pair successfully generated
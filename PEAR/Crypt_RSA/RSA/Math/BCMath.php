@@ -242,6 +242,31 @@ class Crypt_RSA_Math_BCMath
         return $result;
     }
 
+    /**
+     * Calculates pow($num, $d) (mod $p * $q) by Chinese remainder theorem,
+     * where $dp = $d (mod $p - 1), $dq = $d (mod $q - 1)
+     * and $qinv * $q = 1 (mod $p)
+     *
+     * @param string $num
+     * @param string $p
+     * @param string $q
+     * @param string $dp
+     * @param string $dq
+     * @param string $qinv
+     * @return string
+     * @access public
+     */
+    function powmodCrt($num, $p, $q, $dp, $dq, $qinv)
+    {
+        $m2 = $this->powmod($num, $dq, $q);
+        $h = bcmod(bcmul(bcsub($this->powmod($num, $dp, $p), $m2), $qinv), $p);
+        if (bccomp($h, '0') < 0) {
+            // bcmod() returns negative remainder for negative dividend
+            $h = bcadd($h, $p);
+        }
+        return bcadd($m2, bcmul($h, $q));
+    }
+
     /**
      * Calculates $num1 * $num2
      *
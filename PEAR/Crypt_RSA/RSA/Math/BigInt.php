@@ -122,6 +122,32 @@ class Crypt_RSA_Math_BigInt
         return bi_powmod($num, $pow, $mod);
     }
 
+    /**
+     * Calculates pow($num, $d) (mod $p * $q) by Chinese remainder theorem,
+     * where $dp = $d (mod $p - 1), $dq = $d (mod $q - 1)
+     * and $qinv * $q = 1 (mod $p)
+     *
+     * @param big_int resource $num
+     * @param big_int resource $p
+     * @param big_int resource $q
+     * @param big_int resource $dp
+     * @param big_int resource $dq
+     * @param big_int resource $qinv
+     * @return big_int resource
+     * @access public
+     */
+    function powmodCrt($num, $p, $q, $dp, $dq, $qinv)
+    {
+        if (function_exists('bi_powmod_crt')) {
+            return bi_powmod_crt($num, $p, $q, $dp, $dq, $qinv);
+        }
+
+        // there is no bi_powmod_crt() function in older versions of big_int extension
+        $m2 = bi_powmod($num, $dq, $q);
+        $h = bi_mulmod(bi_submod(bi_powmod($num, $dp, $p), $m2, $p), $qinv, $p);
+        return bi_add($m2, bi_mul($h, $q));
+    }
+
     /**
      * Calculates $num1 * $num2
      *
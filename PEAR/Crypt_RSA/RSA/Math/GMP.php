@@ -129,6 +129,27 @@ class Crypt_RSA_Math_GMP
         return gmp_powm($num, $pow, $mod);
     }
 
+    /**
+     * Calculates pow($num, $d) (mod $p * $q) by Chinese remainder theorem,
+     * where $dp = $d (mod $p - 1), $dq = $d (mod $q - 1)
+     * and $qinv * $q = 1 (mod $p)
+     *
+     * @param gmp resource $num
+     * @param gmp resource $p
+     * @param gmp resource $q
+     * @param gmp resource $dp
+     * @param gmp resource $dq
+     * @param gmp resource $qinv
+     * @return gmp resource
+     * @access public
+     */
+    function powmodCrt($num, $p, $q, $dp, $dq, $qinv)
+    {
+        $m2 = gmp_powm($num, $dq, $q);
+        $h = gmp_mod(gmp_mul(gmp_sub(gmp_powm($num, $dp, $p), $m2), $qinv), $p);
+        return gmp_add($m2, gmp_mul($h, $q));
+    }
+
     /**
      * Calculates $num1 * $num2
      *
@@ -127,6 +127,17 @@ if ($text != $text1) {
     $errors[] = "error in encrypting/decrypting functions";
 }
 
+// private key without CRT parameters must give the same result
+$private_key = $key_pair->getPrivateKey();
+if (is_null($private_key->getCrtParams())) {
+    $errors[] = "missing CRT parameters in private key from Crypt_RSA_KeyPair::generate()";
+}
+$private_key1 = new Crypt_RSA_Key($private_key->getModulus(), $private_key->getExponent(), 'private', MATH_LIBRARY, 'check_error');
+$text1 = $rsa_obj->decrypt($enc_text, $private_key1);
+if ($text != $text1) {
+    $errors[] = "error in decrypting function with private key without CRT parameters";
+}
+
 // check signing/sign validating
 $params = array(
     'public_key' => $key_pair->getPublicKey(),
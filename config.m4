@@ -11,6 +11,11 @@ if test "$PHP_BIG_INT" != "no"; then
         libbig_int/src/number_theory.c \
         libbig_int/src/service_funcs.c \
         libbig_int/src/str_funcs.c \
+        libbig_int/src/montgomery.c \
+        libbig_int/src/reciprocal.c \
+        libbig_int/src/barrett.c \
+        libbig_int/src/fixed_base.c \
+        libbig_int/src/special_mod.c \
         libbig_int/src/low_level_funcs/add.c \
         libbig_int/src/low_level_funcs/and.c \
         libbig_int/src/low_level_funcs/andnot.c \
@@ -20,7 +25,25 @@ if test "$PHP_BIG_INT" != "no"; then
         libbig_int/src/low_level_funcs/or.c \
         libbig_int/src/low_level_funcs/sqr.c \
         libbig_int/src/low_level_funcs/sub.c \
-        libbig_int/src/low_level_funcs/xor.c,
+        libbig_int/src/low_level_funcs/xor.c \
+        libbig_int/src/low_level_funcs/mul_karatsuba.c \
+        libbig_int/src/low_level_funcs/fast_mul.c \
+        libbig_int/src/low_level_funcs/toom_cook.c \
+        libbig_int/src/low_level_funcs/ntt.c \
+        libbig_int/src/low_level_funcs/fast_sqr.c \
+        libbig_int/src/low_level_funcs/cpu_features.c \
+        libbig_int/src/low_level_funcs/x86_64_adx.c \
+        libbig_int/src/low_level_funcs/x86_64_ifma.c \
+        libbig_int/src/low_level_funcs/mont_mul.c \
+        libbig_int/src/low_level_funcs/pow_window.c \
+        libbig_int/src/low_level_funcs/mont_mul_ct.c \
+        libbig_int/src/low_level_funcs/div_bz.c \
+        libbig_int/src/low_level_funcs/fast_div.c \
+        libbig_int/src/low_level_funcs/div_newton.c \
+        libbig_int/src/low_level_funcs/barrett_reduce.c \
+        libbig_int/src/low_level_funcs/divexact.c \
+        libbig_int/src/low_level_funcs/gcd.c \
+        libbig_int/src/low_level_funcs/special_reduce.c,
         $ext_shared, , -I@ext_srcdir@/libbig_int/include)
     PHP_ADD_BUILD_DIR($ext_builddir/libbig_int/src)
     PHP_ADD_BUILD_DIR($ext_builddir/libbig_int/src/low_level_funcs)
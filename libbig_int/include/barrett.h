@@ -0,0 +1,62 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Barrett reduction functions include:
+        1) functions, listed below
+
+    Barrett context keeps modulus [m] with length k digits and
+    precomputed value
+        mu = floor(B^(2k) / m),
+    where B = 2^BIG_INT_WORD_BITS_CNT. Then reduction of numbers,
+    shorter than 2k digits, needs two multiplications instead of
+    division. Unlike Montgomery multiplication (see montgomery.h),
+    modulus can be even and numbers are kept in the ordinary form.
+*/
+#ifndef BIG_INT_BARRETT_H
+#define BIG_INT_BARRETT_H
+
+#include "big_int.h"
+
+typedef struct {
+    big_int *modulus; /* absolute value of modulus */
+    big_int *mu; /* floor(B^(2k) / modulus) */
+} big_int_barrett;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BIG_INT_API big_int_barrett * big_int_barrett_create(const big_int *modulus);
+
+BIG_INT_API void big_int_barrett_destroy(big_int_barrett *ctx);
+
+BIG_INT_API int big_int_barrett_reduce(const big_int_barrett *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_barrett_mul(const big_int_barrett *ctx, const big_int *a, const big_int *b,
+    big_int *answer);
+
+BIG_INT_API int big_int_barrett_sqr(const big_int_barrett *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_barrett_pow(const big_int_barrett *ctx, const big_int *a, const big_int *b,
+    big_int *answer);
+
+BIG_INT_API int big_int_barrett_multi_pow(const big_int_barrett *ctx, const big_int **a,
+    const big_int **b, size_t n, big_int *answer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
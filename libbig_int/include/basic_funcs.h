@@ -45,6 +45,14 @@ BIG_INT_API int big_int_inc(const big_int *a, big_int *answer);
 
 BIG_INT_API int big_int_dec(const big_int *a, big_int *answer);
 
+BIG_INT_API int big_int_add_word(const big_int *a, big_int_word b, big_int *answer);
+
+BIG_INT_API int big_int_mul_word(const big_int *a, big_int_word b, big_int *answer);
+
+BIG_INT_API int big_int_divrem_word(const big_int *a, big_int_word b, big_int *q, big_int_word *r);
+
+BIG_INT_API int big_int_mod_word(const big_int *a, big_int_word b, big_int_word *r);
+
 BIG_INT_API int big_int_sqr(const big_int *a, big_int *answer);
 
 BIG_INT_API int big_int_mul(const big_int *a, const big_int *b, big_int *answer);
@@ -61,6 +69,12 @@ BIG_INT_API int big_int_muladd(const big_int *a, const big_int *b, const big_int
 
 BIG_INT_API int big_int_div_extended(const big_int *a, const big_int *b, big_int *q, big_int *r);
 
+BIG_INT_API int big_int_divexact(const big_int *a, const big_int *b, big_int *answer);
+
+BIG_INT_API int big_int_divisible_p(const big_int *a, const big_int *b, int *is_divisible);
+
+BIG_INT_API void big_int_divisible_2exp(const big_int *a, size_t n_bits, int *is_divisible);
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,9 +42,11 @@
 
 /*
     BIG_INT_DIGIT_SIZE could be defined in preprocessor definitions
-    to 32, 16 or 8 bits.
+    to 64, 32, 16 or 8 bits.
     The default value for 32-bit processors is 32 bit (if not defined
     during compilation)
+    64-bit digits are available only for GCC-compatible compilers
+    on 64-bit processors, which support [unsigned __int128] type.
 */
 #if !defined(BIG_INT_DIGIT_SIZE)
 #define BIG_INT_DIGIT_SIZE 32
@@ -72,6 +74,8 @@ typedef unsigned __int32 big_int_dword;
 #elif (BIG_INT_DIGIT_SIZE == 8)
 typedef unsigned __int8 big_int_word;
 typedef unsigned __int16 big_int_dword;
+#elif (BIG_INT_DIGIT_SIZE == 64)
+#error wrong BIG_INT_DIGIT_SIZE. MSVC compilers have no 128-bit integers. Expected 8, 16 or 32
 #else
 #error wrong BIG_INT_DIGIT_SIZE. Expected 8, 16 or 32
 #endif /* end of if (BIG_INT_DIGIT_SIZE == 32) */
@@ -87,7 +91,13 @@ typedef unsigned __int16 big_int_dword;
 #include <stdint.h>
 #endif
 
-#if (BIG_INT_DIGIT_SIZE == 32)
+#if (BIG_INT_DIGIT_SIZE == 64)
+#if !defined(__SIZEOF_INT128__)
+#error wrong BIG_INT_DIGIT_SIZE. The compiler has no [unsigned __int128] type. Expected 8, 16 or 32
+#endif
+typedef uint64_t big_int_word;
+__extension__ typedef unsigned __int128 big_int_dword;
+#elif (BIG_INT_DIGIT_SIZE == 32)
 typedef uint32_t big_int_word;
 typedef uint64_t big_int_dword;
 #elif (BIG_INT_DIGIT_SIZE == 16)
@@ -97,7 +107,7 @@ typedef uint32_t big_int_dword;
 typedef uint8_t big_int_word;
 typedef uint16_t big_int_dword;
 #else
-#error wrong BIG_INT_DIGIT_SIZE. Expected 8, 16 or 32
+#error wrong BIG_INT_DIGIT_SIZE. Expected 8, 16, 32 or 64
 #endif /* end of BIG_INT_DIGIT_SIZE */
 #endif /* end of if defined(_MSC_VER) */
 
@@ -27,6 +27,11 @@
 #include "basic_funcs.h"
 #include "number_theory.h"
 #include "modular_arithmetic.h"
+#include "montgomery.h"
+#include "barrett.h"
+#include "fixed_base.h"
+#include "special_mod.h"
+#include "reciprocal.h"
 #include "bitset_funcs.h"
 
 #endif
@@ -0,0 +1,27 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Tuned thresholds for choosing algorithms in low-level functions.
+
+    This file is generated by tune program (see projects/tune).
+    Run it on target machine and replace this file by its output
+    to adjust thresholds to the processor.
+    Macros, which are not defined here, get default values
+    in low_level_funcs.h.
+*/
+#ifndef BIG_INT_TUNING_H
+#define BIG_INT_TUNING_H
+
+#endif
@@ -0,0 +1,62 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Fixed-base exponentiation functions include:
+        1) functions, listed below
+
+    Fixed-base context keeps powers of base [g] by odd modulus [n],
+    precomputed by Lim-Lee comb method. Exponent [e] with up to
+    teeth * spacing bits is considered as matrix with [teeth] rows
+    and [spacing] columns, where row [k] consists of bits
+        e[k * spacing] .. e[(k + 1) * spacing - 1].
+    Comb table keeps products
+        table[j] = prod(pow(g, pow(2, k * spacing))) (mod n)
+    over all bits [k] of [j] for every 0 <= j < pow(2, teeth). Then
+    pow(g, e) needs only [spacing] squarings and up to [spacing]
+    multiplications, i.e. about length(e) * 2 / teeth modular
+    multiplications instead of length(e) squarings for sliding window.
+    Table is built once and can be used for any number of exponents.
+*/
+#ifndef BIG_INT_FIXED_BASE_H
+#define BIG_INT_FIXED_BASE_H
+
+#include "big_int.h"
+#include "montgomery.h"
+
+typedef struct {
+    big_int_mont *mont; /* Montgomery context for modulus */
+    big_int *base; /* base, reduced by modulus */
+    big_int_word *table; /* comb table in Montgomery form */
+    size_t teeth; /* number of rows of exponent */
+    size_t spacing; /* number of columns of exponent */
+} big_int_fixed_base;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BIG_INT_API big_int_fixed_base * big_int_fixed_base_create(const big_int *base,
+    const big_int *modulus, size_t exp_bits);
+
+BIG_INT_API void big_int_fixed_base_destroy(big_int_fixed_base *ctx);
+
+BIG_INT_API int big_int_fixed_base_pow(const big_int_fixed_base *ctx, const big_int *b,
+    big_int *answer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,11 +20,293 @@
 #define LOW_LEVEL_FUNCS_H
 
 #include "big_int.h"
+#include "big_int_tuning.h"
+
+/*
+    Thresholds (in digits) for choosing multiplication algorithm
+    in low_level_fast_mul(). Values, tuned for the processor by
+    tune program, are taken from big_int_tuning.h.
+
+    BIG_INT_KARATSUBA_MUL_THRESHOLD could be defined in preprocessor
+    definitions. Numbers with length of shorter operand less than
+    this threshold are multiplied by schoolbook low_level_mul().
+*/
+#if !defined(BIG_INT_KARATSUBA_MUL_THRESHOLD)
+#define BIG_INT_KARATSUBA_MUL_THRESHOLD 32
+#endif
+
+#if (BIG_INT_KARATSUBA_MUL_THRESHOLD < 4)
+#error wrong BIG_INT_KARATSUBA_MUL_THRESHOLD. Expected value not less than 4
+#endif
+
+/*
+    BIG_INT_TOOM3_MUL_THRESHOLD and BIG_INT_TOOM4_MUL_THRESHOLD
+    could be defined in preprocessor definitions. Numbers with length
+    of shorter operand not less than these thresholds are multiplied
+    by Toom-Cook 3-way and 4-way algorithms respectively.
+*/
+#if !defined(BIG_INT_TOOM3_MUL_THRESHOLD)
+#define BIG_INT_TOOM3_MUL_THRESHOLD 128
+#endif
+
+#if (BIG_INT_TOOM3_MUL_THRESHOLD < BIG_INT_KARATSUBA_MUL_THRESHOLD)
+#error wrong BIG_INT_TOOM3_MUL_THRESHOLD. Expected value not less than BIG_INT_KARATSUBA_MUL_THRESHOLD
+#endif
+
+#if !defined(BIG_INT_TOOM4_MUL_THRESHOLD)
+#define BIG_INT_TOOM4_MUL_THRESHOLD 384
+#endif
+
+#if (BIG_INT_TOOM4_MUL_THRESHOLD < BIG_INT_TOOM3_MUL_THRESHOLD)
+#error wrong BIG_INT_TOOM4_MUL_THRESHOLD. Expected value not less than BIG_INT_TOOM3_MUL_THRESHOLD
+#endif
+
+/*
+    BIG_INT_NTT_MUL_THRESHOLD could be defined in preprocessor definitions.
+    Numbers with length of shorter operand not less than this threshold
+    are multiplied by number-theoretic transform.
+
+    low_level_mul_ntt() cuts numbers into 32-bit chunks, so its cost
+    depends on length in bits, not in digits. Toom-Cook algorithms
+    with 64-bit digits are much faster per bit than with 32-bit ones,
+    so NTT wins only from about 3.5M bits (57344 digits) instead of
+    32K bits (1024 digits).
+*/
+#if !defined(BIG_INT_NTT_MUL_THRESHOLD)
+#if (BIG_INT_DIGIT_SIZE == 64)
+#define BIG_INT_NTT_MUL_THRESHOLD 57344
+#else
+#define BIG_INT_NTT_MUL_THRESHOLD 1024
+#endif
+#endif
+
+#if (BIG_INT_NTT_MUL_THRESHOLD < BIG_INT_TOOM4_MUL_THRESHOLD)
+#error wrong BIG_INT_NTT_MUL_THRESHOLD. Expected value not less than BIG_INT_TOOM4_MUL_THRESHOLD
+#endif
+
+/*
+    Thresholds for squaring algorithms in low_level_fast_sqr().
+    They could be defined in preprocessor definitions and have
+    the same meaning as thresholds for multiplication.
+*/
+#if !defined(BIG_INT_KARATSUBA_SQR_THRESHOLD)
+#define BIG_INT_KARATSUBA_SQR_THRESHOLD 96
+#endif
+
+#if (BIG_INT_KARATSUBA_SQR_THRESHOLD < 4)
+#error wrong BIG_INT_KARATSUBA_SQR_THRESHOLD. Expected value not less than 4
+#endif
+
+#if !defined(BIG_INT_TOOM3_SQR_THRESHOLD)
+#define BIG_INT_TOOM3_SQR_THRESHOLD 256
+#endif
+
+#if (BIG_INT_TOOM3_SQR_THRESHOLD < BIG_INT_KARATSUBA_SQR_THRESHOLD)
+#error wrong BIG_INT_TOOM3_SQR_THRESHOLD. Expected value not less than BIG_INT_KARATSUBA_SQR_THRESHOLD
+#endif
+
+#if !defined(BIG_INT_TOOM4_SQR_THRESHOLD)
+#define BIG_INT_TOOM4_SQR_THRESHOLD 512
+#endif
+
+#if (BIG_INT_TOOM4_SQR_THRESHOLD < BIG_INT_TOOM3_SQR_THRESHOLD)
+#error wrong BIG_INT_TOOM4_SQR_THRESHOLD. Expected value not less than BIG_INT_TOOM3_SQR_THRESHOLD
+#endif
+
+#if !defined(BIG_INT_NTT_SQR_THRESHOLD)
+#if (BIG_INT_DIGIT_SIZE == 64)
+#define BIG_INT_NTT_SQR_THRESHOLD 57344
+#else
+#define BIG_INT_NTT_SQR_THRESHOLD 1024
+#endif
+#endif
+
+/* NTT is checked first, so Toom-4 squaring is never used without a gap */
+#if (BIG_INT_NTT_SQR_THRESHOLD <= BIG_INT_TOOM4_SQR_THRESHOLD)
+#error wrong BIG_INT_NTT_SQR_THRESHOLD. Expected value greater than BIG_INT_TOOM4_SQR_THRESHOLD
+#endif
+
+/*
+    BIG_INT_BZ_DIV_THRESHOLD could be defined in preprocessor definitions.
+    low_level_fast_div() uses Burnikel-Ziegler recursive division,
+    if lengths of divisor and quotient are not less than this threshold.
+    Shorter numbers are divided by schoolbook low_level_div().
+*/
+#if !defined(BIG_INT_BZ_DIV_THRESHOLD)
+#define BIG_INT_BZ_DIV_THRESHOLD 64
+#endif
+
+#if (BIG_INT_BZ_DIV_THRESHOLD < 2)
+#error wrong BIG_INT_BZ_DIV_THRESHOLD. Expected value not less than 2
+#endif
+
+/*
+    BIG_INT_NEWTON_DIV_THRESHOLD could be defined in preprocessor definitions.
+    low_level_fast_div() divides by reciprocal of divisor, calculated by
+    Newton's iteration, if lengths of divisor and quotient are not less
+    than this threshold.
+*/
+#if !defined(BIG_INT_NEWTON_DIV_THRESHOLD)
+#define BIG_INT_NEWTON_DIV_THRESHOLD 65536
+#endif
+
+#if (BIG_INT_NEWTON_DIV_THRESHOLD < BIG_INT_BZ_DIV_THRESHOLD)
+#error wrong BIG_INT_NEWTON_DIV_THRESHOLD. Expected value not less than BIG_INT_BZ_DIV_THRESHOLD
+#endif
+
+/*
+    BIG_INT_DIVEXACT_THRESHOLD could be defined in preprocessor definitions.
+    low_level_divexact() multiplies by 2-adic inverse of divisor, calculated
+    by Newton's iteration, if lengths of divisor and quotient are not less
+    than this threshold. Shorter numbers are divided by Hensel's schoolbook
+    algorithm.
+*/
+#if !defined(BIG_INT_DIVEXACT_THRESHOLD)
+#define BIG_INT_DIVEXACT_THRESHOLD 128
+#endif
+
+#if (BIG_INT_DIVEXACT_THRESHOLD < 2)
+#error wrong BIG_INT_DIVEXACT_THRESHOLD. Expected value not less than 2
+#endif
+
+/*
+    BIG_INT_HGCD_THRESHOLD and BIG_INT_GCD_HGCD_THRESHOLD could be defined
+    in preprocessor definitions. big_int_gcd_extended() reduces numbers
+    by recursive half-GCD algorithm, if they are not shorter than
+    BIG_INT_GCD_HGCD_THRESHOLD digits. Shorter numbers are reduced by
+    Lehmer's algorithm. Half-GCD algorithm splits numbers recursively
+    while they are not shorter than BIG_INT_HGCD_THRESHOLD digits.
+*/
+#if !defined(BIG_INT_HGCD_THRESHOLD)
+#define BIG_INT_HGCD_THRESHOLD 192
+#endif
+
+#if (BIG_INT_HGCD_THRESHOLD < 2)
+#error wrong BIG_INT_HGCD_THRESHOLD. Expected value not less than 2
+#endif
+
+#if !defined(BIG_INT_GCD_HGCD_THRESHOLD)
+#define BIG_INT_GCD_HGCD_THRESHOLD 2048
+#endif
+
+#if (BIG_INT_GCD_HGCD_THRESHOLD < BIG_INT_HGCD_THRESHOLD)
+#error wrong BIG_INT_GCD_HGCD_THRESHOLD. Expected value not less than BIG_INT_HGCD_THRESHOLD
+#endif
+
+/*
+    BIG_INT_COMB_MAX_TEETH could be defined in preprocessor definitions.
+    It limits number of teeth of comb, which is built by
+    big_int_fixed_base_create(). Comb table has pow(2, teeth) numbers
+    with length(modulus) digits. Every additional tooth doubles the table,
+    but reduces time of big_int_fixed_base_pow().
+*/
+#if !defined(BIG_INT_COMB_MAX_TEETH)
+#define BIG_INT_COMB_MAX_TEETH 8
+#endif
+
+#if (BIG_INT_COMB_MAX_TEETH < 1 || BIG_INT_COMB_MAX_TEETH > 16)
+#error wrong BIG_INT_COMB_MAX_TEETH. Expected value in range [1 .. 16]
+#endif
+
+/*
+    BIG_INT_SPECIAL_POW_THRESHOLD could be defined in preprocessor definitions.
+    big_int_powmod() uses special-form context (see special_mod.h) instead of
+    Montgomery multiplication for moduli 2^k - c with length not less than
+    BIG_INT_SPECIAL_POW_THRESHOLD digits. Shorter moduli are faster
+    with Montgomery reduction, which has no foldings and carry propagation.
+*/
+#if !defined(BIG_INT_SPECIAL_POW_THRESHOLD)
+#define BIG_INT_SPECIAL_POW_THRESHOLD 9
+#endif
+
+#if (BIG_INT_SPECIAL_POW_THRESHOLD < 1)
+#error wrong BIG_INT_SPECIAL_POW_THRESHOLD. Expected value not less than 1
+#endif
+
+/*
+    BIG_INT_TUNE is defined, when the library is built for tune program
+    (see projects/tune). Then thresholds of recursive algorithms, which
+    cannot be compared by calling them directly, are variables
+    defined in tune program. NTT thresholds are variables too, so
+    sub-products of Toom-Cook algorithms are not made by NTT, while
+    Toom-4 is compared with NTT.
+*/
+#if defined(BIG_INT_TUNE)
+extern size_t low_level_tune_bz_div_threshold;
+extern size_t low_level_tune_newton_div_threshold;
+extern size_t low_level_tune_ntt_mul_threshold;
+extern size_t low_level_tune_ntt_sqr_threshold;
+#undef BIG_INT_NTT_MUL_THRESHOLD
+#define BIG_INT_NTT_MUL_THRESHOLD low_level_tune_ntt_mul_threshold
+#undef BIG_INT_NTT_SQR_THRESHOLD
+#define BIG_INT_NTT_SQR_THRESHOLD low_level_tune_ntt_sqr_threshold
+#undef BIG_INT_BZ_DIV_THRESHOLD
+#define BIG_INT_BZ_DIV_THRESHOLD low_level_tune_bz_div_threshold
+#undef BIG_INT_NEWTON_DIV_THRESHOLD
+#define BIG_INT_NEWTON_DIV_THRESHOLD low_level_tune_newton_div_threshold
+#endif
+
+/*
+    maximum length (in digits) of product, which can be calculated
+    by low_level_mul_ntt(). Longer products are splitted by Toom-Cook
+    algorithms into shorter ones.
+*/
+#define BIG_INT_NTT_MAX_LEN ((((size_t) 1 << 24) - 2) * 32 / BIG_INT_WORD_BITS_CNT)
+
+/*
+    BIG_INT_X86_64_ASM is defined for 64-bit digits, compiled by
+    GCC-compatible compilers for x86-64 processors. Then low-level
+    functions call hand-optimized assembler kernels, if the processor
+    supports instructions used by them (see low_level_cpu_features).
+    Define BIG_INT_NO_ASM in preprocessor definitions to build
+    portable C code only.
+*/
+#if (BIG_INT_DIGIT_SIZE == 64) && defined(__GNUC__) && defined(__x86_64__) && !defined(BIG_INT_NO_ASM)
+#define BIG_INT_X86_64_ASM
+#endif
+
+/*
+    BIG_INT_X86_64_IFMA is defined, when the compiler supports AVX-512 IFMA
+    intrinsics. Then low_level_fast_mul() and low_level_fast_sqr() use
+    52-bit radix kernels for numbers with lengths from
+    BIG_INT_IFMA_MIN_LEN to BIG_INT_IFMA_MAX_LEN digits (1024 - 8192 bits
+    by default), if the processor supports AVX-512 IFMA.
+*/
+#if defined(BIG_INT_X86_64_ASM) && (defined(__clang__) || (__GNUC__ >= 6))
+#define BIG_INT_X86_64_IFMA
+#endif
+
+#if !defined(BIG_INT_IFMA_MIN_LEN)
+#define BIG_INT_IFMA_MIN_LEN 16
+#endif
+
+#if !defined(BIG_INT_IFMA_MAX_LEN)
+#define BIG_INT_IFMA_MAX_LEN 128
+#endif
+
+#if (BIG_INT_IFMA_MIN_LEN < 1) || (BIG_INT_IFMA_MAX_LEN < BIG_INT_IFMA_MIN_LEN) || (BIG_INT_IFMA_MAX_LEN > 512)
+#error wrong BIG_INT_IFMA_MIN_LEN or BIG_INT_IFMA_MAX_LEN. Expected 0 < BIG_INT_IFMA_MIN_LEN <= BIG_INT_IFMA_MAX_LEN <= 512
+#endif
+
+/*
+    flags of low_level_cpu_features
+*/
+#define LOW_LEVEL_CPU_ADX 1 /* BMI2 (MULX) and ADX (ADCX, ADOX) instructions */
+#define LOW_LEVEL_CPU_IFMA 2 /* AVX-512F and AVX-512 IFMA instructions, enabled by OS */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+    Features of the processor, which are used by low-level functions.
+    It is set at library load and could be cleared by application
+    to force portable C code. It must not be changed, while
+    other threads call low-level functions, because lengths of
+    temporary buffers depend on it.
+*/
+extern int low_level_cpu_features;
+
 void low_level_add(big_int_word *a, big_int_word *a_end,
                    const big_int_word *b, const big_int_word *b_end,
                    big_int_word *c);
@@ -37,10 +319,211 @@ void low_level_mul(const big_int_word *a, const big_int_word *a_end,
                    const big_int_word *b, const big_int_word *b_end,
                    big_int_word *c);
 
+big_int_word low_level_addmul_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c);
+
+big_int_word low_level_submul_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c);
+
+big_int_word low_level_mul_1(const big_int_word *a, const big_int_word *a_end,
+                             big_int_word b, big_int_word *c);
+
+void low_level_mul_low(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c, size_t c_len, big_int_word *tmp);
+
+size_t low_level_mul_low_tmp_len(size_t a_len, size_t b_len, size_t c_len);
+
+big_int_word low_level_addto(big_int_word *a, big_int_word *a_end,
+                             const big_int_word *b, const big_int_word *b_end);
+
+big_int_word low_level_subfrom(big_int_word *a, big_int_word *a_end,
+                               const big_int_word *b, const big_int_word *b_end);
+
+void low_level_mul_karatsuba(const big_int_word *a, const big_int_word *a_end,
+                             const big_int_word *b, const big_int_word *b_end,
+                             big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mul_karatsuba_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_mul_toom3(const big_int_word *a, const big_int_word *a_end,
+                         const big_int_word *b, const big_int_word *b_end,
+                         big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mul_toom3_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_mul_toom4(const big_int_word *a, const big_int_word *a_end,
+                         const big_int_word *b, const big_int_word *b_end,
+                         big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mul_toom4_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_mul_ntt(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mul_ntt_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_sqr_karatsuba(const big_int_word *a, const big_int_word *a_end,
+                             big_int_word *c, big_int_word *tmp);
+
+size_t low_level_sqr_karatsuba_tmp_len(size_t a_len);
+
+void low_level_sqr_toom3(const big_int_word *a, const big_int_word *a_end,
+                         big_int_word *c, big_int_word *tmp);
+
+size_t low_level_sqr_toom3_tmp_len(size_t a_len);
+
+void low_level_sqr_toom4(const big_int_word *a, const big_int_word *a_end,
+                         big_int_word *c, big_int_word *tmp);
+
+size_t low_level_sqr_toom4_tmp_len(size_t a_len);
+
+void low_level_sqr_ntt(const big_int_word *a, const big_int_word *a_end,
+                       big_int_word *c, big_int_word *tmp);
+
+size_t low_level_sqr_ntt_tmp_len(size_t a_len);
+
+void low_level_fast_sqr(const big_int_word *a, const big_int_word *a_end,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_fast_sqr_tmp_len(size_t a_len);
+
+void low_level_fast_mul(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_fast_mul_tmp_len(size_t a_len, size_t b_len);
+
+size_t low_level_pow_window_bits(size_t n_bits);
+
+big_int_word low_level_pow_window(const big_int_word *b, size_t n_bits,
+                                  size_t window_bits, size_t *window_len);
+
+big_int_word low_level_mont_inverse(big_int_word n0);
+
+void low_level_mont_redc(big_int_word *t, const big_int_word *n, size_t n_len,
+                         big_int_word n0_inv, big_int_word *c);
+
+void low_level_mont_mul(const big_int_word *a, const big_int_word *b,
+                        const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                        big_int_word *c, big_int_word *tmp);
+
+void low_level_mont_sqr(const big_int_word *a,
+                        const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mont_mul_tmp_len(size_t n_len);
+
+void low_level_mont_mul_ct(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                           big_int_word *c, big_int_word *tmp);
+
+void low_level_addmod_ct(const big_int_word *a, const big_int_word *b,
+                         const big_int_word *n, size_t n_len,
+                         big_int_word *c, big_int_word *tmp);
+
+void low_level_submod_ct(const big_int_word *a, const big_int_word *b,
+                         const big_int_word *n, size_t n_len,
+                         big_int_word *c, big_int_word *tmp);
+
+void low_level_select_ct(const big_int_word *table, size_t cnt, size_t len,
+                         big_int_word idx, big_int_word *c);
+
+void low_level_mont_pow_ct(const big_int_word *a, const big_int_word *b, size_t b_len,
+                           const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                           const big_int_word *one, size_t window_bits,
+                           big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mont_pow_ct_tmp_len(size_t n_len, size_t window_bits);
+
+void low_level_barrett_reduce(const big_int_word *x, const big_int_word *m, size_t m_len,
+                              const big_int_word *mu, size_t mu_len,
+                              big_int_word *r, big_int_word *tmp);
+
+size_t low_level_barrett_reduce_tmp_len(size_t m_len, size_t mu_len);
+
+void low_level_barrett_mul(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *m, size_t m_len,
+                           const big_int_word *mu, size_t mu_len,
+                           big_int_word *c, big_int_word *tmp);
+
+size_t low_level_barrett_mul_tmp_len(size_t m_len, size_t mu_len);
+
+void low_level_special_reduce(const big_int_word *x, size_t x_len,
+                              const big_int_word *m, size_t m_len, size_t k,
+                              const big_int_word *c_plus, const big_int_word *c_minus,
+                              size_t c_len, big_int_word *r, big_int_word *tmp);
+
+size_t low_level_special_reduce_tmp_len(size_t x_len, size_t m_len, size_t c_len);
+
+void low_level_special_mul(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *m, size_t m_len, size_t k,
+                           const big_int_word *c_plus, const big_int_word *c_minus,
+                           size_t c_len, big_int_word *c, big_int_word *tmp);
+
+size_t low_level_special_mul_tmp_len(size_t m_len, size_t c_len);
+
 void low_level_div(big_int_word *a, big_int_word *a_end,
                    const big_int_word *b, const big_int_word *b_end,
                    big_int_word *c, big_int_word *c_end);
 
+big_int_word low_level_div_inverse(const big_int_word *b, const big_int_word *b_end);
+
+big_int_word low_level_divrem_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c);
+
+big_int_word low_level_divrem_1_preinv(const big_int_word *a, const big_int_word *a_end,
+                                       big_int_word d, size_t shift, big_int_word v,
+                                       big_int_word *c);
+
+void low_level_div_preinv(big_int_word *a, big_int_word *a_end,
+                          const big_int_word *b, const big_int_word *b_end,
+                          big_int_word v, big_int_word *c, big_int_word *c_end);
+
+void low_level_div_bz(big_int_word *a, big_int_word *a_end,
+                      const big_int_word *b, const big_int_word *b_end,
+                      big_int_word *c, big_int_word *c_end, big_int_word *tmp);
+
+size_t low_level_div_bz_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_recip(const big_int_word *b, const big_int_word *b_end,
+                     big_int_word *c, big_int_word *tmp);
+
+size_t low_level_recip_tmp_len(size_t b_len);
+
+void low_level_div_newton(big_int_word *a, big_int_word *a_end,
+                          const big_int_word *b, const big_int_word *b_end,
+                          const big_int_word *v, big_int_word *c, big_int_word *c_end,
+                          big_int_word *tmp);
+
+size_t low_level_div_newton_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_fast_div(big_int_word *a, big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *c_end, big_int_word *tmp);
+
+size_t low_level_fast_div_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_divexact(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_divexact_tmp_len(size_t a_len, size_t b_len);
+
+int low_level_divisible(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *tmp);
+
+size_t low_level_gcd_lehmer(const big_int_word *u, const big_int_word *v, size_t len,
+                            size_t max_steps, big_int_word *m);
+
+void low_level_gcd_matrix_mul(const big_int_word *m, size_t n_steps,
+                              big_int_word *u, big_int_word *v, size_t len,
+                              big_int_word *tmp);
+
+big_int_word low_level_gcd_1(big_int_word a, big_int_word b);
+
 int low_level_cmp(const big_int_word *a, const big_int_word *b, size_t len);
 
 void low_level_or(const big_int_word *a, const big_int_word *a_end,
@@ -61,6 +544,47 @@ void low_level_xor(const big_int_word *a, const big_int_word *a_end,
 
 void low_level_sqr(const big_int_word *a, const big_int_word *a_end, big_int_word *c);
 
+#if defined(BIG_INT_X86_64_ASM)
+void low_level_add_adx(big_int_word *a, big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c);
+
+void low_level_sub_adx(big_int_word *a, big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c);
+
+big_int_word low_level_addto_adx(big_int_word *a, big_int_word *a_end,
+                                 const big_int_word *b, const big_int_word *b_end);
+
+big_int_word low_level_subfrom_adx(big_int_word *a, big_int_word *a_end,
+                                   const big_int_word *b, const big_int_word *b_end);
+
+big_int_word low_level_mul_1_adx(const big_int_word *a, const big_int_word *a_end,
+                                 big_int_word b, big_int_word *c);
+
+big_int_word low_level_addmul_1_adx(const big_int_word *a, const big_int_word *a_end,
+                                    big_int_word b, big_int_word *c);
+
+void low_level_mul_adx(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c);
+
+void low_level_sqr_adx(const big_int_word *a, const big_int_word *a_end, big_int_word *c);
+#endif
+
+#if defined(BIG_INT_X86_64_IFMA)
+void low_level_mul_ifma(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_mul_ifma_tmp_len(size_t a_len, size_t b_len);
+
+void low_level_sqr_ifma(const big_int_word *a, const big_int_word *a_end,
+                        big_int_word *c, big_int_word *tmp);
+
+size_t low_level_sqr_ifma_tmp_len(size_t a_len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,14 +40,31 @@ BIG_INT_API int big_int_divmod(const big_int *a, const big_int *b,
 BIG_INT_API int big_int_powmod(const big_int *a, const big_int *b,
     const big_int *modulus, big_int *answer);
 
+BIG_INT_API int big_int_multi_powmod(const big_int **a, const big_int **b, size_t n,
+    const big_int *modulus, big_int *answer);
+
+BIG_INT_API int big_int_powmod2(const big_int *a1, const big_int *b1,
+    const big_int *a2, const big_int *b2, const big_int *modulus, big_int *answer);
+
+BIG_INT_API int big_int_powmod_crt(const big_int *c, const big_int *p, const big_int *q,
+    const big_int *dp, const big_int *dq, const big_int *qinv, big_int *answer);
+
+BIG_INT_API int big_int_powmod_ct(const big_int *a, const big_int *b,
+    const big_int *modulus, big_int *answer);
+
 BIG_INT_API int big_int_factmod(const big_int *a, const big_int *modulus, big_int *answer);
 
 BIG_INT_API int big_int_absmod(const big_int *a, const big_int *modulus, big_int *answer);
 
 BIG_INT_API int big_int_invmod(const big_int *a, const big_int *modulus, big_int *answer);
 
+BIG_INT_API int big_int_invmod_batch(const big_int **in, size_t n, const big_int *modulus,
+    big_int **out);
+
 BIG_INT_API int big_int_sqrmod(const big_int *a, const big_int *modulus, big_int *answer);
 
+BIG_INT_API int big_int_sqrtmod(const big_int *a, const big_int *p, big_int *answer);
+
 BIG_INT_API int big_int_cmpmod(const big_int *a, const big_int *b,
     const big_int *modulus, int *cmp_flag);
 
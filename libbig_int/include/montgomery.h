@@ -0,0 +1,67 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Montgomery multiplication functions include:
+        1) functions, listed below
+
+    Montgomery context keeps precomputed values for fast multiplication
+    by odd modulus [n] without divisions. Numbers, passed to
+    big_int_mont_mul() and big_int_mont_sqr(), must be in Montgomery form
+        a' = a * R (mod n),
+    where R = 2^(BIG_INT_WORD_BITS_CNT * length(n)).
+    Use big_int_mont_to() and big_int_mont_from() for conversion.
+*/
+#ifndef BIG_INT_MONTGOMERY_H
+#define BIG_INT_MONTGOMERY_H
+
+#include "big_int.h"
+
+typedef struct {
+    big_int *modulus; /* absolute value of modulus */
+    big_int *r2; /* R^2 (mod modulus) */
+    big_int_word n0_inv; /* -1 / modulus (mod 2^BIG_INT_WORD_BITS_CNT) */
+} big_int_mont;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BIG_INT_API big_int_mont * big_int_mont_create(const big_int *modulus);
+
+BIG_INT_API void big_int_mont_destroy(big_int_mont *ctx);
+
+BIG_INT_API int big_int_mont_to(const big_int_mont *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_mont_from(const big_int_mont *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_mont_mul(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer);
+
+BIG_INT_API int big_int_mont_sqr(const big_int_mont *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_mont_pow(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer);
+
+BIG_INT_API int big_int_mont_multi_pow(const big_int_mont *ctx, const big_int **a,
+    const big_int **b, size_t n, big_int *answer);
+
+BIG_INT_API int big_int_mont_pow_ct(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
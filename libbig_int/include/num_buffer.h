@@ -0,0 +1,33 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Private functions for exchange of numbers between big_int
+    and arrays of digits with fixed length. They are used by modular
+    contexts (Montgomery, Barrett and so on), which keep all numbers
+    in buffers with length(modulus) digits.
+    These functions are not part of the library API.
+*/
+#ifndef BIG_INT_NUM_BUFFER_H
+#define BIG_INT_NUM_BUFFER_H
+
+#include "big_int.h"
+
+void big_int_copy_to_buffer(const big_int *a, big_int_word *num, size_t len);
+
+int big_int_set_from_buffer(const big_int_word *num, size_t len, big_int *answer);
+
+int big_int_is_reduced(const big_int *a, const big_int *modulus);
+
+#endif
@@ -0,0 +1,68 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Reciprocal functions include:
+        1) functions, listed below
+
+    Reciprocal context keeps divisor, shifted so the highest bit of
+    its highest digit is set, and everything, which can be precomputed
+    for division by it:
+        - inverse of the highest digits of the shifted divisor,
+          used by the schoolbook division (Moller-Granlund 2-by-1
+          or 3-by-2 reciprocal), so the inner loop needs only
+          multiplications instead of hardware division
+        - for long divisors, the reciprocal
+              floor(B^(2n) / divisor),
+          where B = 2^BIG_INT_WORD_BITS_CNT and n = length(divisor).
+          It is calculated once by Newton's iteration, so repeated
+          division of long numbers needs only multiplications.
+    Create context once with big_int_recip_create(), then use
+    big_int_recip_div(), big_int_recip_mod(), big_int_recip_absmod()
+    or big_int_recip_div_extended() for every division by the same number.
+*/
+#ifndef BIG_INT_RECIPROCAL_H
+#define BIG_INT_RECIPROCAL_H
+
+#include "big_int.h"
+
+typedef struct {
+    big_int *divisor; /* divisor, shifted left by [shift] bits. Sign is kept */
+    big_int *recip; /* floor(B^(2n) / abs(divisor)) or NULL for short divisors */
+    big_int_word inv; /* low_level_div_inverse() of abs(divisor) */
+    size_t shift; /* number of bits, divisor is shifted by */
+} big_int_recip;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BIG_INT_API big_int_recip * big_int_recip_create(const big_int *divisor);
+
+BIG_INT_API void big_int_recip_destroy(big_int_recip *ctx);
+
+BIG_INT_API int big_int_recip_div_extended(const big_int_recip *ctx, const big_int *a,
+    big_int *q, big_int *r);
+
+BIG_INT_API int big_int_recip_div(const big_int_recip *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_recip_mod(const big_int_recip *ctx, const big_int *a, big_int *answer);
+
+BIG_INT_API int big_int_recip_absmod(const big_int_recip *ctx, const big_int *a, big_int *answer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/**
+    Special-form modulus functions include:
+        1) functions, listed below
+
+    Special-form context keeps modulus [m], which is close to
+    power of 2:
+        m = 2^k - c,
+    where c is much shorter than [m]. Examples are pseudo-Mersenne
+    numbers 2^255 - 19, 2^521 - 1 and Solinas numbers like
+    2^448 - 2^224 - 1 or 2^384 - 2^128 - 2^96 + 2^32 - 1.
+    Numbers 2^k + c with short [c] are accepted too.
+    Since 2^k = c (mod m), reduction folds higher bits of number
+    into lower bits with shifts and additions instead of division
+    (see low_level_special_reduce()). [c] is stored as c_plus - c_minus,
+    where c_plus and c_minus are either [c] and 0, or positive and
+    negative parts of non-adjacent form of [c], whichever has less
+    nonzero digits. Numbers are kept in the ordinary form, so
+    [m] can be even.
+*/
+#ifndef BIG_INT_SPECIAL_MOD_H
+#define BIG_INT_SPECIAL_MOD_H
+
+#include "big_int.h"
+
+typedef struct {
+    big_int *modulus; /* absolute value of modulus */
+    big_int_word *c_plus; /* [c_len] digits */
+    big_int_word *c_minus; /* [c_len] digits, modulus = 2^k - c_plus + c_minus */
+    size_t c_len;
+    size_t k;
+} big_int_special_mod;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BIG_INT_API big_int_special_mod * big_int_special_mod_create(const big_int *modulus);
+
+BIG_INT_API void big_int_special_mod_destroy(big_int_special_mod *ctx);
+
+BIG_INT_API int big_int_special_mod_reduce(const big_int_special_mod *ctx, const big_int *a,
+    big_int *answer);
+
+BIG_INT_API int big_int_special_mod_mul(const big_int_special_mod *ctx, const big_int *a,
+    const big_int *b, big_int *answer);
+
+BIG_INT_API int big_int_special_mod_sqr(const big_int_special_mod *ctx, const big_int *a,
+    big_int *answer);
+
+BIG_INT_API int big_int_special_mod_pow(const big_int_special_mod *ctx, const big_int *a,
+    const big_int *b, big_int *answer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
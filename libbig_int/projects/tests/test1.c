@@ -22,6 +22,11 @@
 #include "basic_funcs.h" /* string and service funcs is here */
 #include "bitset_funcs.h"
 #include "number_theory.h" /* modular arithmetic functions is here */
+#include "montgomery.h"
+#include "reciprocal.h"
+#include "barrett.h"
+#include "fixed_base.h"
+#include "special_mod.h"
 
 /***********************************************/
 
@@ -685,19 +690,32 @@ void test_number_theory(void)
             {"-123213123879350", "-3249283423126", "2"},
             {"12389123890", "-1523862238470", "12389123890"},
             {"-8193465725814765556554001028792218867", "5756130429098929077956071497934208671", "1"},
+            {"12610293462465114297395736600356510579718033241778140120868321809383131182008291469231878471438813288",
+             "-837519460947296713771118006779738091800520495046593670657335934071728002934663120286226552621435",
+             "12345678901234567890123"},
+            /* consecutive Fibonacci numbers */
+            {"222232244629420445529739893461909967206666939096499764990979600",
+             "137347080577163115432025771710279131845700275212767467264610201", "1"},
+            /* big quotient */
+            {"228879680008329476328364885785166024057560459654984455407208695075252042965238021912330611123721433910187469769193679377",
+             "-112359174146832493601299145563", "112359174146832493601299145563"},
+            {"0", "-77", "77"},
+            {"-5", "3", "1"},
+            {"-5", "-3", "1"},
         };
         int cmp_flag;
         big_int_str *str = NULL;
-        big_int *a = NULL, *b = NULL, *c = NULL, *x = NULL, *y = NULL;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *x = NULL, *y = NULL;
         size_t i;
 
         printf("test of big_int_gcd & big_int_gcd_extended...\n");
         a = big_int_create(1);
         b = big_int_create(1);
         c = big_int_create(1);
+        d = big_int_create(1);
         x = big_int_create(1);
         y = big_int_create(1);
-        if (a == NULL || b == NULL || c == NULL || x == NULL || y == NULL) {
+        if (a == NULL || b == NULL || c == NULL || d == NULL || x == NULL || y == NULL) {
             debug_print("error when creating numbers [a] or [b]\n");
         }
         str = big_int_str_create(1);
@@ -731,6 +749,21 @@ void test_number_theory(void)
                 debug_print("wrong result of big_int_gcd(%s, %s) = %s. Expected %s. (i = %u)\n",
                     test[i].n1, test[i].n2, str->str, test[i].gcd, i);
             }
+            /* check x * abs(a) + y * b = c for negative [a] and [b] */
+            if (big_int_gcd_extended(a, b, c, x, y)) {
+                debug_print("error in big_int_gcd_extended(%s, %s). (i = %u)\n",
+                    test[i].n1, test[i].n2, i);
+            }
+            if (big_int_abs(a, d) || big_int_mul(x, d, d) || big_int_mul(y, b, x) ||
+                big_int_add(d, x, d)) {
+                debug_print("error when calculating x * abs(%s) + y * %s. (i = %u)\n",
+                    test[i].n1, test[i].n2, i);
+            }
+            big_int_cmp(d, c, &cmp_flag);
+            if (cmp_flag != 0) {
+                debug_print("wrong result of x * abs(%s) + y * %s. (i = %u)\n",
+                    test[i].n1, test[i].n2, i);
+            }
             /* calculate absoulte values of [a] and [b] */
             if (big_int_abs(a, a)) {
                 debug_print("error in big_int_abs(%s) for [a]. (i = %u)\n", test[i].n1, i);
@@ -775,6 +808,7 @@ void test_number_theory(void)
         big_int_str_destroy(str);
         big_int_destroy(y);
         big_int_destroy(x);
+        big_int_destroy(d);
         big_int_destroy(c);
         big_int_destroy(b);
         big_int_destroy(a);
@@ -782,6 +816,70 @@ void test_number_theory(void)
     }
     printf("\n");
 
+    /* big_int_gcd_extended() for long numbers, reduced by half-GCD */
+    {
+        /* bit lengths of common factor and cofactors */
+        size_t test[][3] = {
+            {20000, 140000, 130000},
+            {1000, 160000, 159000},
+            {60000, 150000, 30000},
+        };
+        int is_divisible, cmp_flag;
+        big_int *a = NULL, *b = NULL, *c = NULL, *g = NULL, *x = NULL, *y = NULL;
+        size_t i;
+
+        printf("big_int_gcd_extended test for long numbers...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        g = big_int_create(1);
+        x = big_int_create(1);
+        y = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || g == NULL || x == NULL || y == NULL) {
+            debug_print("error when creating [a], [b], [c], [g], [x] or [y]\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            /* a = c * a', b = c * b' */
+            if (big_int_rand(rand, test[i][0], c) || big_int_rand(rand, test[i][1], a) ||
+                big_int_rand(rand, test[i][2], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_set_bit(c, test[i][0] - 1, c);
+            big_int_set_bit(a, test[i][1] - 1, a);
+            big_int_set_bit(b, test[i][2] - 1, b);
+            if (big_int_mul(a, c, a) || big_int_mul(b, c, b)) {
+                debug_print("error in big_int_mul(). (i = %u)\n", i);
+            }
+            if (big_int_gcd_extended(a, b, g, x, y)) {
+                debug_print("error in big_int_gcd_extended(). (i = %u)\n", i);
+            }
+            /* [g] must be divisible by [c] and must divide [a] and [b] */
+            if (big_int_divisible_p(g, c, &is_divisible) || !is_divisible) {
+                debug_print("gcd isn't divisible by common factor. (i = %u)\n", i);
+            }
+            if (big_int_divisible_p(a, g, &is_divisible) || !is_divisible ||
+                big_int_divisible_p(b, g, &is_divisible) || !is_divisible) {
+                debug_print("gcd doesn't divide [a] or [b]. (i = %u)\n", i);
+            }
+            /* check x * a + y * b = g */
+            if (big_int_mul(x, a, a) || big_int_mul(y, b, b) || big_int_add(a, b, a)) {
+                debug_print("error when calculating x * a + y * b. (i = %u)\n", i);
+            }
+            big_int_cmp(a, g, &cmp_flag);
+            if (cmp_flag != 0) {
+                debug_print("wrong result of x * a + y * b. Expected gcd. (i = %u)\n", i);
+            }
+        }
+        big_int_destroy(y);
+        big_int_destroy(x);
+        big_int_destroy(g);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_gcd_extended test for long numbers\n");
+    }
+    printf("\n");
+
     /* big_int_sqrt() & big_int_sqrt_rem() */
     {
         struct {
@@ -859,6 +957,8 @@ void test_number_theory(void)
             {"-5", 100, "7888609052210118054117285652827862296732064351090230047702789306640625"},
             {"2", 128, "340282366920938463463374607431768211456"},
             {"-17", 21, "-69091933913008732880827217"},
+            {"-7", 201, "-73232868039200500225132297282717695618734319851191635619650980588245880371969835762420678304365548352051456737767824199218442262405785138317055279871378715742462192840007"},
+            {"123456789", 77, "111340519166231422444610192438488559808058881746393809587296255057246611090398637909681904966508595963819784911926433731899724923673114248007459890760631739612748875206154410206121578101001730597672818987561356057202028982718555519179132079937640355793308660779777459168714633062108518291000083945307616532041356177012661571635901712024795226999256828344772590218830921307117175272400209100758034259004090172965250181154022822691219021629188251723016704963306836935297219023628361862833932334252264580466392388288096147280232752066834567507102186328410187270174428446022005159693534201237326310246320777712665327450988176229"},
             {"123213123", -100, "0"}, /* a^b=0, if b < 0 */
         };
         big_int_str *str = NULL;
@@ -1298,6 +1398,315 @@ void test_modular_arithmetic(void)
     }
     printf("\n");
 
+    /* big_int_invmod_batch() */
+    {
+        char *test[] = {
+            "170141183460469231731687303715884105727",
+            "18446744073709551616",
+            "-347832478123892312317623178123721378",
+            "3427892347891237892138970123",
+            "1",
+        };
+        big_int *in[17], *out[17], *inv[17];
+        big_int *modulus = NULL;
+        big_int_str *str = NULL;
+        int expected_result, result;
+        int cmp_flag;
+        size_t i, j, n;
+
+        printf("big_int_invmod_batch test...\n");
+        n = sizeof(in) / sizeof(in[0]);
+        for (j = 0; j < n; j++) {
+            in[j] = big_int_create(1);
+            out[j] = big_int_create(1);
+            inv[j] = big_int_create(1);
+            if (in[j] == NULL || out[j] == NULL || inv[j] == NULL) {
+                debug_print("cannot create [in], [out] or [inv] numbers\n");
+            }
+        }
+        modulus = big_int_create(1);
+        if (modulus == NULL) {
+            debug_print("cannot create [modulus]\n");
+        }
+        str = big_int_str_create(1);
+        if (str == NULL) {
+            debug_print("cannot create [str]\n");
+        }
+        for (i = 0; i < 2 * sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_str_copy_s(test[i / 2], strlen(test[i / 2]), str)) {
+                debug_print("error when copying string [%s] to [str]. (i = %u)\n", test[i / 2], i);
+            }
+            if (big_int_from_str(str, 10, modulus)) {
+                debug_print("error when converting string [%s] to number [modulus]. (i = %u)\n",
+                    test[i / 2], i);
+            }
+            /* expected results are calculated by big_int_invmod() */
+            expected_result = 0;
+            for (j = 0; j < n; j++) {
+                if (big_int_rand(rand, 40 * (j + 1), in[j])) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                /* odd numbers only for even [modulus] on the first pass */
+                if ((i & 1) == 0) {
+                    big_int_set_bit(in[j], 0, in[j]);
+                }
+                if (j & 1) {
+                    in[j]->sign = MINUS;
+                }
+                result = big_int_invmod(in[j], modulus, inv[j]);
+                if (result == 2) {
+                    expected_result = 2;
+                } else if (result) {
+                    debug_print("error in big_int_invmod(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+            /* out[j] can be equal to in[j] */
+            if (i & 1) {
+                result = big_int_invmod_batch((const big_int **) in, n, modulus, in);
+            } else {
+                result = big_int_invmod_batch((const big_int **) in, n, modulus, out);
+            }
+            if (result != expected_result) {
+                debug_print("wrong result of big_int_invmod_batch() = %d. Expected %d. (i = %u)\n",
+                    result, expected_result, i);
+            }
+            if (result) {
+                continue;
+            }
+            for (j = 0; j < n; j++) {
+                big_int_cmp((i & 1) ? in[j] : out[j], inv[j], &cmp_flag);
+                if (cmp_flag != 0) {
+                    debug_print("wrong value of big_int_invmod_batch(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+        }
+        big_int_str_destroy(str);
+        big_int_destroy(modulus);
+        for (j = 0; j < n; j++) {
+            big_int_destroy(inv[j]);
+            big_int_destroy(out[j]);
+            big_int_destroy(in[j]);
+        }
+        printf("end of big_int_invmod_batch test\n");
+    }
+    printf("\n");
+
+    /* big_int_multi_powmod() and big_int_powmod2() */
+    {
+        char *test[] = {
+            "170141183460469231731687303715884105727",
+            "18446744073709551616",
+            "-347832478123892312317623178123721378",
+            "3427892347891237892138970123",
+            "1",
+        };
+        big_int *a[7], *b[7];
+        big_int *modulus = NULL, *answer = NULL, *c = NULL, *d = NULL;
+        big_int_str *str = NULL;
+        int expected_result, result;
+        int cmp_flag;
+        size_t i, j, n;
+
+        printf("big_int_multi_powmod test...\n");
+        for (j = 0; j < sizeof(a) / sizeof(a[0]); j++) {
+            a[j] = big_int_create(1);
+            b[j] = big_int_create(1);
+            if (a[j] == NULL || b[j] == NULL) {
+                debug_print("cannot create [a] or [b] numbers\n");
+            }
+        }
+        modulus = big_int_create(1);
+        answer = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        if (modulus == NULL || answer == NULL || c == NULL || d == NULL) {
+            debug_print("cannot create [modulus], [answer], [c] or [d]\n");
+        }
+        str = big_int_str_create(1);
+        if (str == NULL) {
+            debug_print("cannot create [str]\n");
+        }
+        for (i = 0; i < 4 * sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_str_copy_s(test[i / 4], strlen(test[i / 4]), str)) {
+                debug_print("error when copying string [%s] to [str]. (i = %u)\n", test[i / 4], i);
+            }
+            if (big_int_from_str(str, 10, modulus)) {
+                debug_print("error when converting string [%s] to number [modulus]. (i = %u)\n",
+                    test[i / 4], i);
+            }
+            /*
+                n = 0, 2, 4, 6 numbers. Exponents have different lengths,
+                some of them are zero, negative exponents are on odd passes.
+                Expected result is calculated by big_int_powmod() and big_int_mulmod()
+            */
+            n = 2 * (i & 3);
+            expected_result = 0;
+            if (big_int_from_int(1, d) || big_int_absmod(d, modulus, d)) {
+                debug_print("error when setting [d] = 1. (i = %u)\n", i);
+            }
+            for (j = 0; j < n; j++) {
+                if (big_int_rand(rand, 30 * (j + 1), a[j])) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                if (j % 3 == 2) {
+                    if (big_int_from_int(0, b[j])) {
+                        debug_print("error in big_int_from_int(). (i = %u, j = %u)\n", i, j);
+                    }
+                } else if (big_int_rand(rand, 1 + 40 * (n - j) / (j + 1), b[j])) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                if ((i & 1) && j == 1) {
+                    b[j]->sign = MINUS;
+                }
+                result = big_int_powmod(a[j], b[j], modulus, c);
+                if (result == 2) {
+                    expected_result = 2;
+                } else if (result) {
+                    debug_print("error in big_int_powmod(). (i = %u, j = %u)\n", i, j);
+                } else if (big_int_mulmod(c, d, modulus, d)) {
+                    debug_print("error in big_int_mulmod(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+            result = big_int_multi_powmod((const big_int **) a, (const big_int **) b, n,
+                modulus, answer);
+            if (result != expected_result) {
+                debug_print("wrong result of big_int_multi_powmod() = %d. Expected %d. (i = %u)\n",
+                    result, expected_result, i);
+            }
+            if (result) {
+                continue;
+            }
+            big_int_cmp(answer, d, &cmp_flag);
+            if (cmp_flag != 0) {
+                debug_print("wrong value of big_int_multi_powmod(). (i = %u)\n", i);
+            }
+            if (n < 2) {
+                continue;
+            }
+            /* [answer] can be equal to [a1] */
+            if (big_int_copy(a[0], answer)) {
+                debug_print("error in big_int_copy(). (i = %u)\n", i);
+            }
+            if (big_int_powmod2(answer, b[0], a[1], b[1], modulus, answer)) {
+                debug_print("error in big_int_powmod2(). (i = %u)\n", i);
+            }
+            for (j = 2; j < n; j++) {
+                if (big_int_powmod(a[j], b[j], modulus, c) ||
+                    big_int_mulmod(c, answer, modulus, answer)) {
+                    debug_print("error in big_int_powmod(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+            big_int_cmp(answer, d, &cmp_flag);
+            if (cmp_flag != 0) {
+                debug_print("wrong value of big_int_powmod2(). (i = %u)\n", i);
+            }
+        }
+        big_int_str_destroy(str);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(answer);
+        big_int_destroy(modulus);
+        for (j = 0; j < sizeof(a) / sizeof(a[0]); j++) {
+            big_int_destroy(b[j]);
+            big_int_destroy(a[j]);
+        }
+        printf("end of big_int_multi_powmod test\n");
+    }
+    printf("\n");
+
+    /* big_int_powmod_crt() */
+    {
+        /*
+            lengths (in bits) of primes [p] and [q]. Result of
+            big_int_powmod_crt() is checked against big_int_powmod()
+        */
+        size_t test[][2] = {
+            {5, 7},
+            {20, 20},
+            {64, 70},
+            {512, 512},
+            {1030, 1000},
+        };
+        big_int *p = NULL, *q = NULL, *n = NULL, *c = NULL, *d = NULL;
+        big_int *dp = NULL, *dq = NULL, *qinv = NULL, *a = NULL, *b = NULL;
+        int cmp_flag;
+        size_t i;
+
+        printf("big_int_powmod_crt test...\n");
+        p = big_int_create(1);
+        q = big_int_create(1);
+        n = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        dp = big_int_create(1);
+        dq = big_int_create(1);
+        qinv = big_int_create(1);
+        a = big_int_create(1);
+        b = big_int_create(1);
+        if (p == NULL || q == NULL || n == NULL || c == NULL || d == NULL ||
+            dp == NULL || dq == NULL || qinv == NULL || a == NULL || b == NULL) {
+            debug_print("cannot create numbers\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], p) || big_int_rand(rand, test[i][1], q)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_set_bit(p, test[i][0] - 1, p);
+            big_int_set_bit(q, test[i][1] - 1, q);
+            if (big_int_next_prime(p, p) || big_int_next_prime(q, q)) {
+                debug_print("error in big_int_next_prime(). (i = %u)\n", i);
+            }
+            big_int_cmp(p, q, &cmp_flag);
+            if (cmp_flag == 0 && big_int_next_prime(q, q)) {
+                debug_print("error in big_int_next_prime(). (i = %u)\n", i);
+            }
+            if (big_int_mul(p, q, n) || big_int_rand(rand, test[i][0] + test[i][1], d) ||
+                big_int_rand(rand, test[i][0] + test[i][1] + 10, c)) {
+                debug_print("error when calculating [n], [d] or [c]. (i = %u)\n", i);
+            }
+            /* dp = d (mod p - 1), dq = d (mod q - 1), qinv = inv(q) (mod p) */
+            if (big_int_dec(p, a) || big_int_mod(d, a, dp) ||
+                big_int_dec(q, a) || big_int_mod(d, a, dq) ||
+                big_int_invmod(q, p, qinv)) {
+                debug_print("error when calculating [dp], [dq] or [qinv]. (i = %u)\n", i);
+            }
+            if (big_int_powmod(c, d, n, a)) {
+                debug_print("error in big_int_powmod(). (i = %u)\n", i);
+            }
+            if (big_int_powmod_crt(c, p, q, dp, dq, qinv, b)) {
+                debug_print("error in big_int_powmod_crt(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, b, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong value of big_int_powmod_crt(). (i = %u)\n", i);
+            }
+            /* [answer] can be equal to [c] */
+            if (big_int_powmod_crt(c, p, q, dp, dq, qinv, c)) {
+                debug_print("error in big_int_powmod_crt(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, c, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong value of big_int_powmod_crt(). (i = %u)\n", i);
+            }
+        }
+        big_int_from_int(0, a);
+        if (big_int_powmod_crt(c, p, a, dp, dq, qinv, b) != 1) {
+            debug_print("big_int_powmod_crt() must return 1 for zero [q]\n");
+        }
+        big_int_destroy(b);
+        big_int_destroy(a);
+        big_int_destroy(qinv);
+        big_int_destroy(dq);
+        big_int_destroy(dp);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(n);
+        big_int_destroy(q);
+        big_int_destroy(p);
+        printf("end of big_int_powmod_crt test\n");
+    }
+    printf("\n");
+
     /* big_int_factmod() */
     {
         struct {
@@ -1538,129 +1947,797 @@ void test_modular_arithmetic(void)
         printf("end of test of big_int_addmod, big_int_submod, big_int_divmod, big_int_mulmod & big_int_powmod\n");
     }
     printf("\n");
-}
-
-/**
-    Test of string funcs
-*/
-void test_str_funcs(void)
-{
-    /*
-        big_int_str_create(), big_int_str_dup(), big_int_str_copy(),
-        big_int_str_copy_s(), big_int_str_realloc(), big_int_str_destroy()
-    */
-    struct {
-        char *str;
-        size_t len;
-    } test[] = {
-        {"", 0},
-        {"qwe\0rtu", 7},
-        {"1", 1},
-    };
-    size_t i;
-    big_int_str *str1 = NULL, *str2 = NULL, *str3 = NULL;
-
-    printf("big_int_str_* tests...\n");
-    str1 = big_int_str_create(1);
-    str3 = big_int_str_create(1);
-    if (str1 == NULL || str3 == NULL) {
-        debug_print("error when creating big_int_str object\n");
-    }
-    if (big_int_str_realloc(str1, 1000)) {
-        debug_print("error when reallocating [str1]\n");
-    }
-    for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
-        if (big_int_str_copy_s(test[i].str, test[i].len, str1)) {
-            debug_print("error when copying string [%s] with length = %u to big_int_str object. (i = %u)\n",
-                test[i].str, test[i].len, i);
-        }
-        /* test big_int_str_dup() */
-        str2 = big_int_str_dup(str1);
-        if (str2 == NULL) {
-            debug_print("cannot duplicate string [%s] with length = %u. (i = %u)\n",
-                test[i].str, test[i].len, i);
-        }
-        if (memcmp(str1->str, str2->str, str2->len)) {
-            debug_print("wrong copy of string [str1] [%s] with length = %u to [str2] [%s] with length = %u (after big_int_str_dup). (i = %u)\n",
-                str1->str, str1->len, str2->str, str2->len, i);
-        }
-        /* test big_int_str_copy() */
-        if (big_int_str_copy(str1, str3)) {
-            debug_print("error in big_int_str_copy() function for string [%s] with length = %u. (i = %u)\n",
-                str1->str, str1->len, i);
-        }
-        if (memcmp(str1->str, str3->str, str3->len)) {
-            debug_print("wrong copy of string [str1] [%s] with length = %u to [str3] [%s] with length = %u (after big_int_str_copy). (i = %u)\n",
-                str1->str, str1->len, str3->str, str3->len, i);
-        }
-        big_int_str_destroy(str2);
-    }
-    big_int_str_destroy(str3);
-    big_int_str_destroy(str1);
-    printf("end of big_int_str_* tests\n");
-    printf("\n");
-}
 
-/**
-    Test of basic funcs
-*/
-void test_basic_funcs(void)
-{
-    /* big_int_abs(), big_int_cmp_abs() & big_int_cmp() */
+    /* big_int_powmod() with odd moduli & Montgomery context */
     {
-        size_t i;
-        big_int *a = NULL, *b = NULL;
-        struct {
-            char *n1;
-            char *n2;
-            int cmp_abs;
-            int cmp;
-        } test[] = {
-            {"-1234567890", "0", 1, -1},
-            {"0", "0", 0, 0},
-            {"21903209239023190", "21903209239023190", 0, 0},
-            {"21903209239023190", "-21903209239023190", 0, 1},
-            {"-21903209239023190", "21903209239023191", -1, -1},
-            {"21903209239023190", "-21903209239023191", -1, 1},
+        /*
+            lengths (in bits) of modulus and exponent. Result of big_int_powmod()
+            by odd modulus [c] is checked against big_int_powmod() by even
+            modulus 2 * c, which uses Barrett reduction instead of Montgomery
+            multiplication
+        */
+        size_t test[][2] = {
+            {2, 10},
+            {64, 64},
+            {100, 1},
+            {521, 521},
+            {1024, 200},
+            {2048, 2048},
         };
-        big_int_str *str = NULL;
+        size_t i;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL, *f = NULL;
+        big_int_mont *ctx = NULL;
         int cmp_flag;
 
-        printf("big_int_abs, big_int_cmp_abs & big_int_cmp tests...\n");
+        printf("test of big_int_powmod with odd moduli & Montgomery context...\n");
         a = big_int_create(1);
         b = big_int_create(1);
-        if (a == NULL || b == NULL) {
-            debug_print("error when creating big_int numbers [a] or [b]\n");
-        }
-        str = big_int_str_create(1);
-        if (str == NULL) {
-            debug_print("error when creating big_int_str string\n");
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        f = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL || f == NULL) {
+            debug_print("error when creating [a], [b], [c], [d], [e] or [f]\n");
         }
         for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
-            if (big_int_str_copy_s(test[i].n1, strlen(test[i].n1), str)) {
-                debug_print("error when copying string %s to big_int_str. (i = %u)\n", test[i].n1, i);
+            if (big_int_rand(rand, test[i][0], c) || big_int_rand(rand, test[i][0], a) ||
+                big_int_rand(rand, test[i][1], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
             }
-            if (big_int_from_str(str, 10, a)) {
-                debug_print("error when converting string %s to number [a]. (i = %u)\n", test[i].n1, i);
+            big_int_set_bit(c, 0, c);
+            big_int_set_bit(c, test[i][0] - 1, c);
+            if (i & 1) {
+                a->sign = MINUS;
             }
-            if (big_int_str_copy_s(test[i].n2, strlen(test[i].n2), str)) {
-                debug_print("error when copying string %s to big_int_str. (i = %u)\n", test[i].n2, i);
+            /* test big_int_powmod() */
+            if (big_int_powmod(a, b, c, d)) {
+                debug_print("error in big_int_powmod(). (i = %u)\n", i);
             }
-            if (big_int_from_str(str, 10, b)) {
-                debug_print("error when converting string %s to number [b]. (i = %u)\n", test[i].n2, i);
+            if (big_int_lshift(c, 1, e)) {
+                debug_print("error in big_int_lshift(). (i = %u)\n", i);
             }
-            big_int_cmp(a, b, &cmp_flag);
-            if (cmp_flag != test[i].cmp) {
-                debug_print("wrong comparision of numbers %s and %s. Cmp_flag = %d, expected %d (i = %u)\n",
-                    test[i].n1, test[i].n2, cmp_flag, test[i].cmp, i);
+            if (big_int_powmod(a, b, e, f) || big_int_mod(f, c, f)) {
+                debug_print("error in big_int_powmod() by even modulus. (i = %u)\n", i);
             }
-            big_int_cmp_abs(a, b, &cmp_flag);
-            if (cmp_flag != test[i].cmp_abs) {
-                debug_print("wrong abs comparision of numbers %s and %s. Cmp_flag = %d, expected %d (i = %u)\n",
-                    test[i].n1, test[i].n2, cmp_flag, test[i].cmp, i);
+            big_int_cmp(d, f, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_powmod() for %u-bit modulus and %u-bit exponent. (i = %u)\n",
+                    test[i][0], test[i][1], i);
             }
-            /* manually abs [a] and [b] */
-            if (big_int_abs(a, a)) {
+            /* test Montgomery context: from(mul(to(a), to(b))) = a * b (mod c) */
+            ctx = big_int_mont_create(c);
+            if (ctx == NULL) {
+                debug_print("error in big_int_mont_create(). (i = %u)\n", i);
+            }
+            if (big_int_mont_to(ctx, a, d) || big_int_mont_to(ctx, b, e)) {
+                debug_print("error in big_int_mont_to(). (i = %u)\n", i);
+            }
+            if (big_int_mont_mul(ctx, d, e, d)) {
+                debug_print("error in big_int_mont_mul(). (i = %u)\n", i);
+            }
+            if (big_int_mont_sqr(ctx, e, e)) {
+                debug_print("error in big_int_mont_sqr(). (i = %u)\n", i);
+            }
+            if (big_int_mont_from(ctx, d, d) || big_int_mont_from(ctx, e, e)) {
+                debug_print("error in big_int_mont_from(). (i = %u)\n", i);
+            }
+            if (big_int_mulmod(a, b, c, f)) {
+                debug_print("error in big_int_mulmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(d, f, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_mont_mul(). (i = %u)\n", i);
+            }
+            if (big_int_sqrmod(b, c, f)) {
+                debug_print("error in big_int_sqrmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(e, f, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_mont_sqr(). (i = %u)\n", i);
+            }
+            /* numbers out of range [0 .. c - 1] must be rejected */
+            if (!big_int_mont_mul(ctx, c, d, d)) {
+                debug_print("big_int_mont_mul() accepted number, which is not reduced. (i = %u)\n", i);
+            }
+            big_int_mont_destroy(ctx);
+        }
+        big_int_destroy(f);
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of big_int_powmod with odd moduli & Montgomery context\n");
+    }
+    printf("\n");
+
+    /* Barrett context */
+    {
+        /*
+            lengths (in bits) of modulus and [a]. Modulus is even.
+            If the third value is not zero, then modulus is power of 2
+        */
+        size_t test[][3] = {
+            {2, 3, 1},
+            {8, 20, 0},
+            {64, 200, 0},
+            {65, 130, 1},
+            {300, 600, 0},
+            {1024, 1000, 1},
+            {4000, 8000, 0},
+        };
+        size_t i;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL;
+        big_int_barrett *ctx = NULL;
+        int cmp_flag;
+
+        printf("test of Barrett context...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [e]\n");
+        }
+        if (big_int_barrett_create(a) != NULL) {
+            debug_print("big_int_barrett_create() must return NULL for zero modulus\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (test[i][2]) {
+                big_int_from_int(0, c);
+            } else if (big_int_rand(rand, test[i][0], c)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            if (big_int_rand(rand, test[i][1], a) || big_int_rand(rand, test[i][0], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_clr_bit(c, 0, c);
+            big_int_set_bit(c, test[i][0] - 1, c);
+            if (i & 1) {
+                a->sign = MINUS;
+                c->sign = MINUS;
+            }
+            ctx = big_int_barrett_create(c);
+            if (ctx == NULL) {
+                debug_print("error in big_int_barrett_create(). (i = %u)\n", i);
+                continue;
+            }
+            /* big_int_barrett_reduce() */
+            if (big_int_absmod(a, c, e)) {
+                debug_print("error in big_int_absmod(). (i = %u)\n", i);
+            }
+            if (big_int_barrett_reduce(ctx, a, d)) {
+                debug_print("error in big_int_barrett_reduce(). (i = %u)\n", i);
+            }
+            big_int_cmp(d, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_barrett_reduce(). (i = %u)\n", i);
+            }
+            /* big_int_barrett_mul() & big_int_barrett_sqr() */
+            if (big_int_barrett_reduce(ctx, b, b)) {
+                debug_print("error in big_int_barrett_reduce(). (i = %u)\n", i);
+            }
+            if (big_int_barrett_mul(ctx, d, b, e)) {
+                debug_print("error in big_int_barrett_mul(). (i = %u)\n", i);
+            }
+            if (big_int_mulmod(d, b, c, a)) {
+                debug_print("error in big_int_mulmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_barrett_mul(). (i = %u)\n", i);
+            }
+            if (big_int_barrett_sqr(ctx, b, e)) {
+                debug_print("error in big_int_barrett_sqr(). (i = %u)\n", i);
+            }
+            if (big_int_sqrmod(b, c, a)) {
+                debug_print("error in big_int_sqrmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_barrett_sqr(). (i = %u)\n", i);
+            }
+            /* big_int_barrett_pow(): b^13 (mod c) */
+            if (big_int_from_int(13, e) || big_int_barrett_pow(ctx, b, e, d)) {
+                debug_print("error in big_int_barrett_pow(). (i = %u)\n", i);
+            }
+            if (big_int_pow(b, 13, a) || big_int_absmod(a, c, a)) {
+                debug_print("error in big_int_pow(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_barrett_pow(). (i = %u)\n", i);
+            }
+            /* numbers out of range [0 .. c - 1] must be rejected */
+            if (!big_int_barrett_mul(ctx, c, d, d)) {
+                debug_print("big_int_barrett_mul() accepted number, which is not reduced. (i = %u)\n", i);
+            }
+            big_int_barrett_destroy(ctx);
+        }
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of Barrett context\n");
+    }
+    printf("\n");
+
+    /* special-form context */
+    {
+        /*
+            modulus is 2^k - c, 2^k + c or 2^k - (2^(t - 1) - 2^(t / 2) + 1).
+            Values are [k], length of [c] (or [t]) in bits and form of modulus
+        */
+        size_t test[][3] = {
+            {2, 1, 0},
+            {61, 0, 1},
+            {127, 1, 0},
+            {224, 97, 2},
+            {255, 5, 0},
+            {256, 100, 1},
+            {521, 1, 0},
+            {1279, 700, 0},
+            {3000, 64, 1},
+            {4000, 2500, 2},
+        };
+        size_t i;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL;
+        big_int_special_mod *ctx = NULL;
+        int cmp_flag;
+
+        printf("test of special-form context...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [e]\n");
+        }
+        if (big_int_special_mod_create(a) != NULL) {
+            debug_print("big_int_special_mod_create() must return NULL for zero modulus\n");
+        }
+        /* 2^502 + 2^500 + 1 is too far from power of 2 */
+        big_int_from_int(1, a);
+        big_int_set_bit(a, 500, a);
+        big_int_set_bit(a, 502, a);
+        if (big_int_special_mod_create(a) != NULL) {
+            debug_print("big_int_special_mod_create() must return NULL for 2^502 + 2^500 + 1\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            /* c = modulus */
+            big_int_from_int(0, c);
+            big_int_set_bit(c, test[i][0], c);
+            big_int_from_int(0, d);
+            if (test[i][2] == 2) {
+                big_int_set_bit(d, test[i][1] - 1, d);
+                big_int_from_int(0, e);
+                big_int_set_bit(e, test[i][1] / 2, e);
+                big_int_sub(d, e, d);
+                big_int_inc(d, d);
+            } else if (test[i][1]) {
+                if (big_int_rand(rand, test[i][1], d)) {
+                    debug_print("error in big_int_rand(). (i = %u)\n", i);
+                }
+                big_int_set_bit(d, test[i][1] - 1, d);
+            }
+            if (test[i][2] == 1) {
+                big_int_add(c, d, c);
+            } else {
+                big_int_sub(c, d, c);
+            }
+            if (i & 1) {
+                c->sign = MINUS;
+            }
+            ctx = big_int_special_mod_create(c);
+            if (ctx == NULL) {
+                debug_print("error in big_int_special_mod_create(). (i = %u)\n", i);
+                continue;
+            }
+            /* big_int_special_mod_reduce() for numbers up to 2 * k bits and longer */
+            if (big_int_rand(rand, test[i][0] * ((i % 3) + 1), a) ||
+                big_int_rand(rand, test[i][0], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_mul(a, a, a);
+            if (i & 2) {
+                a->sign = MINUS;
+            }
+            if (big_int_absmod(a, c, e)) {
+                debug_print("error in big_int_absmod(). (i = %u)\n", i);
+            }
+            if (big_int_special_mod_reduce(ctx, a, d)) {
+                debug_print("error in big_int_special_mod_reduce(). (i = %u)\n", i);
+            }
+            big_int_cmp(d, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_special_mod_reduce(). (i = %u)\n", i);
+            }
+            /* big_int_special_mod_mul(), big_int_special_mod_sqr(), big_int_mulmod() & big_int_sqrmod() */
+            if (big_int_special_mod_reduce(ctx, b, b)) {
+                debug_print("error in big_int_special_mod_reduce(). (i = %u)\n", i);
+            }
+            if (big_int_special_mod_mul(ctx, d, b, e)) {
+                debug_print("error in big_int_special_mod_mul(). (i = %u)\n", i);
+            }
+            if (big_int_mul(d, b, a) || big_int_absmod(a, c, a)) {
+                debug_print("error in big_int_mul(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_special_mod_mul(). (i = %u)\n", i);
+            }
+            if (big_int_mulmod(d, b, c, e)) {
+                debug_print("error in big_int_mulmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_mulmod(). (i = %u)\n", i);
+            }
+            if (big_int_special_mod_sqr(ctx, b, e)) {
+                debug_print("error in big_int_special_mod_sqr(). (i = %u)\n", i);
+            }
+            if (big_int_sqr(b, a) || big_int_absmod(a, c, a)) {
+                debug_print("error in big_int_sqr(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_special_mod_sqr(). (i = %u)\n", i);
+            }
+            if (big_int_sqrmod(b, c, e)) {
+                debug_print("error in big_int_sqrmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_sqrmod(). (i = %u)\n", i);
+            }
+            /* big_int_special_mod_pow() & big_int_powmod(): b^13 (mod c) */
+            if (big_int_from_int(13, e) || big_int_special_mod_pow(ctx, b, e, d)) {
+                debug_print("error in big_int_special_mod_pow(). (i = %u)\n", i);
+            }
+            if (big_int_pow(b, 13, a) || big_int_absmod(a, c, a)) {
+                debug_print("error in big_int_pow(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_special_mod_pow(). (i = %u)\n", i);
+            }
+            if (big_int_powmod(b, e, c, d)) {
+                debug_print("error in big_int_powmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_powmod(). (i = %u)\n", i);
+            }
+            /* numbers out of range [0 .. c - 1] must be rejected */
+            if (!big_int_special_mod_mul(ctx, c, d, d)) {
+                debug_print("big_int_special_mod_mul() accepted number, which is not reduced. (i = %u)\n", i);
+            }
+            big_int_special_mod_destroy(ctx);
+        }
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of special-form context\n");
+    }
+    printf("\n");
+
+    /* fixed-base context */
+    {
+        /*
+            lengths (in bits) of modulus, base and [exp_bits] for
+            big_int_fixed_base_create(). Modulus is odd.
+            Exponents are shorter, equal and longer than [exp_bits]
+        */
+        size_t test[][3] = {
+            {2, 5, 0},
+            {17, 40, 5},
+            {64, 64, 64},
+            {130, 300, 127},
+            {512, 512, 256},
+            {1024, 100, 1024},
+            {2048, 2048, 2048},
+        };
+        size_t i, j;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL;
+        big_int_fixed_base *ctx = NULL;
+        int cmp_flag, result, expected_result;
+
+        printf("test of fixed-base context...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [e]\n");
+        }
+        if (big_int_from_int(10, c) || big_int_fixed_base_create(a, c, 10) != NULL) {
+            debug_print("big_int_fixed_base_create() must return NULL for even modulus\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], c) || big_int_rand(rand, test[i][1], a)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_set_bit(c, 0, c);
+            big_int_set_bit(c, test[i][0] - 1, c);
+            if (i & 1) {
+                a->sign = MINUS;
+                c->sign = MINUS;
+            }
+            ctx = big_int_fixed_base_create(a, c, test[i][2]);
+            if (ctx == NULL) {
+                debug_print("error in big_int_fixed_base_create(). (i = %u)\n", i);
+                continue;
+            }
+            for (j = 0; j < 8; j++) {
+                if (big_int_rand(rand, (j < 2) ? j : test[i][2] * (j - 1) / 4 + j - 1, b)) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                if (j & 1) {
+                    b->sign = MINUS;
+                }
+                expected_result = big_int_powmod(a, b, c, d);
+                if (expected_result != 0 && expected_result != 2) {
+                    debug_print("error in big_int_powmod(). (i = %u, j = %u)\n", i, j);
+                }
+                result = big_int_fixed_base_pow(ctx, b, e);
+                if (result != (expected_result ? 1 : 0)) {
+                    debug_print("wrong result of big_int_fixed_base_pow() = %d. (i = %u, j = %u)\n",
+                        result, i, j);
+                    continue;
+                }
+                big_int_cmp(d, e, &cmp_flag);
+                if (result == 0 && cmp_flag) {
+                    debug_print("wrong value of big_int_fixed_base_pow(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+            /* [answer] can be equal to exponent */
+            b->sign = PLUS;
+            if (big_int_powmod(a, b, c, d) || big_int_fixed_base_pow(ctx, b, b)) {
+                debug_print("error in big_int_fixed_base_pow(). (i = %u)\n", i);
+            }
+            big_int_cmp(d, b, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong value of big_int_fixed_base_pow(). (i = %u)\n", i);
+            }
+            big_int_fixed_base_destroy(ctx);
+        }
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of fixed-base context\n");
+    }
+    printf("\n");
+
+    /* big_int_powmod_ct() */
+    {
+        /*
+            lengths (in bits) of [a], exponent and modulus. Result of
+            big_int_powmod_ct() is checked against big_int_powmod()
+        */
+        size_t test[][3] = {
+            {0, 0, 65},
+            {10, 0, 3},
+            {100, 100, 1},
+            {1000, 20, 61},
+            {512, 512, 512},
+            {3000, 1024, 1024},
+            {2048, 2048, 2048},
+        };
+        size_t i;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL;
+        int cmp_flag;
+
+        printf("test of big_int_powmod_ct...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [e]\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], a) || big_int_rand(rand, test[i][1], b) ||
+                big_int_rand(rand, test[i][2], c)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_set_bit(c, 0, c);
+            big_int_set_bit(c, test[i][2] - 1, c);
+            if (i & 1) {
+                a->sign = MINUS;
+            }
+            if (big_int_powmod_ct(a, b, c, d)) {
+                debug_print("error in big_int_powmod_ct(). (i = %u)\n", i);
+            }
+            if (big_int_powmod(a, b, c, e)) {
+                debug_print("error in big_int_powmod(). (i = %u)\n", i);
+            }
+            big_int_cmp(d, e, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_powmod_ct() for %u-bit number, %u-bit exponent and %u-bit modulus. (i = %u)\n",
+                    test[i][0], test[i][1], test[i][2], i);
+            }
+        }
+        /* even modulus and negative exponent are not supported */
+        big_int_from_int(10, c);
+        if (big_int_powmod_ct(a, b, c, d) != 2) {
+            debug_print("big_int_powmod_ct() must return 2 for even modulus\n");
+        }
+        big_int_from_int(11, c);
+        big_int_from_int(-3, b);
+        if (big_int_powmod_ct(a, b, c, d) != 3) {
+            debug_print("big_int_powmod_ct() must return 3 for negative exponent\n");
+        }
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of big_int_powmod_ct\n");
+    }
+    printf("\n");
+
+    /* big_int_sqrtmod() */
+    {
+        /*
+            lengths (in bits) of prime modulus p and [s]: p - 1 = Q * 2^s,
+            where Q is odd. s = 1 and s = 2 are p = 3 (mod 4) and
+            p = 5 (mod 8) cases, other - Tonelli-Shanks algorithm
+        */
+        size_t test[][2] = {
+            {8, 1},
+            {8, 2},
+            {8, 4},
+            {20, 3},
+            {64, 1},
+            {64, 2},
+            {128, 5},
+            {256, 32},
+            {521, 1},
+            {768, 2},
+            {768, 17},
+        };
+        size_t i, j;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *e = NULL;
+        int cmp_flag, is_prime, jacobi;
+
+        printf("test of big_int_sqrtmod...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        e = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || e == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [e]\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            /* c = Q * 2^s + 1 is prime, d = 2^(s + 1) keeps Q odd */
+            if (big_int_rand(rand, test[i][0] - test[i][1], c)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            big_int_set_bit(c, 0, c);
+            big_int_set_bit(c, test[i][0] - test[i][1] - 1, c);
+            big_int_lshift(c, (int) test[i][1], c);
+            big_int_inc(c, c);
+            big_int_from_int(0, d);
+            big_int_set_bit(d, test[i][1] + 1, d);
+            for (;;) {
+                if (big_int_is_prime(c, 100, 1, &is_prime)) {
+                    debug_print("error in big_int_is_prime(). (i = %u)\n", i);
+                    break;
+                }
+                if (is_prime) {
+                    break;
+                }
+                big_int_add(c, d, c);
+            }
+            if (i & 1) {
+                c->sign = MINUS;
+            }
+            for (j = 0; j < 4; j++) {
+                /* a = b * b (mod c) */
+                if (big_int_rand(rand, test[i][0] + 10, b)) {
+                    debug_print("error in big_int_rand(). (i = %u)\n", i);
+                }
+                if (j & 1) {
+                    b->sign = MINUS;
+                }
+                big_int_sqrmod(b, c, a);
+                if (big_int_sqrtmod(a, c, d)) {
+                    debug_print("error in big_int_sqrtmod(). (i = %u, j = %u)\n", i, j);
+                    continue;
+                }
+                /* d * d = a (mod c) and d is the least root */
+                big_int_sqrmod(d, c, e);
+                big_int_cmp(e, a, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong result of big_int_sqrtmod() for %u-bit modulus. (i = %u, j = %u)\n",
+                        test[i][0], i, j);
+                }
+                big_int_abs(c, e);
+                big_int_sub(e, d, e);
+                big_int_cmp(e, d, &cmp_flag);
+                if (cmp_flag < 0) {
+                    debug_print("big_int_sqrtmod() must return the least root. (i = %u, j = %u)\n", i, j);
+                }
+            }
+            /* the least non-residue */
+            big_int_abs(c, e);
+            big_int_from_int(2, a);
+            for (;;) {
+                big_int_jacobi(a, e, &jacobi);
+                if (jacobi == -1) {
+                    break;
+                }
+                big_int_inc(a, a);
+            }
+            if (big_int_sqrtmod(a, c, d) != 2) {
+                debug_print("big_int_sqrtmod() must return 2 for non-residue. (i = %u)\n", i);
+            }
+        }
+        /* sqrt(0) and p = 2 */
+        big_int_from_int(0, a);
+        if (big_int_sqrtmod(a, c, d) || d->len != 1 || d->num[0] != 0) {
+            debug_print("big_int_sqrtmod() must return 0 for a = 0\n");
+        }
+        big_int_from_int(2, c);
+        big_int_from_int(7, a);
+        if (big_int_sqrtmod(a, c, d) || d->len != 1 || d->num[0] != 1) {
+            debug_print("big_int_sqrtmod() must return 1 for a = 7, p = 2\n");
+        }
+        /* division by zero and composite moduli */
+        big_int_from_int(0, c);
+        if (big_int_sqrtmod(a, c, d) != 1) {
+            debug_print("big_int_sqrtmod() must return 1 for zero modulus\n");
+        }
+        big_int_from_int(4, a);
+        big_int_from_int(15, c);
+        if (big_int_sqrtmod(a, c, d) != 3) {
+            debug_print("big_int_sqrtmod() must return 3 for a = 4, p = 15\n");
+        }
+        big_int_from_int(289, c);
+        if (big_int_sqrtmod(a, c, d) != 3) {
+            debug_print("big_int_sqrtmod() must return 3 for a = 4, p = 289\n");
+        }
+        big_int_destroy(e);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of test of big_int_sqrtmod\n");
+    }
+    printf("\n");
+}
+
+/**
+    Test of string funcs
+*/
+void test_str_funcs(void)
+{
+    /*
+        big_int_str_create(), big_int_str_dup(), big_int_str_copy(),
+        big_int_str_copy_s(), big_int_str_realloc(), big_int_str_destroy()
+    */
+    struct {
+        char *str;
+        size_t len;
+    } test[] = {
+        {"", 0},
+        {"qwe\0rtu", 7},
+        {"1", 1},
+    };
+    size_t i;
+    big_int_str *str1 = NULL, *str2 = NULL, *str3 = NULL;
+
+    printf("big_int_str_* tests...\n");
+    str1 = big_int_str_create(1);
+    str3 = big_int_str_create(1);
+    if (str1 == NULL || str3 == NULL) {
+        debug_print("error when creating big_int_str object\n");
+    }
+    if (big_int_str_realloc(str1, 1000)) {
+        debug_print("error when reallocating [str1]\n");
+    }
+    for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+        if (big_int_str_copy_s(test[i].str, test[i].len, str1)) {
+            debug_print("error when copying string [%s] with length = %u to big_int_str object. (i = %u)\n",
+                test[i].str, test[i].len, i);
+        }
+        /* test big_int_str_dup() */
+        str2 = big_int_str_dup(str1);
+        if (str2 == NULL) {
+            debug_print("cannot duplicate string [%s] with length = %u. (i = %u)\n",
+                test[i].str, test[i].len, i);
+        }
+        if (memcmp(str1->str, str2->str, str2->len)) {
+            debug_print("wrong copy of string [str1] [%s] with length = %u to [str2] [%s] with length = %u (after big_int_str_dup). (i = %u)\n",
+                str1->str, str1->len, str2->str, str2->len, i);
+        }
+        /* test big_int_str_copy() */
+        if (big_int_str_copy(str1, str3)) {
+            debug_print("error in big_int_str_copy() function for string [%s] with length = %u. (i = %u)\n",
+                str1->str, str1->len, i);
+        }
+        if (memcmp(str1->str, str3->str, str3->len)) {
+            debug_print("wrong copy of string [str1] [%s] with length = %u to [str3] [%s] with length = %u (after big_int_str_copy). (i = %u)\n",
+                str1->str, str1->len, str3->str, str3->len, i);
+        }
+        big_int_str_destroy(str2);
+    }
+    big_int_str_destroy(str3);
+    big_int_str_destroy(str1);
+    printf("end of big_int_str_* tests\n");
+    printf("\n");
+}
+
+/**
+    Test of basic funcs
+*/
+void test_basic_funcs(void)
+{
+    /* big_int_abs(), big_int_cmp_abs() & big_int_cmp() */
+    {
+        size_t i;
+        big_int *a = NULL, *b = NULL;
+        struct {
+            char *n1;
+            char *n2;
+            int cmp_abs;
+            int cmp;
+        } test[] = {
+            {"-1234567890", "0", 1, -1},
+            {"0", "0", 0, 0},
+            {"21903209239023190", "21903209239023190", 0, 0},
+            {"21903209239023190", "-21903209239023190", 0, 1},
+            {"-21903209239023190", "21903209239023191", -1, -1},
+            {"21903209239023190", "-21903209239023191", -1, 1},
+        };
+        big_int_str *str = NULL;
+        int cmp_flag;
+
+        printf("big_int_abs, big_int_cmp_abs & big_int_cmp tests...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        if (a == NULL || b == NULL) {
+            debug_print("error when creating big_int numbers [a] or [b]\n");
+        }
+        str = big_int_str_create(1);
+        if (str == NULL) {
+            debug_print("error when creating big_int_str string\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_str_copy_s(test[i].n1, strlen(test[i].n1), str)) {
+                debug_print("error when copying string %s to big_int_str. (i = %u)\n", test[i].n1, i);
+            }
+            if (big_int_from_str(str, 10, a)) {
+                debug_print("error when converting string %s to number [a]. (i = %u)\n", test[i].n1, i);
+            }
+            if (big_int_str_copy_s(test[i].n2, strlen(test[i].n2), str)) {
+                debug_print("error when copying string %s to big_int_str. (i = %u)\n", test[i].n2, i);
+            }
+            if (big_int_from_str(str, 10, b)) {
+                debug_print("error when converting string %s to number [b]. (i = %u)\n", test[i].n2, i);
+            }
+            big_int_cmp(a, b, &cmp_flag);
+            if (cmp_flag != test[i].cmp) {
+                debug_print("wrong comparision of numbers %s and %s. Cmp_flag = %d, expected %d (i = %u)\n",
+                    test[i].n1, test[i].n2, cmp_flag, test[i].cmp, i);
+            }
+            big_int_cmp_abs(a, b, &cmp_flag);
+            if (cmp_flag != test[i].cmp_abs) {
+                debug_print("wrong abs comparision of numbers %s and %s. Cmp_flag = %d, expected %d (i = %u)\n",
+                    test[i].n1, test[i].n2, cmp_flag, test[i].cmp, i);
+            }
+            /* manually abs [a] and [b] */
+            if (big_int_abs(a, a)) {
                 debug_print("error in abs() number %s. (i = %u)\n", test[i].n1, i);
             }
             if (big_int_abs(b, b)) {
@@ -1927,6 +3004,88 @@ void test_basic_funcs(void)
     }
     printf("\n");
 
+    /* big_int_mul() for long numbers */
+    {
+        /*
+            lengths (in bits) of multipliers. Products are checked against
+            the schoolbook multiplication of [a] by every digit of [b]
+        */
+        size_t test[][2] = {
+            {1000, 1000},
+            {2048, 2048},
+            {4096, 3000},
+            {30000, 5000},
+            {65536, 65536},
+            {100000, 80000},
+            {200000, 200000},
+        };
+        size_t i, j;
+        big_int *a = NULL, *b = NULL, *c = NULL, *d = NULL, *digit = NULL;
+        int cmp_flag;
+
+        printf("big_int_mul test for long numbers...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        c = big_int_create(1);
+        d = big_int_create(1);
+        digit = big_int_create(1);
+        if (a == NULL || b == NULL || c == NULL || d == NULL || digit == NULL) {
+            debug_print("error when creating [a], [b], [c], [d] or [digit] number\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], a) || big_int_rand(rand, test[i][1], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            if (i & 1) {
+                b->sign = MINUS;
+            }
+            if (big_int_mul(a, b, c)) {
+                debug_print("error in big_int_mul() function. (i = %u)\n", i);
+            }
+            /* d = a * b, calculated digit by digit */
+            if (big_int_from_int(0, d)) {
+                debug_print("error in big_int_from_int(). (i = %u)\n", i);
+            }
+            for (j = b->len; j-- > 0;) {
+                digit->num[0] = b->num[j];
+                if (big_int_lshift(d, BIG_INT_WORD_BITS_CNT, d)) {
+                    debug_print("error in big_int_lshift(). (i = %u)\n", i);
+                }
+                if (big_int_muladd(a, digit, d, d)) {
+                    debug_print("error in big_int_muladd(). (i = %u)\n", i);
+                }
+            }
+            d->sign = (a->sign == b->sign) ? PLUS : MINUS;
+            big_int_clear_zeros(d);
+            big_int_cmp(c, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_mul() for %u-bit and %u-bit numbers. (i = %u)\n",
+                    test[i][0], test[i][1], i);
+            }
+            /* check squaring */
+            if (big_int_mul(a, a, c)) {
+                debug_print("error in big_int_mul() function. (i = %u)\n", i);
+            }
+            if (big_int_copy(a, b)) {
+                debug_print("error in big_int_copy(). (i = %u)\n", i);
+            }
+            if (big_int_mul(a, b, d)) {
+                debug_print("error in big_int_mul() function. (i = %u)\n", i);
+            }
+            big_int_cmp(c, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_mul(a, a) for %u-bit number. (i = %u)\n", test[i][0], i);
+            }
+        }
+        big_int_destroy(digit);
+        big_int_destroy(d);
+        big_int_destroy(c);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_mul test for long numbers\n");
+    }
+    printf("\n");
+
     /* big_int_div(), big_int_mod() & big_int_div_extended() */
     {
         struct {
@@ -2018,6 +3177,242 @@ void test_basic_funcs(void)
     }
     printf("\n");
 
+    /* big_int_div_extended() for long numbers */
+    {
+        /* bit lengths of dividend and divisor */
+        size_t test[][2] = {
+            {3000, 1000},
+            {20000, 7000},
+            {40000, 39000},
+            {100000, 20000},
+            {300000, 150000},
+            {1200000, 600000},
+        };
+        size_t i;
+        big_int *a = NULL, *b = NULL, *q = NULL, *r = NULL, *d = NULL;
+        int cmp_flag;
+
+        printf("big_int_div_extended test for long numbers...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        q = big_int_create(1);
+        r = big_int_create(1);
+        d = big_int_create(1);
+        if (a == NULL || b == NULL || q == NULL || r == NULL || d == NULL) {
+            debug_print("error when creating [a], [b], [q], [r] or [d] number\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], a) || big_int_rand(rand, test[i][1], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            if (b->len == 1 && b->num[0] == 0) {
+                b->num[0] = 1;
+            }
+            if (i & 1) {
+                a->sign = MINUS;
+            }
+            if (i & 2) {
+                b->sign = MINUS;
+            }
+            if (big_int_div_extended(a, b, q, r)) {
+                debug_print("error in big_int_div_extended() function. (i = %u)\n", i);
+            }
+            /* check a = q * b + r and abs(r) < abs(b) */
+            if (big_int_muladd(q, b, r, d)) {
+                debug_print("error in big_int_muladd(). (i = %u)\n", i);
+            }
+            big_int_cmp(a, d, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_div_extended() for %u-bit and %u-bit numbers. (i = %u)\n",
+                    test[i][0], test[i][1], i);
+            }
+            big_int_cmp_abs(r, b, &cmp_flag);
+            if (cmp_flag >= 0) {
+                debug_print("wrong remainder of big_int_div_extended() for %u-bit and %u-bit numbers. (i = %u)\n",
+                    test[i][0], test[i][1], i);
+            }
+        }
+        big_int_destroy(d);
+        big_int_destroy(r);
+        big_int_destroy(q);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_div_extended test for long numbers\n");
+    }
+    printf("\n");
+
+    /* big_int_recip_create() & big_int_recip_div_extended() */
+    {
+        /* bit lengths of divisor and dividends */
+        size_t test[][2] = {
+            {1, 100},
+            {64, 1000},
+            {5000, 12000},
+            {20000, 100000},
+            {150000, 300000},
+        };
+        size_t i, j;
+        big_int *a = NULL, *b = NULL, *q = NULL, *r = NULL, *q1 = NULL, *r1 = NULL;
+        big_int_recip *ctx = NULL;
+        int cmp_flag;
+
+        printf("big_int_recip_div_extended test...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        q = big_int_create(1);
+        r = big_int_create(1);
+        q1 = big_int_create(1);
+        r1 = big_int_create(1);
+        if (a == NULL || b == NULL || q == NULL || r == NULL || q1 == NULL || r1 == NULL) {
+            debug_print("error when creating [a], [b], [q], [r], [q1] or [r1] number\n");
+        }
+        if (big_int_recip_create(a) != NULL) {
+            debug_print("big_int_recip_create() must return NULL for zero divisor\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            if (b->len == 1 && b->num[0] == 0) {
+                b->num[0] = 1;
+            }
+            if (i & 1) {
+                b->sign = MINUS;
+            }
+            ctx = big_int_recip_create(b);
+            if (ctx == NULL) {
+                debug_print("error in big_int_recip_create(). (i = %u)\n", i);
+                continue;
+            }
+            /* the same context is used for several dividends */
+            for (j = 0; j < 4; j++) {
+                if (big_int_rand(rand, test[i][1] >> j, a)) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                if (j & 1) {
+                    a->sign = MINUS;
+                }
+                if (big_int_div_extended(a, b, q, r)) {
+                    debug_print("error in big_int_div_extended(). (i = %u, j = %u)\n", i, j);
+                }
+                if (big_int_recip_div_extended(ctx, a, q1, r1)) {
+                    debug_print("error in big_int_recip_div_extended(). (i = %u, j = %u)\n", i, j);
+                }
+                big_int_cmp(q, q1, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong quotient of big_int_recip_div_extended() for %u-bit and %u-bit numbers. (i = %u, j = %u)\n",
+                        test[i][1] >> j, test[i][0], i, j);
+                }
+                big_int_cmp(r, r1, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong reminder of big_int_recip_div_extended() for %u-bit and %u-bit numbers. (i = %u, j = %u)\n",
+                        test[i][1] >> j, test[i][0], i, j);
+                }
+            }
+            big_int_recip_destroy(ctx);
+        }
+        big_int_destroy(r1);
+        big_int_destroy(q1);
+        big_int_destroy(r);
+        big_int_destroy(q);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_recip_div_extended test\n");
+    }
+    printf("\n");
+
+    /* big_int_recip_div(), big_int_recip_mod() & big_int_recip_absmod() */
+    {
+        /* bit lengths of divisor and dividends */
+        size_t test[][2] = {
+            {3, 50},
+            {8, 200},
+            {31, 31},
+            {64, 640},
+            {97, 2000},
+            {190, 3000},
+            {1000, 2500},
+        };
+        size_t i, j;
+        big_int *a = NULL, *b = NULL, *r = NULL, *r1 = NULL;
+        big_int_recip *ctx = NULL;
+        int cmp_flag;
+
+        printf("big_int_recip_div, big_int_recip_mod & big_int_recip_absmod test...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        r = big_int_create(1);
+        r1 = big_int_create(1);
+        if (a == NULL || b == NULL || r == NULL || r1 == NULL) {
+            debug_print("error when creating [a], [b], [r] or [r1] number\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], b)) {
+                debug_print("error in big_int_rand(). (i = %u)\n", i);
+            }
+            if (b->len == 1 && b->num[0] == 0) {
+                b->num[0] = 1;
+            }
+            if (i & 1) {
+                b->sign = MINUS;
+            }
+            ctx = big_int_recip_create(b);
+            if (ctx == NULL) {
+                debug_print("error in big_int_recip_create(). (i = %u)\n", i);
+                continue;
+            }
+            for (j = 0; j < 8; j++) {
+                if (big_int_rand(rand, test[i][1] >> (j / 2), a)) {
+                    debug_print("error in big_int_rand(). (i = %u, j = %u)\n", i, j);
+                }
+                if ((j & 1) && (a->len > 1 || a->num[0] != 0)) {
+                    a->sign = MINUS;
+                }
+
+                if (big_int_div(a, b, r)) {
+                    debug_print("error in big_int_div(). (i = %u, j = %u)\n", i, j);
+                }
+                if (big_int_recip_div(ctx, a, r1)) {
+                    debug_print("error in big_int_recip_div(). (i = %u, j = %u)\n", i, j);
+                }
+                big_int_cmp(r, r1, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong result of big_int_recip_div(). (i = %u, j = %u)\n", i, j);
+                }
+
+                if (big_int_mod(a, b, r)) {
+                    debug_print("error in big_int_mod(). (i = %u, j = %u)\n", i, j);
+                }
+                if (big_int_recip_mod(ctx, a, r1)) {
+                    debug_print("error in big_int_recip_mod(). (i = %u, j = %u)\n", i, j);
+                }
+                big_int_cmp(r, r1, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong result of big_int_recip_mod(). (i = %u, j = %u)\n", i, j);
+                }
+
+                if (big_int_absmod(a, b, r)) {
+                    debug_print("error in big_int_absmod(). (i = %u, j = %u)\n", i, j);
+                }
+                /* result can be saved in the dividend */
+                if (big_int_recip_absmod(ctx, a, a)) {
+                    debug_print("error in big_int_recip_absmod(). (i = %u, j = %u)\n", i, j);
+                }
+                big_int_cmp(r, a, &cmp_flag);
+                if (cmp_flag) {
+                    debug_print("wrong result of big_int_recip_absmod(). (i = %u, j = %u)\n", i, j);
+                }
+            }
+            big_int_recip_destroy(ctx);
+        }
+        big_int_destroy(r1);
+        big_int_destroy(r);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_recip_div, big_int_recip_mod & big_int_recip_absmod test\n");
+    }
+    printf("\n");
+
     /* big_int_muladd() */
     {
         /* result = n3 + n1 * n2 */
@@ -2091,6 +3486,181 @@ void test_basic_funcs(void)
     }
     printf("\n");
 
+    /* big_int_add_word(), big_int_mul_word(), big_int_divrem_word() & big_int_mod_word() */
+    {
+        struct {
+            char *n;
+            big_int_word w;
+            char *add; /* n + w */
+            char *mul; /* n * w */
+            char *div; /* n / w */
+            big_int_word rem; /* abs(n) % w */
+            big_int_word mod; /* n (mod w) */
+        } test[] = {
+            {"0", 7, "7", "0", "0", 0, 0},
+            {"-5", 7, "2", "-35", "0", 5, 2},
+            {"-7", 7, "0", "-49", "-1", 0, 0},
+            {"123456789012345678901234567890", 255, "123456789012345678901234568145", "31481481198148148119814814811950", "484144270636649721181312030", 240, 240},
+            {"-123456789012345678901234567890", 200, "-123456789012345678901234567690", "-24691357802469135780246913578000", "-617283945061728394506172839", 90, 110},
+            {"18446744073709551616", 1, "18446744073709551617", "18446744073709551616", "18446744073709551616", 0, 0},
+            {"-340282366920938463463374607431768211455", 3, "-340282366920938463463374607431768211452", "-1020847100762815390390123822295304634365", "-113427455640312821154458202477256070485", 0, 0},
+        };
+        size_t i;
+        big_int *a = NULL, *b = NULL;
+        big_int_str *str = NULL;
+        big_int_word r;
+
+        printf("big_int_add_word, big_int_mul_word, big_int_divrem_word & big_int_mod_word test...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        if (a == NULL || b == NULL) {
+            debug_print("error when creating [a] or [b] number\n");
+        }
+        str = big_int_str_create(1);
+        if (str == NULL) {
+            debug_print("error when creating big_int_str [str]\n");
+        }
+        if (big_int_divrem_word(a, 0, b, &r) != 1 || big_int_mod_word(a, 0, &r) != 1) {
+            debug_print("division by zero digit must return 1\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_str_copy_s(test[i].n, strlen(test[i].n), str)) {
+                debug_print("error when copying string %s to big_int_str variable [str]. (i = %u)\n", test[i].n, i);
+            }
+            if (big_int_from_str(str, 10, a)) {
+                debug_print("error when converting string %s to number [a]. (i = %u)\n", test[i].n, i);
+            }
+
+            if (big_int_add_word(a, test[i].w, b) || big_int_to_str(b, 10, str)) {
+                debug_print("error in big_int_add_word(). (i = %u)\n", i);
+            }
+            if (strcmp(str->str, test[i].add)) {
+                debug_print("wrong result of big_int_add_word() = %s. Expected %s. (i = %u)\n", str->str, test[i].add, i);
+            }
+
+            if (big_int_mul_word(a, test[i].w, b) || big_int_to_str(b, 10, str)) {
+                debug_print("error in big_int_mul_word(). (i = %u)\n", i);
+            }
+            if (strcmp(str->str, test[i].mul)) {
+                debug_print("wrong result of big_int_mul_word() = %s. Expected %s. (i = %u)\n", str->str, test[i].mul, i);
+            }
+
+            if (big_int_mod_word(a, test[i].w, &r)) {
+                debug_print("error in big_int_mod_word(). (i = %u)\n", i);
+            }
+            if (r != test[i].mod) {
+                debug_print("wrong result of big_int_mod_word(). (i = %u)\n", i);
+            }
+
+            /* result is saved to the dividend */
+            if (big_int_divrem_word(a, test[i].w, a, &r) || big_int_to_str(a, 10, str)) {
+                debug_print("error in big_int_divrem_word(). (i = %u)\n", i);
+            }
+            if (strcmp(str->str, test[i].div) || r != test[i].rem) {
+                debug_print("wrong result of big_int_divrem_word() = %s. Expected %s. (i = %u)\n", str->str, test[i].div, i);
+            }
+        }
+        big_int_str_destroy(str);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_add_word, big_int_mul_word, big_int_divrem_word & big_int_mod_word test\n");
+    }
+    printf("\n");
+
+    /* big_int_divexact(), big_int_divisible_p() & big_int_divisible_2exp() */
+    {
+        /* bit lengths of divisor and quotient, power of 2 in divisor */
+        size_t test[][3] = {
+            {3, 50, 0},
+            {8, 200, 5},
+            {64, 64, 1},
+            {100, 1000, 0},
+            {1000, 100, 33},
+            {2500, 3000, 64},
+            {9000, 9000, 0},
+        };
+        size_t i, n_bits;
+        big_int *a = NULL, *b = NULL, *q = NULL, *r = NULL;
+        int cmp_flag, is_divisible, is_zero;
+
+        printf("big_int_divexact, big_int_divisible_p & big_int_divisible_2exp test...\n");
+        a = big_int_create(1);
+        b = big_int_create(1);
+        q = big_int_create(1);
+        r = big_int_create(1);
+        if (a == NULL || b == NULL || q == NULL || r == NULL) {
+            debug_print("error when creating [a], [b], [q] or [r] number\n");
+        }
+        if (big_int_divexact(a, b, q) != 1 || big_int_divisible_p(a, b, &is_divisible) != 1) {
+            debug_print("division by zero must return 1\n");
+        }
+        for (i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+            if (big_int_rand(rand, test[i][0], b) || big_int_set_bit(b, 0, b) ||
+                big_int_lshift(b, (int) test[i][2], b)) {
+                debug_print("error when creating divisor [b]. (i = %u)\n", i);
+            }
+            if (big_int_rand(rand, test[i][1], q) || big_int_set_bit(q, 0, q)) {
+                debug_print("error when creating quotient [q]. (i = %u)\n", i);
+            }
+            if (i & 1) {
+                b->sign = MINUS;
+            }
+            if (i & 2) {
+                q->sign = MINUS;
+            }
+            if (big_int_mul(q, b, a)) {
+                debug_print("error in big_int_mul(). (i = %u)\n", i);
+            }
+
+            /* result can be saved in the dividend */
+            if (big_int_copy(a, r) || big_int_divexact(r, b, r)) {
+                debug_print("error in big_int_divexact(). (i = %u)\n", i);
+            }
+            big_int_cmp(r, q, &cmp_flag);
+            if (cmp_flag) {
+                debug_print("wrong result of big_int_divexact(). (i = %u)\n", i);
+            }
+
+            if (big_int_divisible_p(a, b, &is_divisible)) {
+                debug_print("error in big_int_divisible_p(). (i = %u)\n", i);
+            }
+            if (!is_divisible) {
+                debug_print("wrong result of big_int_divisible_p() for divisible numbers. (i = %u)\n", i);
+            }
+            big_int_divisible_2exp(a, test[i][2], &is_divisible);
+            if (!is_divisible) {
+                debug_print("wrong result of big_int_divisible_2exp() for divisible numbers. (i = %u)\n", i);
+            }
+            big_int_divisible_2exp(a, test[i][2] + 1, &is_divisible);
+            if (is_divisible) {
+                debug_print("wrong result of big_int_divisible_2exp() for indivisible numbers. (i = %u)\n", i);
+            }
+
+            /* a + 2^n_bits * b / 4 is divisible by [b] only for short [b] */
+            n_bits = (test[i][1] > 2) ? test[i][1] - 2 : 0;
+            if (big_int_lshift(b, (int) n_bits, r) || big_int_rshift(r, 2, r) ||
+                big_int_add(a, r, a)) {
+                debug_print("error when creating dividend [a]. (i = %u)\n", i);
+            }
+            if (big_int_mod(a, b, r)) {
+                debug_print("error in big_int_mod(). (i = %u)\n", i);
+            }
+            big_int_is_zero(r, &is_zero);
+            if (big_int_divisible_p(a, b, &is_divisible)) {
+                debug_print("error in big_int_divisible_p(). (i = %u)\n", i);
+            }
+            if (is_divisible != is_zero) {
+                debug_print("wrong result of big_int_divisible_p(). (i = %u)\n", i);
+            }
+        }
+        big_int_destroy(r);
+        big_int_destroy(q);
+        big_int_destroy(b);
+        big_int_destroy(a);
+        printf("end of big_int_divexact, big_int_divisible_p & big_int_divisible_2exp test\n");
+    }
+    printf("\n");
+
 }
 
 /**
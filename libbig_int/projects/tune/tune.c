@@ -0,0 +1,493 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+/*
+    Tuning of thresholds for low-level functions.
+
+    Measures time of multiplication, squaring and division algorithms
+    for different lengths of numbers and finds the lengths, where
+    the next algorithm becomes faster than the previous one.
+    The library must be built with BIG_INT_TUNE macro (see gcc/tune.pl).
+    Found thresholds are written into big_int_tuning.h, which should
+    replace include/big_int_tuning.h before the library is built.
+
+    Usage:
+        tune [output_file]
+    Default output file is ../../../include/big_int_tuning.h
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "big_int_full.h" /* include all BIG_INT headers */
+#include "low_level_funcs.h"
+
+/* minimal time of one measurement in clock ticks */
+#define MIN_MEASURE_TIME (CLOCKS_PER_SEC / 20)
+
+/* number of measurements. The best time is taken */
+#define MEASURES_CNT 3
+
+#if !defined(BIG_INT_TUNE)
+#error tune program requires the library, built with BIG_INT_TUNE macro
+#endif
+
+/*
+    Thresholds of division and NTT algorithms, which are used by the library,
+    built with BIG_INT_TUNE macro (see low_level_funcs.h).
+    NTT is out of reach until its thresholds are found, so Toom-Cook
+    algorithms are measured without NTT sub-products
+*/
+size_t low_level_tune_bz_div_threshold = 64;
+size_t low_level_tune_newton_div_threshold = 65536;
+size_t low_level_tune_ntt_mul_threshold = (size_t) -1;
+size_t low_level_tune_ntt_sqr_threshold = (size_t) -1;
+
+typedef void (*mul_func)(const big_int_word *a, const big_int_word *a_end,
+                         const big_int_word *b, const big_int_word *b_end,
+                         big_int_word *c, big_int_word *tmp);
+
+typedef size_t (*tmp_len_func)(size_t a_len, size_t b_len);
+
+/*
+    algorithm of multiplication or squaring
+*/
+typedef struct {
+    const char *name;
+    mul_func func;
+    tmp_len_func tmp_len;
+    size_t min_len; /* minimal length of numbers, supported by algorithm */
+} algorithm;
+
+/*
+    found threshold
+*/
+typedef struct {
+    const char *macro_name;
+    size_t value;
+} threshold;
+
+/*
+    wrappers, which give the same interface to all algorithms
+*/
+static void mul_schoolbook(const big_int_word *a, const big_int_word *a_end,
+                           const big_int_word *b, const big_int_word *b_end,
+                           big_int_word *c, big_int_word *tmp)
+{
+    (void) tmp;
+    low_level_mul(a, a_end, b, b_end, c);
+}
+
+static size_t zero_tmp_len(size_t a_len, size_t b_len)
+{
+    (void) a_len;
+    (void) b_len;
+    return 0;
+}
+
+static void sqr_schoolbook(const big_int_word *a, const big_int_word *a_end,
+                           const big_int_word *b, const big_int_word *b_end,
+                           big_int_word *c, big_int_word *tmp)
+{
+    (void) b;
+    (void) b_end;
+    (void) tmp;
+    low_level_sqr(a, a_end, c);
+}
+
+#define SQR_WRAPPER(name) \
+    static void sqr_##name(const big_int_word *a, const big_int_word *a_end, \
+                           const big_int_word *b, const big_int_word *b_end, \
+                           big_int_word *c, big_int_word *tmp) \
+    { \
+        (void) b; \
+        (void) b_end; \
+        low_level_sqr_##name(a, a_end, c, tmp); \
+    } \
+    static size_t sqr_##name##_tmp_len(size_t a_len, size_t b_len) \
+    { \
+        (void) b_len; \
+        return low_level_sqr_##name##_tmp_len(a_len); \
+    }
+
+SQR_WRAPPER(karatsuba)
+SQR_WRAPPER(toom3)
+SQR_WRAPPER(toom4)
+SQR_WRAPPER(ntt)
+#if defined(BIG_INT_X86_64_IFMA)
+SQR_WRAPPER(ifma)
+#endif
+
+/*
+    Division wrappers divide number with length 2 * len digits by
+    number with length [len] digits, where len = length(a).
+    The divisor is [b] with the highest bit set to 1. The dividend is
+    [a] in lower digits and [b] with the highest bit cleared in
+    higher digits, so its higher digits are less than the divisor.
+    Layout of [tmp]:
+        dividend - [2 * len] digits
+        divisor - [len] digits
+        the rest is used by division algorithm
+*/
+static void div_prepare(const big_int_word *a, const big_int_word *b, size_t len,
+                        big_int_word *tmp)
+{
+    big_int_word top_bit;
+
+    top_bit = (big_int_word) 1 << (BIG_INT_WORD_BITS_CNT - 1);
+    memcpy(tmp, a, BIG_INT_WORD_BYTES_CNT * len);
+    memcpy(tmp + len, b, BIG_INT_WORD_BYTES_CNT * len);
+    memcpy(tmp + 2 * len, b, BIG_INT_WORD_BYTES_CNT * len);
+    tmp[2 * len - 1] &= ~top_bit;
+    tmp[3 * len - 1] |= top_bit;
+}
+
+static void div_schoolbook(const big_int_word *a, const big_int_word *a_end,
+                           const big_int_word *b, const big_int_word *b_end,
+                           big_int_word *c, big_int_word *tmp)
+{
+    size_t len = a_end - a;
+
+    (void) b_end;
+    div_prepare(a, b, len, tmp);
+    low_level_div(tmp, tmp + 2 * len, tmp + 2 * len, tmp + 3 * len, c, c + len);
+}
+
+static size_t div_schoolbook_tmp_len(size_t a_len, size_t b_len)
+{
+    (void) b_len;
+    return 3 * a_len;
+}
+
+/*
+    Burnikel-Ziegler division with threshold [len], so only the
+    first level of recursion is used for numbers with [len] digits
+*/
+static void div_bz(const big_int_word *a, const big_int_word *a_end,
+                   const big_int_word *b, const big_int_word *b_end,
+                   big_int_word *c, big_int_word *tmp)
+{
+    size_t len = a_end - a;
+
+    (void) b_end;
+    low_level_tune_bz_div_threshold = len;
+    div_prepare(a, b, len, tmp);
+    low_level_div_bz(tmp, tmp + 2 * len, tmp + 2 * len, tmp + 3 * len, c, c + len, tmp + 3 * len);
+}
+
+static size_t div_bz_tmp_len(size_t a_len, size_t b_len)
+{
+    (void) b_len;
+    low_level_tune_bz_div_threshold = a_len;
+    return 3 * a_len + low_level_div_bz_tmp_len(2 * a_len, a_len);
+}
+
+/*
+    low_level_fast_div() with Burnikel-Ziegler threshold, found by tune
+    program, and without Newton's division for numbers with [len] digits
+*/
+static void div_fast(const big_int_word *a, const big_int_word *a_end,
+                     const big_int_word *b, const big_int_word *b_end,
+                     big_int_word *c, big_int_word *tmp)
+{
+    size_t len = a_end - a;
+
+    (void) b_end;
+    low_level_tune_newton_div_threshold = len + 1;
+    div_prepare(a, b, len, tmp);
+    low_level_fast_div(tmp, tmp + 2 * len, tmp + 2 * len, tmp + 3 * len, c, c + len, tmp + 3 * len);
+}
+
+static size_t div_fast_tmp_len(size_t a_len, size_t b_len)
+{
+    (void) b_len;
+    low_level_tune_newton_div_threshold = a_len + 1;
+    return 3 * a_len + low_level_fast_div_tmp_len(2 * a_len, a_len);
+}
+
+/*
+    low_level_fast_div() with Newton's division for numbers with [len] digits
+*/
+static void div_newton(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c, big_int_word *tmp)
+{
+    size_t len = a_end - a;
+
+    (void) b_end;
+    low_level_tune_newton_div_threshold = len;
+    div_prepare(a, b, len, tmp);
+    low_level_fast_div(tmp, tmp + 2 * len, tmp + 2 * len, tmp + 3 * len, c, c + len, tmp + 3 * len);
+}
+
+static size_t div_newton_tmp_len(size_t a_len, size_t b_len)
+{
+    (void) b_len;
+    low_level_tune_newton_div_threshold = a_len;
+    return 3 * a_len + low_level_fast_div_tmp_len(2 * a_len, a_len);
+}
+
+static const algorithm mul_schoolbook_alg = {"schoolbook", mul_schoolbook, zero_tmp_len, 1};
+static const algorithm mul_karatsuba_alg = {"karatsuba", low_level_mul_karatsuba, low_level_mul_karatsuba_tmp_len, 2};
+static const algorithm mul_toom3_alg = {"toom3", low_level_mul_toom3, low_level_mul_toom3_tmp_len, 3};
+static const algorithm mul_toom4_alg = {"toom4", low_level_mul_toom4, low_level_mul_toom4_tmp_len, 4};
+static const algorithm mul_ntt_alg = {"ntt", low_level_mul_ntt, low_level_mul_ntt_tmp_len, 1};
+static const algorithm sqr_schoolbook_alg = {"schoolbook", sqr_schoolbook, zero_tmp_len, 1};
+static const algorithm sqr_karatsuba_alg = {"karatsuba", sqr_karatsuba, sqr_karatsuba_tmp_len, 2};
+static const algorithm sqr_toom3_alg = {"toom3", sqr_toom3, sqr_toom3_tmp_len, 5};
+static const algorithm sqr_toom4_alg = {"toom4", sqr_toom4, sqr_toom4_tmp_len, 10};
+static const algorithm sqr_ntt_alg = {"ntt", sqr_ntt, sqr_ntt_tmp_len, 1};
+static const algorithm div_schoolbook_alg = {"schoolbook", div_schoolbook, div_schoolbook_tmp_len, 1};
+static const algorithm div_bz_alg = {"burnikel-ziegler", div_bz, div_bz_tmp_len, 2};
+static const algorithm div_fast_alg = {"burnikel-ziegler", div_fast, div_fast_tmp_len, 2};
+static const algorithm div_newton_alg = {"newton", div_newton, div_newton_tmp_len, 2};
+#if defined(BIG_INT_X86_64_IFMA)
+static const algorithm mul_ifma_alg = {"ifma", low_level_mul_ifma, low_level_mul_ifma_tmp_len, 1};
+static const algorithm sqr_ifma_alg = {"ifma", sqr_ifma, sqr_ifma_tmp_len, 1};
+#endif
+
+/**
+    Returns time (in seconds) of one call of [alg] for numbers
+    with [len] digits. Returns negative value on memory error.
+*/
+static double measure(const algorithm *alg, size_t len)
+{
+    big_int_word *a, *b, *c, *tmp;
+    size_t i, tmp_len;
+    long reps, n;
+    clock_t t;
+    double best_time, cur_time;
+    int k;
+
+    tmp_len = alg->tmp_len(len, len);
+    a = (big_int_word *) malloc(BIG_INT_WORD_BYTES_CNT * len);
+    b = (big_int_word *) malloc(BIG_INT_WORD_BYTES_CNT * len);
+    c = (big_int_word *) malloc(BIG_INT_WORD_BYTES_CNT * 2 * len);
+    tmp = (big_int_word *) malloc(BIG_INT_WORD_BYTES_CNT * (tmp_len + 1));
+    if (a == NULL || b == NULL || c == NULL || tmp == NULL) {
+        free(a);
+        free(b);
+        free(c);
+        free(tmp);
+        return -1.0;
+    }
+    for (i = 0; i < len * BIG_INT_WORD_BYTES_CNT; i++) {
+        ((unsigned char *) a)[i] = (unsigned char) rand();
+        ((unsigned char *) b)[i] = (unsigned char) rand();
+    }
+
+    /* find number of repetitions, which takes at least MIN_MEASURE_TIME */
+    reps = 1;
+    while (1) {
+        t = clock();
+        for (n = 0; n < reps; n++) {
+            alg->func(a, a + len, b, b + len, c, tmp);
+        }
+        t = clock() - t;
+        if (t >= MIN_MEASURE_TIME) {
+            break;
+        }
+        reps *= 2;
+    }
+    best_time = (double) t / reps;
+
+    for (k = 1; k < MEASURES_CNT; k++) {
+        t = clock();
+        for (n = 0; n < reps; n++) {
+            alg->func(a, a + len, b, b + len, c, tmp);
+        }
+        t = clock() - t;
+        cur_time = (double) t / reps;
+        if (cur_time < best_time) {
+            best_time = cur_time;
+        }
+    }
+
+    free(a);
+    free(b);
+    free(c);
+    free(tmp);
+
+    return best_time / CLOCKS_PER_SEC;
+}
+
+/**
+    Returns the smallest length from [min_len] to [max_len], starting
+    from which algorithm [alg2] is faster than [alg1] for two
+    consequent lengths. If [alg2] is always slower, returns [max_len].
+*/
+static size_t find_threshold(const algorithm *alg1, const algorithm *alg2,
+                             size_t min_len, size_t max_len)
+{
+    size_t len, prev_len;
+    double t1, t2;
+    int wins_cnt;
+
+    if (min_len < alg1->min_len) {
+        min_len = alg1->min_len;
+    }
+    if (min_len < alg2->min_len) {
+        min_len = alg2->min_len;
+    }
+    printf("%s vs %s:\n", alg1->name, alg2->name);
+
+    wins_cnt = 0;
+    prev_len = min_len;
+    len = min_len;
+    while (len <= max_len) {
+        t1 = measure(alg1, len);
+        t2 = measure(alg2, len);
+        if (t1 < 0 || t2 < 0) {
+            printf("    cannot allocate memory for length %u\n", (unsigned int) len);
+            break;
+        }
+        printf("    len=%u: %.3f us vs %.3f us\n", (unsigned int) len, t1 * 1e6, t2 * 1e6);
+        if (t2 < t1) {
+            if (++wins_cnt == 2) {
+                return prev_len;
+            }
+        } else {
+            wins_cnt = 0;
+        }
+        prev_len = len;
+        /* lengths grow by 1/8 */
+        len += len / 8 + 1;
+    }
+    return (wins_cnt == 1) ? prev_len : max_len;
+}
+
+/**
+    Returns maximum of [a] and [b]
+*/
+static size_t max_len(size_t a, size_t b)
+{
+    return (a > b) ? a : b;
+}
+
+int main(int argc, char **argv)
+{
+    const char *file_name = "../../../include/big_int_tuning.h";
+    threshold thresholds[16];
+    size_t thresholds_cnt = 0, i, len;
+    FILE *f;
+    int cpu_features;
+
+    if (argc > 1) {
+        file_name = argv[1];
+    }
+    srand((unsigned int) time(NULL));
+
+    /*
+        Tune thresholds of algorithms, which do not use AVX-512 IFMA kernel.
+        Every search starts from the previous threshold (or just after it,
+        if there must be a gap), so thresholds are ordered as
+        low_level_funcs.h requires. Algorithms call
+        low_level_fast_mul() with thresholds, which are used for building
+        of this program, so the second run of tune with the new
+        big_int_tuning.h can give more precise values.
+    */
+    cpu_features = low_level_cpu_features;
+    low_level_cpu_features &= ~LOW_LEVEL_CPU_IFMA;
+
+    len = find_threshold(&mul_schoolbook_alg, &mul_karatsuba_alg, 4, 512);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_KARATSUBA_MUL_THRESHOLD";
+    thresholds[thresholds_cnt++].value = max_len(len, 4);
+    len = find_threshold(&mul_karatsuba_alg, &mul_toom3_alg, len, 4096);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_TOOM3_MUL_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    len = find_threshold(&mul_toom3_alg, &mul_toom4_alg, len, 8192);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_TOOM4_MUL_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    len = find_threshold(&mul_toom4_alg, &mul_ntt_alg, len, 262144);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_NTT_MUL_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    low_level_tune_ntt_mul_threshold = len;
+
+    len = find_threshold(&sqr_schoolbook_alg, &sqr_karatsuba_alg, 4, 512);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_KARATSUBA_SQR_THRESHOLD";
+    thresholds[thresholds_cnt++].value = max_len(len, 4);
+    len = find_threshold(&sqr_karatsuba_alg, &sqr_toom3_alg, len, 4096);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_TOOM3_SQR_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    len = find_threshold(&sqr_toom3_alg, &sqr_toom4_alg, len, 8192);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_TOOM4_SQR_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    len = find_threshold(&sqr_toom4_alg, &sqr_ntt_alg, len + 1, 262144);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_NTT_SQR_THRESHOLD";
+    thresholds[thresholds_cnt++].value = len;
+    low_level_tune_ntt_sqr_threshold = len;
+
+    low_level_cpu_features = cpu_features;
+
+    /* division uses multiplication, so it is tuned with all kernels enabled */
+    len = find_threshold(&div_schoolbook_alg, &div_bz_alg, 4, 4096);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_BZ_DIV_THRESHOLD";
+    thresholds[thresholds_cnt++].value = max_len(len, 2);
+    low_level_tune_bz_div_threshold = max_len(len, 2);
+
+    len = find_threshold(&div_fast_alg, &div_newton_alg, 256, (size_t) 1 << 17);
+    thresholds[thresholds_cnt].macro_name = "BIG_INT_NEWTON_DIV_THRESHOLD";
+    thresholds[thresholds_cnt++].value = max_len(len, low_level_tune_bz_div_threshold);
+
+#if defined(BIG_INT_X86_64_IFMA)
+    /*
+        Tune range of lengths for AVX-512 IFMA kernel. The upper bound
+        cannot be greater than BIG_INT_IFMA_MAX_LEN, which is used
+        for building of this program.
+    */
+    if (low_level_cpu_features & LOW_LEVEL_CPU_IFMA) {
+        size_t ifma_min_len, ifma_max_len;
+
+        ifma_min_len = find_threshold(&mul_schoolbook_alg, &mul_ifma_alg, 4, BIG_INT_IFMA_MAX_LEN);
+        ifma_max_len = find_threshold(&mul_ifma_alg, &mul_karatsuba_alg, ifma_min_len, BIG_INT_IFMA_MAX_LEN);
+        thresholds[thresholds_cnt].macro_name = "BIG_INT_IFMA_MIN_LEN";
+        thresholds[thresholds_cnt++].value = ifma_min_len;
+        thresholds[thresholds_cnt].macro_name = "BIG_INT_IFMA_MAX_LEN";
+        thresholds[thresholds_cnt++].value = ifma_max_len;
+        /* squaring uses the same range. Show its timings for reference */
+        find_threshold(&sqr_schoolbook_alg, &sqr_ifma_alg, 4, BIG_INT_IFMA_MAX_LEN);
+    }
+#endif
+
+    f = fopen(file_name, "w");
+    if (f == NULL) {
+        printf("cannot open file [%s] for writing\n", file_name);
+        return 1;
+    }
+    fprintf(f, "/**\n");
+    fprintf(f, "    Tuned thresholds for choosing algorithms in low-level functions.\n\n");
+    fprintf(f, "    This file is generated by tune program (see projects/tune)\n");
+    fprintf(f, "    for BIG_INT_DIGIT_SIZE = %d. Thresholds are measured in digits.\n", BIG_INT_DIGIT_SIZE);
+    fprintf(f, "    Macros, which are not defined here, get default values\n");
+    fprintf(f, "    in low_level_funcs.h.\n");
+    fprintf(f, "*/\n");
+    fprintf(f, "#ifndef BIG_INT_TUNING_H\n");
+    fprintf(f, "#define BIG_INT_TUNING_H\n\n");
+    fprintf(f, "#if (BIG_INT_DIGIT_SIZE == %d)\n", BIG_INT_DIGIT_SIZE);
+    for (i = 0; i < thresholds_cnt; i++) {
+        fprintf(f, "\n#if !defined(%s)\n", thresholds[i].macro_name);
+        fprintf(f, "#define %s %u\n", thresholds[i].macro_name, (unsigned int) thresholds[i].value);
+        fprintf(f, "#endif\n");
+    }
+    fprintf(f, "\n#endif /* end of if (BIG_INT_DIGIT_SIZE == %d) */\n\n", BIG_INT_DIGIT_SIZE);
+    fprintf(f, "#endif\n");
+    fclose(f);
+
+    printf("\nthresholds are written into [%s]:\n", file_name);
+    for (i = 0; i < thresholds_cnt; i++) {
+        printf("    %s = %u\n", thresholds[i].macro_name, (unsigned int) thresholds[i].value);
+    }
+
+    return 0;
+}
@@ -0,0 +1,484 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h> /* for assert() */
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+#include "memory_manager.h"
+#include "service_funcs.h"
+#include "num_buffer.h"
+#include "basic_funcs.h"
+#include "bitset_funcs.h"
+#include "modular_arithmetic.h"
+#include "barrett.h"
+
+/**
+    Creates Barrett context for [modulus].
+    Sign of [modulus] is ignored.
+
+    Returns pointer to created context.
+    On error returns NULL pointer.
+
+    Restrictions:
+        1) [modulus] cannot be zero
+*/
+big_int_barrett * big_int_barrett_create(const big_int *modulus)
+{
+    big_int_barrett *ctx;
+    big_int *m = NULL, *mu = NULL;
+    size_t n_bits;
+
+    assert(modulus != NULL);
+
+    if (modulus->len == 1 && modulus->num[0] == 0) {
+        return NULL;
+    }
+
+    /* B^(2k) = 2^(2 * BIG_INT_WORD_BITS_CNT * length(modulus)) */
+    n_bits = 2 * BIG_INT_WORD_BITS_CNT * modulus->len;
+    if (n_bits > (size_t) (~0u >> 1)) {
+        return NULL;
+    }
+
+    ctx = (big_int_barrett *) bi_malloc(sizeof(big_int_barrett));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    m = big_int_dup(modulus);
+    mu = big_int_create(modulus->len * 2 + 1);
+    if (m == NULL || mu == NULL) {
+        goto error;
+    }
+    m->sign = PLUS;
+    if (big_int_from_int(1, mu)) {
+        goto error;
+    }
+    if (big_int_lshift(mu, (int) n_bits, mu)) {
+        goto error;
+    }
+    if (big_int_div(mu, m, mu)) {
+        goto error;
+    }
+    assert(mu->len == m->len + 1 || mu->len == m->len + 2);
+    ctx->modulus = m;
+    ctx->mu = mu;
+
+    return ctx;
+
+error:
+    big_int_destroy(mu);
+    big_int_destroy(m);
+    bi_free(ctx);
+    return NULL;
+}
+
+/**
+    Frees memory, allocated for Barrett context [ctx]
+*/
+void big_int_barrett_destroy(big_int_barrett *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    big_int_destroy(ctx->mu);
+    big_int_destroy(ctx->modulus);
+    bi_free(ctx);
+}
+
+/**
+    Calculates
+        answer = a (mod modulus)
+    Result is the same as result of big_int_absmod().
+    If length(a) is greater than 2 * length(modulus), then
+    big_int_absmod() is used.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+int big_int_barrett_reduce(const big_int_barrett *ctx, const big_int *a, big_int *answer)
+{
+    const big_int *m;
+    big_int_word *x, *tmp;
+    size_t m_len, mu_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    m = ctx->modulus;
+    m_len = m->len;
+    mu_len = ctx->mu->len;
+    if (a->len > 2 * m_len) {
+        return big_int_absmod(a, m, answer) ? 1 : 0;
+    }
+
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (2 * m_len + low_level_barrett_reduce_tmp_len(m_len, mu_len)));
+    if (x == NULL) {
+        return 2;
+    }
+    tmp = x + 2 * m_len;
+    big_int_copy_to_buffer(a, x, 2 * m_len);
+    low_level_barrett_reduce(x, m->num, m_len, ctx->mu->num, mu_len, x, tmp);
+    if (a->sign == MINUS) {
+        /* x = modulus - x for negative [a], if x != 0 */
+        memset(tmp, 0, BIG_INT_WORD_BYTES_CNT * m_len);
+        if (low_level_cmp(x, tmp, m_len) != 0) {
+            memcpy(tmp, m->num, BIG_INT_WORD_BYTES_CNT * m_len);
+            low_level_subfrom(tmp, tmp + m_len, x, x + m_len);
+            memcpy(x, tmp, BIG_INT_WORD_BYTES_CNT * m_len);
+        }
+    }
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(x);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * b (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] or [b] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_barrett_mul(const big_int_barrett *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    big_int_word *aa, *bb, *tmp;
+    size_t m_len, mu_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus) || !big_int_is_reduced(b, ctx->modulus)) {
+        return 1;
+    }
+
+    m_len = ctx->modulus->len;
+    mu_len = ctx->mu->len;
+    aa = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (2 * m_len + low_level_barrett_mul_tmp_len(m_len, mu_len)));
+    if (aa == NULL) {
+        return 2;
+    }
+    bb = aa + m_len;
+    tmp = bb + m_len;
+    big_int_copy_to_buffer(a, aa, m_len);
+    if (a == b) {
+        bb = aa;
+    } else {
+        big_int_copy_to_buffer(b, bb, m_len);
+    }
+    low_level_barrett_mul(aa, bb, ctx->modulus->num, m_len, ctx->mu->num, mu_len, aa, tmp);
+    if (big_int_set_from_buffer(aa, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(aa);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * a (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_barrett_sqr(const big_int_barrett *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return big_int_barrett_mul(ctx, a, a, answer);
+}
+
+/**
+    Calculates
+        answer = pow(a, abs(b)) (mod modulus)
+    Sliding-window exponentiation is used, see low_level_pow_window().
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_barrett_pow(const big_int_barrett *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    const big_int_word *m, *mu;
+    big_int_word *x, *table, *tmp;
+    big_int_word window;
+    unsigned int n_bits;
+    size_t m_len, mu_len, window_bits, window_len, table_cnt, i;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus)) {
+        return 1;
+    }
+
+    m = ctx->modulus->num;
+    m_len = ctx->modulus->len;
+    mu = ctx->mu->num;
+    mu_len = ctx->mu->len;
+
+    /* pow(a, 0) = 1 (mod modulus) */
+    if (b->len == 1 && b->num[0] == 0) {
+        if (m_len == 1 && m[0] == 1) {
+            return big_int_from_int(0, answer) ? 2 : 0;
+        }
+        return big_int_from_int(1, answer) ? 2 : 0;
+    }
+
+    big_int_bit_length(b, &n_bits);
+    window_bits = low_level_pow_window_bits(n_bits);
+    table_cnt = (size_t) 1 << (window_bits - 1);
+
+    /*
+        layout of buffer:
+            x - [m_len] digits
+            table = {a, a^3, ..., a^(2 * table_cnt - 1)} - [table_cnt * m_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        ((table_cnt + 1) * m_len + low_level_barrett_mul_tmp_len(m_len, mu_len)));
+    if (x == NULL) {
+        return 2;
+    }
+    table = x + m_len;
+    tmp = table + table_cnt * m_len;
+
+    /* table[i] = table[i - 1] * a^2 */
+    big_int_copy_to_buffer(a, table, m_len);
+    if (table_cnt > 1) {
+        low_level_barrett_mul(table, table, m, m_len, mu, mu_len, x, tmp);
+        for (i = 1; i < table_cnt; i++) {
+            low_level_barrett_mul(table + (i - 1) * m_len, x, m, m_len, mu, mu_len,
+                table + i * m_len, tmp);
+        }
+    }
+
+    /* the first window always starts with bit 1 */
+    window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+    memcpy(x, table + (window >> 1) * m_len, BIG_INT_WORD_BYTES_CNT * m_len);
+    n_bits -= window_len;
+    while (n_bits) {
+        window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+        n_bits -= window_len;
+        while (window_len--) {
+            low_level_barrett_mul(x, x, m, m_len, mu, mu_len, x, tmp);
+        }
+        if (window) {
+            low_level_barrett_mul(x, table + (window >> 1) * m_len, m, m_len, mu, mu_len, x, tmp);
+        }
+    }
+
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(x);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = pow(a[0], abs(b[0])) * ... * pow(a[n - 1], abs(b[n - 1])) (mod modulus)
+    
+    Interleaved sliding-window exponentiation is used: every exponent
+    is split into windows by low_level_pow_window() and has its own table
+    of odd powers, but all exponents share the same chain of squarings.
+    So only max(length(b[i])) squarings are made instead of
+    length(b[0]) + ... + length(b[n - 1]).
+
+    Returns error number:
+        0 - no errors
+        1 - [a[i]] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_barrett_multi_pow(const big_int_barrett *ctx, const big_int **a, const big_int **b,
+    size_t n, big_int *answer)
+{
+    const big_int_word *m, *mu;
+    big_int_word *x, *windows, *tables, *table, *tmp;
+    size_t *n_bits, *window_bits, *table_pos;
+    unsigned int bits;
+    size_t m_len, mu_len, tables_len, max_bits, window_len, table_cnt, i, j;
+    int is_one, result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL || n == 0);
+    assert(b != NULL || n == 0);
+    assert(answer != NULL);
+
+    for (i = 0; i < n; i++) {
+        if (!big_int_is_reduced(a[i], ctx->modulus)) {
+            return 1;
+        }
+    }
+
+    m = ctx->modulus->num;
+    m_len = ctx->modulus->len;
+    mu = ctx->mu->num;
+    mu_len = ctx->mu->len;
+
+    /* product of zero powers is 1 (mod modulus) */
+    if (n == 0) {
+        if (m_len == 1 && m[0] == 1) {
+            return big_int_from_int(0, answer) ? 2 : 0;
+        }
+        return big_int_from_int(1, answer) ? 2 : 0;
+    }
+
+    /*
+        n_bits[i] - number of bits of b[i], which are not processed yet
+        window_bits[i] - window size for b[i]
+        table_pos[i] - position of table for a[i] in [tables]
+    */
+    n_bits = (size_t *) bi_malloc(sizeof(*n_bits) * 3 * n);
+    if (n_bits == NULL) {
+        return 2;
+    }
+    window_bits = n_bits + n;
+    table_pos = window_bits + n;
+
+    tables_len = 0;
+    max_bits = 0;
+    for (i = 0; i < n; i++) {
+        big_int_bit_length(b[i], &bits);
+        n_bits[i] = bits;
+        window_bits[i] = low_level_pow_window_bits(bits);
+        table_pos[i] = tables_len;
+        if (bits) {
+            tables_len += ((size_t) 1 << (window_bits[i] - 1)) * m_len;
+        }
+        if (max_bits < n_bits[i]) {
+            max_bits = n_bits[i];
+        }
+    }
+
+    /*
+        layout of buffer:
+            x - [m_len] digits
+            windows - current window for every exponent, [n] digits
+            tables = {a[i], a[i]^3, ..., a[i]^(2 * table_cnt - 1)} for every
+                nonzero b[i] - [tables_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (m_len + n + tables_len + low_level_barrett_mul_tmp_len(m_len, mu_len)));
+    if (x == NULL) {
+        result = 2;
+        goto end;
+    }
+    windows = x + m_len;
+    tables = windows + n;
+    tmp = tables + tables_len;
+
+    for (i = 0; i < n; i++) {
+        windows[i] = 0;
+        if (n_bits[i] == 0) {
+            continue;
+        }
+        table = tables + table_pos[i];
+        table_cnt = (size_t) 1 << (window_bits[i] - 1);
+
+        /* table[j] = table[j - 1] * a[i]^2 */
+        big_int_copy_to_buffer(a[i], table, m_len);
+        if (table_cnt > 1) {
+            low_level_barrett_mul(table, table, m, m_len, mu, mu_len, x, tmp);
+            for (j = 1; j < table_cnt; j++) {
+                low_level_barrett_mul(table + (j - 1) * m_len, x, m, m_len, mu, mu_len,
+                    table + j * m_len, tmp);
+            }
+        }
+
+        /*
+            the first window always starts with bit 1. It must be multiplied
+            into [x], when bit number n_bits[i] of exponent is reached
+        */
+        windows[i] = low_level_pow_window(b[i]->num, n_bits[i], window_bits[i], &window_len);
+        n_bits[i] -= window_len;
+    }
+
+    /*
+        [x] stays equal to 1 until the first multiplication,
+        so squarings of 1 are skipped
+    */
+    is_one = 1;
+    j = max_bits;
+    while (j--) {
+        if (!is_one) {
+            low_level_barrett_mul(x, x, m, m_len, mu, mu_len, x, tmp);
+        }
+        for (i = 0; i < n; i++) {
+            if (windows[i] == 0 || n_bits[i] != j) {
+                continue;
+            }
+            table = tables + table_pos[i] + (windows[i] >> 1) * m_len;
+            if (is_one) {
+                memcpy(x, table, BIG_INT_WORD_BYTES_CNT * m_len);
+                is_one = 0;
+            } else {
+                low_level_barrett_mul(x, table, m, m_len, mu, mu_len, x, tmp);
+            }
+
+            /* find the next nonzero window of b[i] */
+            windows[i] = 0;
+            while (n_bits[i] && windows[i] == 0) {
+                windows[i] = low_level_pow_window(b[i]->num, n_bits[i], window_bits[i],
+                    &window_len);
+                n_bits[i] -= window_len;
+            }
+        }
+    }
+
+    if (is_one) {
+        /* all exponents are zero */
+        if (big_int_from_int((m_len == 1 && m[0] == 1) ? 0 : 1, answer)) {
+            result = 2;
+        }
+        goto end;
+    }
+
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+
+end:
+    bi_free(x);
+    bi_free(n_bits);
+
+    return result;
+}
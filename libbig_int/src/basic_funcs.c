@@ -22,24 +22,22 @@
 /*
     private functions
 */
-static int incdec(const big_int *a, bin_op_type op, big_int *answer);
+static int incdec(const big_int *a, big_int_word b, bin_op_type op, big_int *answer);
 static int addsub(const big_int *a, const big_int *b, bin_op_type op, big_int *answer);
 
 /**
     Private function.
 
-    Increments / decrements number [a].
-    If [op] == ADD, then increments number [a]
-    if [op] == SUB, then decrements number [a]
+    Adds / subtracts digit [b] to / from number [a].
+    If [op] == ADD, then answer = a + b
+    if [op] == SUB, then answer = a - b
 
     Returns error number:
         0 - no errors
         other - internal error
 */
-static int incdec(const big_int *a, bin_op_type op, big_int *answer)
+static int incdec(const big_int *a, big_int_word b, bin_op_type op, big_int *answer)
 {
-    big_int_word one = 1;
-
     assert(a != NULL);
     assert(answer != NULL);
     assert(op == ADD || op == SUB);
@@ -52,25 +50,26 @@ static int incdec(const big_int *a, bin_op_type op, big_int *answer)
     if ((answer->sign == PLUS && op == ADD) ||
         (answer->sign == MINUS && op == SUB)) {
         /*
-            Add 1 to [answer]. For this allocate one digit and
+            Add [b] to abs(answer). For this allocate one digit and
             set it to zero before calling low_level_add() function.
         */
         if (big_int_realloc(answer, answer->len + 1)) {
             return 2;
         }
         answer->num[answer->len] = 0;
-        low_level_add(answer->num, answer->num + answer->len, &one, (&one) + 1, answer->num);
+        low_level_add(answer->num, answer->num + answer->len, &b, (&b) + 1, answer->num);
         answer->len++;
     } else {
         /*
-            Subtract 1 from [answer]. If [answer] == 0, then
-            set it to -1, else call low_level_sub() function.
+            Subtract [b] from abs(answer). If abs(answer) < b, then
+            set abs(answer) to b - abs(answer) and change its sign,
+            else call low_level_sub() function.
         */
-        if (answer->len == 1 && answer->num[0] == 0) {
-            answer->num[0] = 1;
-            answer->sign = MINUS;
+        if (answer->len == 1 && answer->num[0] < b) {
+            answer->num[0] = (big_int_word) (b - answer->num[0]);
+            answer->sign = (answer->sign == PLUS) ? MINUS : PLUS;
         } else {
-            low_level_sub(answer->num, answer->num + answer->len, &one, (&one) + 1, answer->num);
+            low_level_sub(answer->num, answer->num + answer->len, &b, (&b) + 1, answer->num);
         }
     }
     big_int_clear_zeros(answer);
@@ -238,8 +237,9 @@ end:
 */
 int big_int_mul(const big_int *a, const big_int *b, big_int *answer)
 {
-    size_t answer_len;
+    size_t answer_len, tmp_len;
     big_int *answer_copy = NULL;
+    big_int_word *tmp_buf = NULL;
     const big_int *tmp;
     int result = 0;
 
@@ -298,14 +298,28 @@ int big_int_mul(const big_int *a, const big_int *b, big_int *answer)
     }
     answer_copy->len = answer_len;
 
+    /* allocate temporary buffer for low_level_fast_sqr() or low_level_fast_mul() */
+    if (a == b) {
+        tmp_len = low_level_fast_sqr_tmp_len(a->len);
+    } else {
+        tmp_len = low_level_fast_mul_tmp_len(a->len, b->len);
+    }
+    if (tmp_len) {
+        tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * tmp_len);
+        if (tmp_buf == NULL) {
+            result = 6;
+            goto end;
+        }
+    }
     if (a == b) {
         /*
-            If a == b, i.e. answer += a*a, then
-            call low_level_sqr(), which is faster then low_level_mul()
+            If a == b, i.e. answer = a*a, then
+            call low_level_fast_sqr(), which is faster then low_level_fast_mul()
         */
-        low_level_sqr(a->num, a->num + a->len, answer_copy->num);
+        low_level_fast_sqr(a->num, a->num + a->len, answer_copy->num, tmp_buf);
     } else {
-        low_level_mul(a->num, a->num + a->len, b->num, b->num + b->len, answer_copy->num);
+        low_level_fast_mul(a->num, a->num + a->len, b->num, b->num + b->len,
+                           answer_copy->num, tmp_buf);
     }
 
     big_int_clear_zeros(answer_copy);
@@ -317,6 +331,7 @@ int big_int_mul(const big_int *a, const big_int *b, big_int *answer)
 
 end:
     /* free allocated memory */
+    bi_free(tmp_buf);
     if (answer_copy != answer) {
         big_int_destroy(answer_copy);
     }
@@ -437,8 +452,9 @@ void big_int_cmp(const big_int *a, const big_int *b, int *cmp_flag)
 */
 int big_int_div_extended(const big_int *a, const big_int *b, big_int *q, big_int *r)
 {
-    size_t a_len, b_len, c_len;
+    size_t a_len, b_len, c_len, tmp_len;
     big_int *c = NULL, *a_copy = NULL;
+    big_int_word *tmp_buf = NULL;
     size_t n_bits;
     int cmp_flag;
     int result = 0;
@@ -499,7 +515,7 @@ int big_int_div_extended(const big_int *a, const big_int *b, big_int *q, big_int
         result = 5;
         goto end;
     }
-    /* allocate additional word for [a_copy] (need for low_level_div() ) */
+    /* allocate additional word for [a_copy] (need for low_level_fast_div() ) */
     a_len = a_copy->len + 1;
     if (big_int_realloc(a_copy, a_len)) {
         result = 6;
@@ -530,9 +546,18 @@ int big_int_div_extended(const big_int *a, const big_int *b, big_int *q, big_int
         a_copy->num[a_len - 1] = 0;
     }
 
-    low_level_div(a_copy->num, a_copy->num + a_len,
-                  b->num, b->num + b_len,
-                  c->num, c->num + c_len);
+    /* allocate temporary buffer for low_level_fast_div() */
+    tmp_len = low_level_fast_div_tmp_len(a_len, b_len);
+    if (tmp_len) {
+        tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * tmp_len);
+        if (tmp_buf == NULL) {
+            result = 14;
+            goto end;
+        }
+    }
+    low_level_fast_div(a_copy->num, a_copy->num + a_len,
+                       b->num, b->num + b_len,
+                       c->num, c->num + c_len, tmp_buf);
     /*
         Set signs of quotient and reminder.
         Sign of reminder (a_copy) is the same as sign of [a]
@@ -567,6 +592,7 @@ int big_int_div_extended(const big_int *a, const big_int *b, big_int *q, big_int
 
 end:
     /* free allocated memory */
+    bi_free(tmp_buf);
     big_int_destroy(c);
     big_int_destroy(a_copy);
 
@@ -609,6 +635,232 @@ int big_int_mod(const big_int *a, const big_int *b, big_int *answer)
     return big_int_div_extended(a, b, NULL, answer);
 }
 
+/**
+    Divides [a] by [b], if [a] is divisible by [b]:
+        answer = a / b
+    Exact division is faster than big_int_div(), because it finds
+    digits of quotient starting from the lowest one, so they don't
+    need to be corrected. If [a] isn't divisible by [b], then [answer]
+    is meaningless. Use big_int_divisible_p() to check divisibility.
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero ([b] cannot be zero)
+        other - internal errors
+*/
+int big_int_divexact(const big_int *a, const big_int *b, big_int *answer)
+{
+    big_int *a_copy = NULL, *b_copy = NULL, *c = NULL;
+    big_int_word *tmp_buf = NULL;
+    size_t n_bits, c_len, tmp_len;
+    int cmp_flag;
+    int result = 0;
+
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (b->len == 1 && b->num[0] == 0) {
+        /* division by zero */
+        result = 1;
+        goto end;
+    }
+
+    /* if abs(a) < abs(b), then [a] can be divisible by [b] only if a = 0 */
+    big_int_cmp_abs(a, b, &cmp_flag);
+    if (cmp_flag < 0) {
+        if (big_int_from_int(0, answer)) {
+            result = 2;
+            goto end;
+        }
+        goto end;
+    }
+
+    /* a / b = (a / 2^n_bits) / (b / 2^n_bits), where b / 2^n_bits is odd */
+    a_copy = big_int_dup(a);
+    b_copy = big_int_dup(b);
+    if (a_copy == NULL || b_copy == NULL) {
+        result = 3;
+        goto end;
+    }
+    big_int_scan1_bit(b, 0, &n_bits);
+    if (big_int_rshift(a_copy, (int) n_bits, a_copy)) {
+        result = 4;
+        goto end;
+    }
+    if (big_int_rshift(b_copy, (int) n_bits, b_copy)) {
+        result = 5;
+        goto end;
+    }
+
+    c_len = a_copy->len - b_copy->len + 1;
+    c = big_int_create(c_len);
+    if (c == NULL) {
+        result = 6;
+        goto end;
+    }
+    c->len = c_len;
+
+    /* allocate temporary buffer for low_level_divexact() */
+    tmp_len = low_level_divexact_tmp_len(a_copy->len, b_copy->len);
+    if (tmp_len) {
+        tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * tmp_len);
+        if (tmp_buf == NULL) {
+            result = 7;
+            goto end;
+        }
+    }
+    low_level_divexact(a_copy->num, a_copy->num + a_copy->len,
+                       b_copy->num, b_copy->num + b_copy->len, c->num, tmp_buf);
+    c->sign = (a->sign == b->sign) ? PLUS : MINUS;
+    big_int_clear_zeros(c);
+
+    if (big_int_copy(c, answer)) {
+        result = 8;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    bi_free(tmp_buf);
+    big_int_destroy(c);
+    big_int_destroy(b_copy);
+    big_int_destroy(a_copy);
+
+    return result;
+}
+
+/**
+    Sets [is_divisible] to 1, if [a] is divisible by [b].
+    Else sets it to 0.
+
+    Cheap checks are done first: abs(a) < abs(b), power of 2
+    in [b] and digit [b]. Odd part of [b] is checked by Hensel's
+    division, which doesn't calculate quotient, or by reminder
+    of big_int_mod() for long numbers.
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero ([b] cannot be zero)
+        other - internal errors
+*/
+int big_int_divisible_p(const big_int *a, const big_int *b, int *is_divisible)
+{
+    big_int *b_odd = NULL, *r = NULL;
+    big_int_word *tmp_buf = NULL;
+    big_int_word rem;
+    size_t n_bits;
+    int cmp_flag;
+    int result = 0;
+
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(is_divisible != NULL);
+
+    if (b->len == 1 && b->num[0] == 0) {
+        /* division by zero */
+        result = 1;
+        goto end;
+    }
+
+    *is_divisible = 1;
+    if (a->len == 1 && a->num[0] == 0) {
+        /* zero is divisible by any number */
+        goto end;
+    }
+
+    *is_divisible = 0;
+    big_int_cmp_abs(a, b, &cmp_flag);
+    if (cmp_flag < 0) {
+        goto end;
+    }
+
+    /* [a] must be divisible by the power of 2 in [b] */
+    big_int_scan1_bit(b, 0, &n_bits);
+    big_int_divisible_2exp(a, n_bits, is_divisible);
+    if (!*is_divisible) {
+        goto end;
+    }
+
+    /* [a] must be divisible by the odd part of [b] */
+    b_odd = big_int_dup(b);
+    if (b_odd == NULL) {
+        result = 2;
+        goto end;
+    }
+    if (big_int_rshift(b_odd, (int) n_bits, b_odd)) {
+        result = 3;
+        goto end;
+    }
+    if (b_odd->len == 1) {
+        if (big_int_mod_word(a, b_odd->num[0], &rem)) {
+            result = 4;
+            goto end;
+        }
+        *is_divisible = (rem == 0);
+        goto end;
+    }
+    if (b_odd->len >= BIG_INT_BZ_DIV_THRESHOLD &&
+        a->len - b_odd->len >= BIG_INT_BZ_DIV_THRESHOLD) {
+        /* recursive division is faster than Hensel's one for long numbers */
+        r = big_int_create(b_odd->len);
+        if (r == NULL) {
+            result = 5;
+            goto end;
+        }
+        if (big_int_mod(a, b_odd, r)) {
+            result = 6;
+            goto end;
+        }
+        big_int_is_zero(r, is_divisible);
+        goto end;
+    }
+    tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * (a->len + 1));
+    if (tmp_buf == NULL) {
+        result = 7;
+        goto end;
+    }
+    *is_divisible = low_level_divisible(a->num, a->num + a->len,
+                                        b_odd->num, b_odd->num + b_odd->len, tmp_buf);
+
+end:
+    /* free allocated memory */
+    bi_free(tmp_buf);
+    big_int_destroy(r);
+    big_int_destroy(b_odd);
+
+    return result;
+}
+
+/**
+    Sets [is_divisible] to 1, if [a] is divisible by 2^n_bits.
+    Else sets it to 0.
+*/
+void big_int_divisible_2exp(const big_int *a, size_t n_bits, int *is_divisible)
+{
+    const big_int_word *num, *num_end;
+    size_t n_digits;
+
+    assert(a != NULL);
+    assert(is_divisible != NULL);
+
+    *is_divisible = 0;
+    n_digits = n_bits / BIG_INT_WORD_BITS_CNT;
+    num = a->num;
+    num_end = num + ((n_digits < a->len) ? n_digits : a->len);
+    while (num < num_end) {
+        if (*num++) {
+            return;
+        }
+    }
+    n_bits %= BIG_INT_WORD_BITS_CNT;
+    if (n_digits < a->len && n_bits &&
+        (big_int_word) (a->num[n_digits] << (BIG_INT_WORD_BITS_CNT - n_bits))) {
+        return;
+    }
+    *is_divisible = 1;
+}
+
 /**
     Increments [a] by 1:
         a = a + 1;
@@ -622,7 +874,7 @@ int big_int_inc(const big_int *a, big_int *answer)
     assert(a != NULL);
     assert(answer != NULL);
 
-    return incdec(a, ADD, answer);
+    return incdec(a, 1, ADD, answer);
 }
 
 /**
@@ -638,7 +890,131 @@ int big_int_dec(const big_int *a, big_int *answer)
     assert(a != NULL);
     assert(answer != NULL);
 
-    return incdec(a, SUB, answer);
+    return incdec(a, 1, SUB, answer);
+}
+
+/**
+    Adds digit [b] to [a]:
+        answer = a + b
+    It is faster than big_int_add(), because it needs no
+    temporary number for [b].
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+int big_int_add_word(const big_int *a, big_int_word b, big_int *answer)
+{
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return incdec(a, b, ADD, answer);
+}
+
+/**
+    Multiplies [a] by digit [b]:
+        answer = a * b
+    It is faster than big_int_mul(), because it needs no
+    temporary number for [b].
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+int big_int_mul_word(const big_int *a, big_int_word b, big_int *answer)
+{
+    big_int_word flag_c;
+
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    if (b == 0) {
+        return big_int_from_int(0, answer) ? 1 : 0;
+    }
+
+    /* copy [a] to [answer] and allocate one digit for carry */
+    if (big_int_copy(a, answer)) {
+        return 2;
+    }
+    if (big_int_realloc(answer, answer->len + 1)) {
+        return 3;
+    }
+    flag_c = low_level_mul_1(answer->num, answer->num + answer->len, b, answer->num);
+    if (flag_c) {
+        answer->num[answer->len++] = flag_c;
+    }
+    big_int_clear_zeros(answer);
+
+    return 0;
+}
+
+/**
+    Divides [a] by digit [b]:
+        q = a / b
+        r = abs(a) mod b
+    So, a = q * b + r for non-negative [a] and a = q * b - r for negative [a].
+    Quotient is the same as quotient of big_int_div().
+
+    [q] or [r] can be NULL, if the result is not needed.
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero ([b] cannot be zero)
+        other - internal error
+*/
+int big_int_divrem_word(const big_int *a, big_int_word b, big_int *q, big_int_word *r)
+{
+    big_int_word rem;
+
+    assert(a != NULL);
+
+    if (b == 0) {
+        return 1;
+    }
+
+    if (q == NULL) {
+        rem = low_level_divrem_1(a->num, a->num + a->len, b, NULL);
+    } else {
+        if (big_int_copy(a, q)) {
+            return 2;
+        }
+        rem = low_level_divrem_1(q->num, q->num + q->len, b, q->num);
+        big_int_clear_zeros(q);
+    }
+    if (r != NULL) {
+        *r = rem;
+    }
+
+    return 0;
+}
+
+/**
+    Finds non-negative reminder of the division [a] by digit [b]:
+        r = a (mod b)
+    Result is the same as result of big_int_absmod().
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero ([b] cannot be zero)
+*/
+int big_int_mod_word(const big_int *a, big_int_word b, big_int_word *r)
+{
+    big_int_word rem;
+
+    assert(a != NULL);
+    assert(r != NULL);
+
+    if (b == 0) {
+        return 1;
+    }
+
+    rem = low_level_divrem_1(a->num, a->num + a->len, b, NULL);
+    if (a->sign == MINUS && rem != 0) {
+        rem = (big_int_word) (b - rem);
+    }
+    *r = rem;
+
+    return 0;
 }
 
 /**
@@ -235,7 +235,7 @@ static int bin_op(const big_int *a, const big_int *b, size_t start_bit, bin_op_t
         case AND:
             low_level_and(a_num, a_num + a->len - word_offset, b->num, b->num + b->len, answer_copy->num + word_offset);
             if (bit_offset) {
-                *(answer_copy->num + word_offset - 1) &= low_digit | ((1 << bit_offset) - 1);
+                *(answer_copy->num + word_offset - 1) &= low_digit | (((big_int_word) 1 << bit_offset) - 1);
             }
             break;
 
@@ -757,7 +757,7 @@ int big_int_subint(const big_int *a, size_t start_bit, size_t bit_len,
     }
     if (answer->len > bit_len / BIG_INT_WORD_BITS_CNT) {
         answer->len = (bit_len / BIG_INT_WORD_BITS_CNT) + 1;
-        answer->num[answer->len - 1] &= (1 << (bit_len % BIG_INT_WORD_BITS_CNT)) - 1;
+        answer->num[answer->len - 1] &= ((big_int_word) 1 << (bit_len % BIG_INT_WORD_BITS_CNT)) - 1;
         big_int_clear_zeros(answer);
     }
 
@@ -833,7 +833,7 @@ int big_int_rand(big_int_rnd_fp rand_func, size_t n_bits, big_int *answer)
     }
 
     /* clear higer bits in the higer digit */
-    *(--num) &= (1 << n_bits) - 1;
+    *(--num) &= ((big_int_word) 1 << n_bits) - 1;
 
     big_int_clear_zeros(answer);
     answer->sign = PLUS; // change answer sign
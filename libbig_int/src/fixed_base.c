@@ -0,0 +1,264 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h> /* for assert() */
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+#include "memory_manager.h"
+#include "service_funcs.h"
+#include "num_buffer.h"
+#include "bitset_funcs.h"
+#include "modular_arithmetic.h"
+#include "fixed_base.h"
+
+/**
+    Creates fixed-base context for [base] by [modulus] and builds
+    comb table for exponents with up to [exp_bits] bits.
+    Sign of [modulus] is ignored.
+
+    Number of teeth grows with [exp_bits] up to BIG_INT_COMB_MAX_TEETH
+    (see low_level_funcs.h). Longer exponents can be passed
+    to big_int_fixed_base_pow() too, but they are processed
+    by ordinary sliding-window exponentiation.
+
+    Returns pointer to created context.
+    On error returns NULL pointer.
+
+    Restrictions:
+        1) [modulus] must be odd and abs(modulus) > 1
+*/
+big_int_fixed_base * big_int_fixed_base_create(const big_int *base,
+    const big_int *modulus, size_t exp_bits)
+{
+    big_int_fixed_base *ctx;
+    const big_int_word *n;
+    big_int_word *table, *tmp = NULL;
+    size_t n_len, teeth, spacing, table_cnt, i, j, k;
+
+    assert(base != NULL);
+    assert(modulus != NULL);
+
+    ctx = (big_int_fixed_base *) bi_malloc(sizeof(big_int_fixed_base));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    ctx->base = NULL;
+    ctx->table = NULL;
+    ctx->mont = big_int_mont_create(modulus);
+    if (ctx->mont == NULL) {
+        goto error;
+    }
+    n = ctx->mont->modulus->num;
+    n_len = ctx->mont->modulus->len;
+
+    ctx->base = big_int_create(n_len);
+    if (ctx->base == NULL) {
+        goto error;
+    }
+    if (big_int_absmod(base, modulus, ctx->base)) {
+        goto error;
+    }
+
+    /*
+        choose number of teeth about log2(exp_bits) - 3. Then table
+        with pow(2, teeth) numbers is much shorter than exponent
+    */
+    if (exp_bits == 0) {
+        exp_bits = 1;
+    }
+    teeth = 1;
+    while (teeth < BIG_INT_COMB_MAX_TEETH && ((size_t) 16 << teeth) <= exp_bits) {
+        teeth++;
+    }
+    spacing = (exp_bits + teeth - 1) / teeth;
+    table_cnt = (size_t) 1 << teeth;
+    ctx->teeth = teeth;
+    ctx->spacing = spacing;
+
+    ctx->table = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * table_cnt * n_len);
+    tmp = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (2 * n_len + low_level_mont_mul_tmp_len(n_len)));
+    if (ctx->table == NULL || tmp == NULL) {
+        goto error;
+    }
+    table = ctx->table;
+
+    /* table[0] = R (mod n), table[1] = base * R (mod n) */
+    big_int_copy_to_buffer(ctx->mont->r2, tmp, n_len);
+    memset(table, 0, BIG_INT_WORD_BYTES_CNT * n_len);
+    table[0] = 1;
+    low_level_mont_mul(tmp, table, n, n_len, ctx->mont->n0_inv, table, tmp + 2 * n_len);
+    big_int_copy_to_buffer(ctx->base, tmp + n_len, n_len);
+    low_level_mont_mul(tmp, tmp + n_len, n, n_len, ctx->mont->n0_inv, table + n_len,
+        tmp + 2 * n_len);
+
+    /* table[pow(2, k)] = pow(table[pow(2, k - 1)], pow(2, spacing)) */
+    for (k = 1; k < teeth; k++) {
+        j = (size_t) 1 << k;
+        memcpy(table + j * n_len, table + (j >> 1) * n_len, BIG_INT_WORD_BYTES_CNT * n_len);
+        for (i = 0; i < spacing; i++) {
+            low_level_mont_sqr(table + j * n_len, n, n_len, ctx->mont->n0_inv,
+                table + j * n_len, tmp);
+        }
+    }
+
+    /* table[j] = table[j without its lowest bit] * table[lowest bit of j] */
+    for (j = 3; j < table_cnt; j++) {
+        k = j & (~j + 1);
+        if (k == j) {
+            continue;
+        }
+        low_level_mont_mul(table + (j - k) * n_len, table + k * n_len, n, n_len,
+            ctx->mont->n0_inv, table + j * n_len, tmp);
+    }
+    bi_free(tmp);
+
+    return ctx;
+
+error:
+    bi_free(tmp);
+    big_int_fixed_base_destroy(ctx);
+    return NULL;
+}
+
+/**
+    Frees memory, allocated for fixed-base context [ctx]
+*/
+void big_int_fixed_base_destroy(big_int_fixed_base *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    bi_free(ctx->table);
+    big_int_destroy(ctx->base);
+    big_int_mont_destroy(ctx->mont);
+    bi_free(ctx);
+}
+
+/**
+    Calculates
+        answer = pow(base, b) (mod modulus)
+    by comb table of fixed-base context [ctx].
+
+    Returns error number:
+        0 - no errors
+        1 - GCD(base, modulus) != 1, when [b] is negative
+        other - internal error
+*/
+int big_int_fixed_base_pow(const big_int_fixed_base *ctx, const big_int *b, big_int *answer)
+{
+    const big_int_word *n, *table;
+    big_int_word *x = NULL, *tmp;
+    unsigned int n_bits;
+    size_t n_len, pos, i, j, k;
+    int is_one, result = 0;
+
+    assert(ctx != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    n = ctx->mont->modulus->num;
+    n_len = ctx->mont->modulus->len;
+    table = ctx->table;
+
+    /* pow(0, b) = 0 for any [b], as in big_int_powmod() */
+    if (ctx->base->len == 1 && ctx->base->num[0] == 0) {
+        if (big_int_from_int(0, answer)) {
+            result = 2;
+        }
+        goto end;
+    }
+
+    big_int_bit_length(b, &n_bits);
+    if (n_bits > ctx->teeth * ctx->spacing) {
+        /* exponent is too long for comb table */
+        if (big_int_mont_pow(ctx->mont, ctx->base, b, answer)) {
+            result = 3;
+            goto end;
+        }
+    } else {
+        /*
+            layout of buffer:
+                x - [n_len] digits
+                tmp - the rest
+        */
+        x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+            (n_len + low_level_mont_mul_tmp_len(n_len)));
+        if (x == NULL) {
+            result = 4;
+            goto end;
+        }
+        tmp = x + n_len;
+
+        /*
+            column [i] of exponent selects table[j], where bit [k] of [j]
+            is bit number (k * spacing + i) of exponent.
+            [x] stays equal to 1 until the first multiplication
+        */
+        memcpy(x, table, BIG_INT_WORD_BYTES_CNT * n_len);
+        is_one = 1;
+        i = ctx->spacing;
+        while (i--) {
+            if (!is_one) {
+                low_level_mont_sqr(x, n, n_len, ctx->mont->n0_inv, x, tmp);
+            }
+            j = 0;
+            k = ctx->teeth;
+            while (k--) {
+                j <<= 1;
+                pos = k * ctx->spacing + i;
+                if (pos < n_bits) {
+                    j |= (b->num[pos / BIG_INT_WORD_BITS_CNT] >> (pos % BIG_INT_WORD_BITS_CNT)) & 1;
+                }
+            }
+            if (j == 0) {
+                continue;
+            }
+            if (is_one) {
+                memcpy(x, table + j * n_len, BIG_INT_WORD_BYTES_CNT * n_len);
+                is_one = 0;
+            } else {
+                low_level_mont_mul(x, table + j * n_len, n, n_len, ctx->mont->n0_inv, x, tmp);
+            }
+        }
+
+        /* convert [x] from Montgomery form */
+        memcpy(tmp, x, BIG_INT_WORD_BYTES_CNT * n_len);
+        memset(tmp + n_len, 0, BIG_INT_WORD_BYTES_CNT * (n_len + 1));
+        low_level_mont_redc(tmp, n, n_len, ctx->mont->n0_inv, x);
+        if (big_int_set_from_buffer(x, n_len, answer)) {
+            result = 5;
+            goto end;
+        }
+    }
+
+    /*
+        if [b] is negative, then try to find inverse number of
+        [answer] by mod [modulus]
+    */
+    if (b->sign == MINUS) {
+        result = big_int_invmod(answer, ctx->mont->modulus, answer);
+        if (result) {
+            result = (result == 2) ? 1 : 6;
+            goto end;
+        }
+    }
+
+end:
+    bi_free(x);
+
+    return result;
+}
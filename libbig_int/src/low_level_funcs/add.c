@@ -35,6 +35,13 @@ void low_level_add(big_int_word *a, big_int_word *a_end,
     assert(a_end - a >= b_end - b);
     assert(b != c);
 
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        low_level_add_adx(a, a_end, b, b_end, c);
+        return;
+    }
+#endif
+
     flag_c = 0;
     do {
         if (flag_c) {
@@ -95,3 +102,44 @@ void low_level_add(big_int_word *a, big_int_word *a_end,
         }
     }
 }
+
+/**
+    Calculates
+        a = a + b
+
+    Returns carry (0 or 1) from the highest digit of [a].
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+*/
+big_int_word low_level_addto(big_int_word *a, big_int_word *a_end,
+                             const big_int_word *b, const big_int_word *b_end)
+{
+    big_int_dword tmp;
+
+    assert(b_end - b > 0);
+    assert(a_end - a >= b_end - b);
+
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        return low_level_addto_adx(a, a_end, b, b_end);
+    }
+#endif
+
+    tmp = 0;
+    do {
+        tmp += *a;
+        tmp += *b++;
+        *a++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    } while (b < b_end);
+
+    /* move carry up to the higher digits of [a] */
+    while (tmp && a < a_end) {
+        if (++(*a++)) {
+            tmp = 0;
+        }
+    }
+
+    return (big_int_word) tmp;
+}
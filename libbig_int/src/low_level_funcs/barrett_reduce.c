@@ -0,0 +1,166 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Barrett reduction modulo number [m] with length [m_len] digits.
+    Precomputed
+        mu = floor(B^(2 * m_len) / m),
+    where B = 2^BIG_INT_WORD_BITS_CNT, replaces division by [m]
+    with two multiplications. Unlike Montgomery multiplication,
+    [m] can be even.
+*/
+
+/**
+    Calculates
+        r = x (mod m)
+    with precomputed mu = floor(B^(2 * m_len) / m).
+    See HAC, algorithm 14.42.
+
+    Restrictions:
+        1) m_len > 0 and m[m_len - 1] != 0
+        2) [x] must points to array of size 2 * m_len
+        3) [mu] must points to array of size mu_len,
+           mu_len = m_len + 1 or mu_len = m_len + 2
+        4) [r] must points to array of size m_len.
+           Address [r] can be equal to [x]
+        5) [tmp] must points to array of size, returned by
+           low_level_barrett_reduce_tmp_len(m_len, mu_len)
+*/
+void low_level_barrett_reduce(const big_int_word *x, const big_int_word *m, size_t m_len,
+                              const big_int_word *mu, size_t mu_len,
+                              big_int_word *r, big_int_word *tmp)
+{
+    big_int_word *q2, *rr;
+    big_int_word flag_c;
+    size_t i;
+
+    assert(m_len > 0);
+    assert(m[m_len - 1] != 0);
+    assert(mu_len == m_len + 1 || mu_len == m_len + 2);
+
+    /*
+        layout of [tmp]:
+            q2 - [mu_len + m_len + 1] digits
+            rr - [m_len + 1] digits
+            the rest is for multiplications
+    */
+    q2 = tmp;
+    rr = q2 + mu_len + m_len + 1;
+    tmp = rr + m_len + 1;
+
+    /* q2 = floor(x / B^(m_len - 1)) * mu */
+    low_level_fast_mul(mu, mu + mu_len, x + m_len - 1, x + 2 * m_len, q2, tmp);
+
+    /* rr = floor(q2 / B^(m_len + 1)) * m (mod B^(m_len + 1)) */
+    low_level_mul_low(q2 + m_len + 1, q2 + m_len + 1 + mu_len, m, m + m_len, rr, m_len + 1, tmp);
+
+    /* rr = x - rr (mod B^(m_len + 1)). Now rr < 3 * m */
+    flag_c = 0;
+    for (i = 0; i <= m_len; i++) {
+        if (flag_c) {
+            flag_c = (x[i] <= rr[i]) ? 1 : 0;
+            rr[i] = (big_int_word) (x[i] - rr[i] - 1);
+        } else {
+            flag_c = (x[i] < rr[i]) ? 1 : 0;
+            rr[i] = (big_int_word) (x[i] - rr[i]);
+        }
+    }
+
+    /* at most two subtractions of [m] are needed */
+    while (rr[m_len] != 0 || low_level_cmp(rr, m, m_len) >= 0) {
+        low_level_subfrom(rr, rr + m_len + 1, m, m + m_len);
+    }
+    memcpy(r, rr, BIG_INT_WORD_BYTES_CNT * m_len);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_barrett_reduce()
+
+    Restrictions:
+        1) m_len > 0
+        2) mu_len = m_len + 1 or mu_len = m_len + 2
+*/
+size_t low_level_barrett_reduce_tmp_len(size_t m_len, size_t mu_len)
+{
+    size_t len, len1;
+
+    assert(m_len > 0);
+    assert(mu_len == m_len + 1 || mu_len == m_len + 2);
+
+    len = low_level_fast_mul_tmp_len(mu_len, m_len + 1);
+    len1 = low_level_mul_low_tmp_len(mu_len, m_len, m_len + 1);
+    if (len1 > len) {
+        len = len1;
+    }
+    return mu_len + 2 * m_len + 2 + len;
+}
+
+/**
+    Calculates
+        c = a * b (mod m)
+    with precomputed mu = floor(B^(2 * m_len) / m).
+    If [a] equals to [b], then squaring is used.
+
+    Restrictions:
+        1) 0 <= a, b < m
+        2) [a], [b] and [c] must points to arrays of size m_len.
+           Address [c] can be equal to [a] or [b]
+        3) [tmp] must points to array of size, returned by
+           low_level_barrett_mul_tmp_len(m_len, mu_len)
+        4) other restrictions are the same as for low_level_barrett_reduce()
+*/
+void low_level_barrett_mul(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *m, size_t m_len,
+                           const big_int_word *mu, size_t mu_len,
+                           big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *x;
+
+    x = tmp;
+    tmp += 2 * m_len;
+    if (a == b) {
+        low_level_fast_sqr(a, a + m_len, x, tmp);
+    } else {
+        low_level_fast_mul(a, a + m_len, b, b + m_len, x, tmp);
+    }
+    low_level_barrett_reduce(x, m, m_len, mu, mu_len, c, tmp);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_barrett_mul()
+
+    Restrictions are the same as for low_level_barrett_reduce_tmp_len()
+*/
+size_t low_level_barrett_mul_tmp_len(size_t m_len, size_t mu_len)
+{
+    size_t len, len1;
+
+    len = low_level_fast_mul_tmp_len(m_len, m_len);
+    len1 = low_level_fast_sqr_tmp_len(m_len);
+    if (len1 > len) {
+        len = len1;
+    }
+    len1 = low_level_barrett_reduce_tmp_len(m_len, mu_len);
+    if (len1 > len) {
+        len = len1;
+    }
+    return 2 * m_len + len;
+}
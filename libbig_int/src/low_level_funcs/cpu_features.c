@@ -0,0 +1,59 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+#if defined(BIG_INT_X86_64_ASM)
+#include <cpuid.h> /* for __get_cpuid, __get_cpuid_count */
+#endif
+
+int low_level_cpu_features = 0;
+
+#if defined(BIG_INT_X86_64_ASM)
+static void detect_cpu_features(void) __attribute__((constructor));
+
+/**
+    Private function.
+
+    Sets low_level_cpu_features according to CPUID instruction.
+    It is called at library load.
+*/
+static void detect_cpu_features(void)
+{
+    unsigned int eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+    int features = 0;
+    int is_avx512_enabled = 0;
+
+    /* check, that OS saves AVX-512 registers: ECX bit 27 - OSXSAVE */
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 27))) {
+        __asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+        /* XCR0 bits 1, 2 - SSE and AVX state, bits 5, 6, 7 - AVX-512 state */
+        is_avx512_enabled = ((xcr0_lo & 0xe6) == 0xe6);
+    }
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        /* EBX bit 8 - BMI2, EBX bit 19 - ADX */
+        if ((ebx & (1u << 8)) && (ebx & (1u << 19))) {
+            features |= LOW_LEVEL_CPU_ADX;
+        }
+        /* EBX bit 16 - AVX-512F, EBX bit 21 - AVX-512 IFMA */
+        if (is_avx512_enabled && (ebx & (1u << 16)) && (ebx & (1u << 21))) {
+            features |= LOW_LEVEL_CPU_IFMA;
+        }
+    }
+
+    low_level_cpu_features = features;
+}
+#endif
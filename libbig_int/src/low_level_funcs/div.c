@@ -14,121 +14,334 @@
 *************************************************************************/
 #include <assert.h>
 #include "big_int.h"
+#include "get_bit_length.h" /* for get_bit_length() function */
 #include "low_level_funcs.h"
 
+static big_int_word div_2by1(big_int_word u1, big_int_word u0,
+                             big_int_word d, big_int_word v, big_int_word *r);
+static big_int_word div_3by2(big_int_word u2, big_int_word u1, big_int_word u0,
+                             big_int_word d1, big_int_word d0, big_int_word v,
+                             big_int_word *r1, big_int_word *r0);
+
 /**
-    Calculates quotient and reminder of a / b
+    Private function.
+
+    Divides two-digit number (u1, u0) by normalized digit [d] with
+    reciprocal [v], returned by low_level_div_inverse(), by Moller-Granlund
+    algorithm. Returns quotient, reminder is saved to [r].
+
+    Restrictions:
+        1) u1 < d
+*/
+static big_int_word div_2by1(big_int_word u1, big_int_word u0,
+                             big_int_word d, big_int_word v, big_int_word *r)
+{
+    big_int_dword q;
+    big_int_word q1, q0, rr, mask;
+
+    assert(u1 < d);
+
+    q = (big_int_dword) v * u1;
+    q += ((big_int_dword) u1 << BIG_INT_WORD_BITS_CNT) | u0;
+    q1 = (big_int_word) (BIG_INT_HI_WORD(q) + 1);
+    q0 = BIG_INT_LO_WORD(q);
+    rr = (big_int_word) (u0 - (big_int_word) (q1 * d));
+    /*
+        this condition is unpredictable, so it is calculated
+        without branch: mask = (rr > q0) ? MAX : 0
+    */
+    mask = (big_int_word) (0 - (big_int_word) (rr > q0));
+    q1 = (big_int_word) (q1 + mask);
+    rr = (big_int_word) (rr + (mask & d));
+    if (rr >= d) {
+        q1++;
+        rr -= d;
+    }
+    *r = rr;
+    return q1;
+}
+
+/**
+    Private function.
+
+    Divides three-digit number (u2, u1, u0) by normalized two-digit number
+    (d1, d0) with reciprocal [v], returned by low_level_div_inverse(),
+    by Moller-Granlund algorithm. Returns quotient, reminder is saved
+    to (r1, r0).
+
+    Restrictions:
+        1) (u2, u1) < (d1, d0)
+*/
+static big_int_word div_3by2(big_int_word u2, big_int_word u1, big_int_word u0,
+                             big_int_word d1, big_int_word d0, big_int_word v,
+                             big_int_word *r1, big_int_word *r0)
+{
+    big_int_dword q, t, r, d;
+    big_int_word q1, q0, rr1;
+
+    q = (big_int_dword) v * u2;
+    q += ((big_int_dword) u2 << BIG_INT_WORD_BITS_CNT) | u1;
+    q1 = BIG_INT_HI_WORD(q);
+    q0 = BIG_INT_LO_WORD(q);
+    d = ((big_int_dword) d1 << BIG_INT_WORD_BITS_CNT) | d0;
+
+    /* r = (u1 - q1 * d1, u0) - q1 * d0 - d (mod B^2) */
+    rr1 = (big_int_word) (u1 - (big_int_word) (q1 * d1));
+    t = (big_int_dword) d0 * q1;
+    r = ((big_int_dword) rr1 << BIG_INT_WORD_BITS_CNT) | u0;
+    r = (big_int_dword) (r - t);
+    r = (big_int_dword) (r - d);
+    q1++;
+    if (BIG_INT_HI_WORD(r) >= q0) {
+        q1--;
+        r = (big_int_dword) (r + d);
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+    *r1 = BIG_INT_HI_WORD(r);
+    *r0 = BIG_INT_LO_WORD(r);
+    return q1;
+}
+
+/**
+    Returns reciprocal of normalized divisor [b] for low_level_div_preinv().
+    If length(b) = 1, then reciprocal is
+        floor((B^2 - 1) / b) - B,
+    else it is calculated for the two higher digits (d1, d0) of [b]:
+        floor((B^3 - 1) / (d1 * B + d0)) - B,
+    where B = 2^BIG_INT_WORD_BITS_CNT.
+
+    Restrictions:
+        1) length(b) > 0
+        2) highest bit of [b] must be set to 1
+*/
+big_int_word low_level_div_inverse(const big_int_word *b, const big_int_word *b_end)
+{
+    big_int_dword t;
+    big_int_word d1, d0, v, p, t1, t0;
+
+    assert(b_end - b > 0);
+    assert((*(b_end - 1) >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
+
+    d1 = *(b_end - 1);
+    t = ((big_int_dword) (big_int_word) ~d1 << BIG_INT_WORD_BITS_CNT) | BIG_INT_MAX_WORD_NUM;
+    v = BIG_INT_LO_WORD(t / d1);
+    if (b_end - b == 1) {
+        return v;
+    }
+
+    /* adjust reciprocal of d1 to the reciprocal of (d1, d0) */
+    d0 = *(b_end - 2);
+    p = (big_int_word) (d1 * v);
+    p = (big_int_word) (p + d0);
+    if (p < d0) {
+        v--;
+        if (p >= d1) {
+            v--;
+            p -= d1;
+        }
+        p -= d1;
+    }
+    t = (big_int_dword) v * d0;
+    t1 = BIG_INT_HI_WORD(t);
+    t0 = BIG_INT_LO_WORD(t);
+    p = (big_int_word) (p + t1);
+    if (p < t1) {
+        v--;
+        if (p > d1 || (p == d1 && t0 >= d0)) {
+            v--;
+        }
+    }
+    return v;
+}
+
+/**
+    Calculates quotient and reminder of a / b, where [b] is a digit.
+    Quotient saves to address [c], reminder is returned.
+    [b] is normalized and its reciprocal is calculated by
+    low_level_divrem_1_preinv(). If [c] is NULL, then only reminder
+    is calculated.
+
+    Restrictions:
+        1) length(a) > 0
+        2) b > 0
+        3) [c] must points to array with size length(a) or must be NULL.
+           Address [c] can be equal to [a]
+*/
+big_int_word low_level_divrem_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c)
+{
+    big_int_word d;
+    size_t shift;
+
+    assert(a_end - a > 0);
+    assert(b > 0);
+
+    shift = BIG_INT_WORD_BITS_CNT - get_bit_length(b);
+    d = (big_int_word) (b << shift);
+    return low_level_divrem_1_preinv(a, a_end, d, shift,
+                                     low_level_div_inverse(&d, (&d) + 1), c);
+}
+
+/**
+    Calculates quotient and reminder of a / b, where [b] is a digit,
+    using normalized divisor d = b * 2^shift and its reciprocal [v],
+    returned by low_level_div_inverse(). Every digit of quotient
+    is calculated without division instruction. It is useful for
+    repeated division by the same digit.
+    Quotient saves to address [c], reminder is returned.
+    If [c] is NULL, then only reminder is calculated.
+
+    Restrictions:
+        1) length(a) > 0
+        2) highest bit of [d] must be set to 1
+        3) shift < BIG_INT_WORD_BITS_CNT and lower [shift] bits of [d] are zero
+        4) [c] must points to array with size length(a) or must be NULL.
+           Address [c] can be equal to [a]
+*/
+big_int_word low_level_divrem_1_preinv(const big_int_word *a, const big_int_word *a_end,
+                                       big_int_word d, size_t shift, big_int_word v,
+                                       big_int_word *c)
+{
+    big_int_word r, u0, q;
+    size_t i;
+
+    assert(a_end - a > 0);
+    assert((d >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
+    assert(shift < BIG_INT_WORD_BITS_CNT);
+
+    i = a_end - a;
+    if (shift == 0) {
+        r = 0;
+        while (i--) {
+            q = div_2by1(r, a[i], d, v, &r);
+            if (c != NULL) {
+                c[i] = q;
+            }
+        }
+        return r;
+    }
+
+    /* divide a * 2^shift by d, taking shifted digits of [a] on the fly */
+    r = (big_int_word) (a[i - 1] >> (BIG_INT_WORD_BITS_CNT - shift));
+    while (i--) {
+        u0 = (big_int_word) (a[i] << shift);
+        if (i > 0) {
+            u0 |= (big_int_word) (a[i - 1] >> (BIG_INT_WORD_BITS_CNT - shift));
+        }
+        q = div_2by1(r, u0, d, v, &r);
+        if (c != NULL) {
+            c[i] = q;
+        }
+    }
+    return (big_int_word) (r >> shift);
+}
+
+/**
+    Calculates quotient and reminder of a / b by schoolbook algorithm,
+    using reciprocal [v] of [b], returned by low_level_div_inverse().
+    Every digit of quotient is calculated by multiplications
+    without division instruction.
     Quotient saves to address [c], reminder - to address [a].
+    Higher digits of [a] after reminder are set to zero.
 
     Restrictions:
-        1) length(a) >= length(b) > 0
+        1) length(a) > length(b) > 0
         2) highest bit of [b] must be set to 1
-        3) a >= b
+        3) higher length(b) digits of [a] must be less than [b]
         4) address [a] cannot be equal to [b]
-        5) [c] must points to array with size length(a) - length(b) + 1
-        6) address [c] cannot be equal to [a] or [b].
+        5) [c] must points to array with size length(a) - length(b)
+        6) address [c] cannot be equal to [a] or [b]
 */
-void low_level_div(big_int_word *a, big_int_word *a_end,
-                   const big_int_word *b, const big_int_word *b_end,
-                   big_int_word *c, big_int_word *c_end)
+void low_level_div_preinv(big_int_word *a, big_int_word *a_end,
+                          const big_int_word *b, const big_int_word *b_end,
+                          big_int_word v, big_int_word *c, big_int_word *c_end)
 {
-    big_int_dword tmp1, tmp2, flag_c;
     big_int_word *aa, *cc;
-    const big_int_word *bb;
-    big_int_dword b_h, b_l, q, r;
+    big_int_word d1, d0, q, r1, r0, flag_c, flag_c1;
     size_t b_len = b_end - b;
 
-    assert(b_end - b > 0);
-    assert(a_end - a >= b_end - b);
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) == b_len + (c_end - c));
     assert((*(b_end - 1) >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
     assert(a != b);
     assert(c != a && c != b);
 
-    /*
-        a isn't actually used in the algorithm below.
-    */
-    (void)a;
-
-    aa = a_end;
+    aa = a_end - b_len - 1;
     cc = c_end;
+    d1 = *(b_end - 1);
+
     /*
         if size of [b] is 1, use simple algorithm for dividing
     */
     if (b_len == 1) {
-        b_l = *b;
-        tmp1 = *(--aa);
+        r0 = aa[1];
         do {
-            *aa = 0;
-            tmp1 <<= BIG_INT_WORD_BITS_CNT;
-            tmp1 |= *(--aa);
-            *(--cc) = BIG_INT_LO_WORD(tmp1 / b_l);
-            tmp1 %= b_l;
+            aa[1] = 0;
+            *(--cc) = div_2by1(r0, *aa, d1, v, &r0);
+            aa--;
         } while (cc > c);
-        *aa = BIG_INT_LO_WORD(tmp1);
+        *a = r0;
         return;
     }
 
     /*
-        size of [b] is greater than 1. Use another algorithm
+        size of [b] is greater than 1. Every digit of quotient is
+        calculated from three higher digits of [aa] and two higher
+        digits of [b], then corrected at most once
     */
-    b_h = *(b_end - 1);
-    b_l = *(b_end - 2);
+    d0 = *(b_end - 2);
     do {
-        /* calculate the guess of current digit of quotient */
-        tmp1 = *(--aa);
-        tmp1 <<= BIG_INT_WORD_BITS_CNT;
-        tmp1 |= *(aa - 1);
-        q = tmp1 / b_h;
-        r = tmp1 % b_h;
-        while (q > BIG_INT_MAX_WORD_NUM) {
-            q--;
-            r += b_h;
-        }
-        /* correct the guess of current digit of quotient */
-        if (r <= BIG_INT_MAX_WORD_NUM) {
-            tmp1 = b_l * q;
-            tmp2 = (r << BIG_INT_WORD_BITS_CNT) | *(aa - 2);
-            if (tmp1 > tmp2) {
-                q--;
-                tmp1 -= b_l;
-                tmp2 += b_h << BIG_INT_WORD_BITS_CNT;
-                r += b_h;
-                if (r <= BIG_INT_MAX_WORD_NUM && tmp1 > tmp2) {
-                    q--;
-                }
-            }
-        }
-        /* subtract b * q from [aa] */
-        if (q != 0) {
-            aa -= b_len;
-            bb = b;
-            tmp1 = 0;
+        if (aa[b_len] == d1 && aa[b_len - 1] == d0) {
+            /* quotient digit is B - 1 */
+            q = BIG_INT_MAX_WORD_NUM;
+            flag_c = low_level_submul_1(b, b + b_len, q, aa);
+            assert(aa[b_len] == flag_c);
+            aa[b_len] = 0;
+        } else {
+            q = div_3by2(aa[b_len], aa[b_len - 1], aa[b_len - 2], d1, d0, v, &r1, &r0);
+            /* subtract b * q from [aa], using known reminder of higher digits */
             flag_c = 0;
-            do {
-                tmp1 += *(bb++) * q;
-                tmp1 += flag_c;
-                flag_c = BIG_INT_LO_WORD(tmp1) > *aa ? 1 : 0;
-                *(aa++) -= BIG_INT_LO_WORD(tmp1);
-                tmp1 >>= BIG_INT_WORD_BITS_CNT;
-            } while (bb < b_end);
-            tmp1 += flag_c;
-            flag_c = BIG_INT_LO_WORD(tmp1) > *aa ? 1 : 0;
-            *aa = 0;
+            if (b_len > 2) {
+                flag_c = low_level_submul_1(b, b + b_len - 2, q, aa);
+            }
+            flag_c1 = (r0 < flag_c) ? 1 : 0;
+            r0 = (big_int_word) (r0 - flag_c);
+            flag_c = (r1 < flag_c1) ? 1 : 0;
+            r1 = (big_int_word) (r1 - flag_c1);
+            aa[b_len - 2] = r0;
+            aa[b_len - 1] = r1;
+            aa[b_len] = 0;
 
             /* do correction, if nessesary */
             if (flag_c) {
                 q--;
-                aa -= b_len;
-                bb = b;
-                tmp1 = 0;
-                do {
-                    tmp1 += *bb++;
-                    tmp1 += *aa;
-                    *(aa++) = BIG_INT_LO_WORD(tmp1);
-                    tmp1 >>= BIG_INT_WORD_BITS_CNT;
-                } while (bb < b_end);
+                low_level_addto(aa, aa + b_len, b, b_end);
             }
         }
-        *(--cc) = BIG_INT_LO_WORD(q);
+        *(--cc) = q;
+        aa--;
     } while (cc > c);
 }
+
+/**
+    Calculates quotient and reminder of a / b by schoolbook algorithm.
+    Quotient saves to address [c], reminder - to address [a].
+    Higher digits of [a] after reminder are set to zero.
+
+    Restrictions:
+        1) length(a) > length(b) > 0
+        2) highest bit of [b] must be set to 1
+        3) higher length(b) digits of [a] must be less than [b]
+        4) address [a] cannot be equal to [b]
+        5) [c] must points to array with size length(a) - length(b)
+        6) address [c] cannot be equal to [a] or [b].
+*/
+void low_level_div(big_int_word *a, big_int_word *a_end,
+                   const big_int_word *b, const big_int_word *b_end,
+                   big_int_word *c, big_int_word *c_end)
+{
+    low_level_div_preinv(a, a_end, b, b_end, low_level_div_inverse(b, b_end), c, c_end);
+}
@@ -0,0 +1,232 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+static big_int_word div_dc(big_int_word *a, const big_int_word *b, size_t n,
+                           big_int_word *q, size_t r, big_int_word *tmp);
+static size_t div_dc_tmp_len(size_t n, size_t r);
+
+/**
+    Private function.
+
+    Divides [a] with length n + r digits by [b] with length [n] digits
+    by Burnikel-Ziegler recursive algorithm:
+        a = (qh * B^r + q) * b + reminder,
+    where B = 2^BIG_INT_WORD_BITS_CNT. Quotient [q] has [r] digits,
+    higher digit [qh] of quotient (0 or 1) is returned.
+    Reminder is saved to [n] lower digits of [a].
+    Higher [r] digits of [a] are destroyed.
+
+    If r = n, then quotient is calculated by halves: the higher half
+    with the higher n + r / 2 digits of [a], then the lower half
+    with the reminder and the rest of [a].
+    If r < n, then the approximate quotient is calculated by recursive
+    dividing of the higher 2r digits of [a] by the higher [r] digits of [b].
+    Then the product of the approximate quotient by lower
+    digits of [b] is subtracted from [a]. The approximate quotient
+    can be greater than the real one at most by 2.
+
+    Restrictions:
+        1) 0 < r <= n
+        2) highest bit of [b] must be set to 1
+        3) a < 2 * b * B^r
+        4) [q] must points to array of size [r]
+        5) [tmp] must points to array of size, returned by
+           div_dc_tmp_len(n, r)
+*/
+static big_int_word div_dc(big_int_word *a, const big_int_word *b, size_t n,
+                           big_int_word *q, size_t r, big_int_word *tmp)
+{
+    big_int_word *t;
+    big_int_word qh, flag_c;
+    size_t lo, hi;
+
+    assert(r > 0);
+    assert(r <= n);
+
+    if (r < BIG_INT_BZ_DIV_THRESHOLD || n < BIG_INT_BZ_DIV_THRESHOLD) {
+        /* schoolbook division. low_level_div() needs higher digits of [a] less than [b] */
+        qh = 0;
+        if (low_level_cmp(a + r, b, n) >= 0) {
+            low_level_subfrom(a + r, a + r + n, b, b + n);
+            qh = 1;
+        }
+        low_level_div(a, a + n + r, b, b + n, q, q + r);
+        return qh;
+    }
+
+    if (r == n) {
+        lo = n / 2;
+        hi = n - lo;
+        qh = div_dc(a + lo, b, n, q + lo, hi, tmp);
+        flag_c = div_dc(a, b, n, q, lo, tmp);
+        assert(flag_c == 0);
+        (void) flag_c;
+        return qh;
+    }
+
+    /*
+        layout of [tmp]:
+            t = q * b_low - [n] digits
+            the rest is used by recursive calls and by low_level_fast_mul()
+    */
+    t = tmp;
+    tmp += n;
+
+    /* q = a_high / b_high, reminder is saved to a[n - r .. n - 1] */
+    qh = div_dc(a + n - r, b + n - r, r, q, r, tmp);
+
+    /* a = a - (qh * B^r + q) * b_low */
+    if (r >= n - r) {
+        low_level_fast_mul(q, q + r, b, b + n - r, t, tmp);
+    } else {
+        low_level_fast_mul(b, b + n - r, q, q + r, t, tmp);
+    }
+    flag_c = low_level_subfrom(a, a + n, t, t + n);
+    if (qh) {
+        flag_c += low_level_subfrom(a + r, a + n, b, b + n - r);
+    }
+
+    /* correct the quotient, while the reminder is negative */
+    while (flag_c) {
+        t = q;
+        while (!(*t)--) {
+            t++;
+            if (t == q + r) {
+                qh--;
+                break;
+            }
+        }
+        flag_c -= low_level_addto(a, a + n, b, b + n);
+    }
+
+    return qh;
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    div_dc() to divide number with length n + r digits by number
+    with length [n] digits.
+*/
+static size_t div_dc_tmp_len(size_t n, size_t r)
+{
+    size_t len, len1;
+
+    if (r < BIG_INT_BZ_DIV_THRESHOLD || n < BIG_INT_BZ_DIV_THRESHOLD) {
+        return 0;
+    }
+    if (r == n) {
+        len = div_dc_tmp_len(n, n - n / 2);
+        len1 = div_dc_tmp_len(n, n / 2);
+        return (len > len1) ? len : len1;
+    }
+
+    /* see layout of [tmp] in div_dc() */
+    len = div_dc_tmp_len(r, r);
+    if (r >= n - r) {
+        len1 = low_level_fast_mul_tmp_len(r, n - r);
+    } else {
+        len1 = low_level_fast_mul_tmp_len(n - r, r);
+    }
+    len = (len > len1) ? len : len1;
+
+    return n + len;
+}
+
+/**
+    Calculates quotient and reminder of a / b by Burnikel-Ziegler
+    recursive algorithm, which uses low_level_fast_mul() for
+    multiplying parts of quotient by parts of divisor.
+    Quotient saves to address [c], reminder - to address [a].
+    Higher digits of [a] after reminder are set to zero.
+
+    Quotient is calculated by blocks of length(b) digits, starting
+    from the highest one. Every block is calculated by recursive
+    dividing of 2 * length(b) digits of [a] by [b].
+
+    Restrictions:
+        1) length(a) > length(b) > 0
+        2) highest bit of [b] must be set to 1
+        3) higher length(b) digits of [a] must be less than [b]
+        4) address [a] cannot be equal to [b]
+        5) [c] must points to array with size length(a) - length(b)
+        6) address [c] cannot be equal to [a] or [b]
+        7) [tmp] must points to array of size, returned by
+           low_level_div_bz_tmp_len(length(a), length(b))
+*/
+void low_level_div_bz(big_int_word *a, big_int_word *a_end,
+                      const big_int_word *b, const big_int_word *b_end,
+                      big_int_word *c, big_int_word *c_end, big_int_word *tmp)
+{
+    size_t b_len, c_len, r;
+    big_int_word qh;
+
+    b_len = b_end - b;
+    c_len = c_end - c;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) == b_len + c_len);
+    assert((*(b_end - 1) >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
+    assert(a != b);
+    assert(c != a && c != b);
+    assert(low_level_cmp(a_end - b_len, b, b_len) < 0);
+
+    /* the highest block of quotient can be shorter than [b] */
+    r = c_len % b_len;
+    if (r == 0) {
+        r = b_len;
+    }
+    c_len -= r;
+    qh = div_dc(a + c_len, b, b_len, c + c_len, r, tmp);
+    assert(qh == 0);
+    while (c_len > 0) {
+        c_len -= b_len;
+        qh = div_dc(a + c_len, b, b_len, c + c_len, b_len, tmp);
+        assert(qh == 0);
+    }
+    (void) qh;
+    memset(a + b_len, 0, BIG_INT_WORD_BYTES_CNT * (a_end - a - b_len));
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_div_bz() to divide number with length [a_len]
+    by number with length [b_len].
+
+    Restrictions:
+        1) a_len > b_len > 0
+*/
+size_t low_level_div_bz_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t len, len1, r;
+
+    assert(a_len > b_len);
+    assert(b_len > 0);
+
+    /* see low_level_div_bz() */
+    r = (a_len - b_len) % b_len;
+    len = div_dc_tmp_len(b_len, b_len);
+    if (r) {
+        len1 = div_dc_tmp_len(b_len, r);
+        len = (len > len1) ? len : len1;
+    }
+
+    return len;
+}
@@ -0,0 +1,427 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+static void inc(big_int_word *a, big_int_word *a_end);
+static void dec(big_int_word *a, big_int_word *a_end);
+static void neg(big_int_word *a, big_int_word *a_end);
+static void mul_any(const big_int_word *a, size_t a_len,
+                    const big_int_word *b, size_t b_len,
+                    big_int_word *c, big_int_word *tmp);
+static size_t mul_any_tmp_len(size_t a_len, size_t b_len);
+static void div_block(big_int_word *a, const big_int_word *b, size_t n,
+                      const big_int_word *v, big_int_word *q, size_t r,
+                      big_int_word *tmp);
+static size_t div_block_tmp_len(size_t n, size_t r);
+
+/**
+    Private function.
+
+    Calculates
+        a = a + 1
+    Carry from the highest digit of [a] is lost.
+*/
+static void inc(big_int_word *a, big_int_word *a_end)
+{
+    while (a < a_end && !++(*a)) {
+        a++;
+    }
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a - 1
+    Borrow from the highest digit of [a] is lost.
+*/
+static void dec(big_int_word *a, big_int_word *a_end)
+{
+    while (a < a_end && !(*a)--) {
+        a++;
+    }
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = -a (mod B^length(a)),
+    where B = 2^BIG_INT_WORD_BITS_CNT.
+*/
+static void neg(big_int_word *a, big_int_word *a_end)
+{
+    big_int_word *aa;
+
+    for (aa = a; aa < a_end; aa++) {
+        *aa = ~*aa;
+    }
+    inc(a, a_end);
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a * b
+    for numbers with any lengths.
+
+    Restrictions are the same as for low_level_fast_mul(), except
+    length(a) >= length(b). [tmp] must points to array of size, returned by
+    low_level_fast_mul_tmp_len() for the longer and the shorter number.
+*/
+static void mul_any(const big_int_word *a, size_t a_len,
+                    const big_int_word *b, size_t b_len,
+                    big_int_word *c, big_int_word *tmp)
+{
+    if (a_len >= b_len) {
+        low_level_fast_mul(a, a + a_len, b, b + b_len, c, tmp);
+    } else {
+        low_level_fast_mul(b, b + b_len, a, a + a_len, c, tmp);
+    }
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    mul_any() to multiply numbers with lengths [a_len] and [b_len].
+*/
+static size_t mul_any_tmp_len(size_t a_len, size_t b_len)
+{
+    if (a_len >= b_len) {
+        return low_level_fast_mul_tmp_len(a_len, b_len);
+    }
+    return low_level_fast_mul_tmp_len(b_len, a_len);
+}
+
+/**
+    Calculates reciprocal of [b]:
+        c = floor(B^(2n) / b),
+    where B = 2^BIG_INT_WORD_BITS_CNT and n = length(b).
+    Then B^n < c <= 2 * B^n.
+
+    Reciprocal of [b] with length less than BIG_INT_NEWTON_DIV_THRESHOLD
+    digits is calculated by low_level_fast_div(). Reciprocal of longer
+    [b] is calculated by Newton's iteration
+        e = B^(n + h) - y * b
+        c = y * B^k + floor(y * e / B^(2h)),
+    where y is reciprocal of the higher h = n - k digits of [b],
+    calculated recursively. After the iteration [c] differs from
+    the exact reciprocal at most by a few units, which are corrected
+    by comparison of B^(2n) - c * b = e * B^k - (c - y * B^k) * b with [b].
+
+    Restrictions:
+        1) length(b) > 0
+        2) highest bit of [b] must be set to 1
+        3) [c] must points to array of size length(b) + 1
+        4) address [c] cannot be equal to [b]
+        5) [tmp] must points to array of size, returned by
+           low_level_recip_tmp_len(length(b))
+*/
+void low_level_recip(const big_int_word *b, const big_int_word *b_end,
+                     big_int_word *c, big_int_word *tmp)
+{
+    size_t n, h, k;
+    big_int_word *y, *e, *x, *d, *w;
+    big_int_word flag_c;
+    int e_neg;
+
+    n = b_end - b;
+
+    assert(n > 0);
+    assert((*(b_end - 1) >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
+    assert(c != b);
+
+    if (n < BIG_INT_NEWTON_DIV_THRESHOLD) {
+        /*
+            layout of [tmp]:
+                w = B^(2n) - [2n + 1] digits
+                the rest is used by low_level_fast_div()
+        */
+        w = tmp;
+        memset(w, 0, BIG_INT_WORD_BYTES_CNT * 2 * n);
+        w[2 * n] = 1;
+        low_level_fast_div(w, w + 2 * n + 1, b, b_end, c, c + n + 1, w + 2 * n + 1);
+        return;
+    }
+
+    /*
+        layout of [tmp]:
+            y = reciprocal of higher [h] digits of [b] - [h + 1] digits
+            e = B^(n + h) - y * b - [n + 2] digits
+            x = approximate reciprocal, then B^(2n) - x * b - [n + 2] digits
+            d = x - y * B^k - [k + 2] digits
+            w = products - [n + h + 2] digits
+            the rest is used by low_level_fast_mul()
+        The recursive call uses [tmp] after [y].
+    */
+    h = (n + 1) / 2;
+    k = n - h;
+    y = tmp;
+    e = y + h + 1;
+    x = e + n + 2;
+    d = x + n + 2;
+    w = d + k + 2;
+    tmp = w + n + h + 2;
+
+    low_level_recip(b + k, b_end, y, e);
+
+    /* e = B^(n + h) - y * b in two's complement form. abs(e) < 2 * B^n */
+    low_level_fast_mul(b, b_end, y, y + h + 1, w, tmp);
+    memcpy(e, w, BIG_INT_WORD_BYTES_CNT * (n + 2));
+    neg(e, e + n + 2);
+    if (h < 2) {
+        inc(e + n + h, e + n + 2);
+    }
+    e_neg = (int) (e[n + 1] >> (BIG_INT_WORD_BITS_CNT - 1));
+    if (e_neg) {
+        neg(e, e + n + 2);
+    }
+    assert(e[n + 1] == 0);
+
+    /* d = floor(y * abs(e) / B^(2h)) */
+    low_level_fast_mul(e, e + n + 1, y, y + h + 1, w, tmp);
+    memcpy(d, w + 2 * h, BIG_INT_WORD_BYTES_CNT * (k + 2));
+
+    /* x = y * B^k +- d */
+    memset(x, 0, BIG_INT_WORD_BYTES_CNT * (n + 2));
+    memcpy(x + k, y, BIG_INT_WORD_BYTES_CNT * (h + 1));
+    if (e_neg) {
+        flag_c = low_level_subfrom(x, x + n + 2, d, d + k + 2);
+    } else {
+        flag_c = low_level_addto(x, x + n + 2, d, d + k + 2);
+    }
+    assert(flag_c == 0);
+    assert(x[n + 1] == 0);
+    memcpy(c, x, BIG_INT_WORD_BYTES_CNT * (n + 1));
+
+    /* x = B^(2n) - c * b = +-(abs(e) * B^k - d * b) in two's complement form */
+    mul_any(b, n, d, k + 2, w, tmp);
+    memset(x, 0, BIG_INT_WORD_BYTES_CNT * k);
+    memcpy(x + k, e, BIG_INT_WORD_BYTES_CNT * (n + 2 - k));
+    low_level_subfrom(x, x + n + 2, w, w + n + 2);
+    if (e_neg) {
+        neg(x, x + n + 2);
+    }
+
+    /* correct the reciprocal, while 0 <= x < b is not true */
+    while (x[n + 1] >> (BIG_INT_WORD_BITS_CNT - 1)) {
+        dec(c, c + n + 1);
+        low_level_addto(x, x + n + 2, b, b_end);
+    }
+    while (x[n + 1] || x[n] || low_level_cmp(x, b, n) >= 0) {
+        inc(c, c + n + 1);
+        low_level_subfrom(x, x + n + 2, b, b_end);
+    }
+    (void) flag_c;
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_recip() to calculate reciprocal of number with length [b_len].
+
+    Restrictions:
+        1) b_len > 0
+*/
+size_t low_level_recip_tmp_len(size_t b_len)
+{
+    size_t n, h, k, len, len1;
+
+    assert(b_len > 0);
+
+    n = b_len;
+    if (n < BIG_INT_NEWTON_DIV_THRESHOLD) {
+        return 2 * n + 1 + low_level_fast_div_tmp_len(2 * n + 1, n);
+    }
+
+    /* see layout of [tmp] in low_level_recip() */
+    h = (n + 1) / 2;
+    k = n - h;
+    len = low_level_fast_mul_tmp_len(n, h + 1);
+    len1 = low_level_fast_mul_tmp_len(n + 1, h + 1);
+    len = (len > len1) ? len : len1;
+    len1 = mul_any_tmp_len(n, k + 2);
+    len = (len > len1) ? len : len1;
+    len += 3 * n + h + k + 8;
+    len1 = low_level_recip_tmp_len(h);
+    len = (len > len1) ? len : len1;
+
+    return h + 1 + len;
+}
+
+/**
+    Private function.
+
+    Divides [a] with length n + r digits by [b] with length [n] digits,
+    using reciprocal [v] of [b], calculated by low_level_recip().
+    Quotient is saved to [q] with length [r]. Reminder is saved to
+    [n] lower digits of [a], higher [r] digits of [a] are set to zero.
+
+    The approximate quotient is calculated as
+        floor(a_high * v_high / B^r),
+    where a_high is the higher [r] digits of [a] and v_high is the higher
+    r + 1 digits of [v]. It is less than the real quotient at most by 4.
+    The highest digit of [v] is 1 or 2, so only r * r digits are multiplied.
+
+    Restrictions:
+        1) 0 < r <= n
+        2) highest bit of [b] must be set to 1
+        3) higher [n] digits of [a] must be less than [b]
+        4) [q] must points to array of size [r]
+        5) [tmp] must points to array of size, returned by
+           div_block_tmp_len(n, r)
+*/
+static void div_block(big_int_word *a, const big_int_word *b, size_t n,
+                      const big_int_word *v, big_int_word *q, size_t r,
+                      big_int_word *tmp)
+{
+    big_int_word *p, *a_high;
+    big_int_word flag_c, i;
+
+    assert(r > 0);
+    assert(r <= n);
+    assert(v[n] == 1 || v[n] == 2);
+
+    /*
+        layout of [tmp]:
+            p = a_high * v_high, then q * b - [n + r + 1] digits
+            the rest is used by low_level_fast_mul()
+    */
+    p = tmp;
+    tmp += n + r + 1;
+
+    a_high = a + n;
+    low_level_fast_mul(a_high, a_high + r, v + n - r, v + n, p, tmp);
+    p[2 * r] = 0;
+    for (i = 0; i < v[n]; i++) {
+        flag_c = low_level_addto(p + r, p + 2 * r + 1, a_high, a_high + r);
+        assert(flag_c == 0);
+    }
+    assert(p[2 * r] == 0);
+    memcpy(q, p + r, BIG_INT_WORD_BYTES_CNT * r);
+
+    low_level_fast_mul(b, b + n, q, q + r, p, tmp);
+    flag_c = low_level_subfrom(a, a + n + r, p, p + n + r);
+    assert(flag_c == 0);
+    (void) flag_c;
+
+    /* the reminder is less than 5 * b, so only a[n] can be nonzero among higher digits */
+    while (a[n] || low_level_cmp(a, b, n) >= 0) {
+        low_level_subfrom(a, a + n + 1, b, b + n);
+        inc(q, q + r);
+    }
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    div_block() to divide number with length n + r digits by number
+    with length [n] digits.
+*/
+static size_t div_block_tmp_len(size_t n, size_t r)
+{
+    size_t len, len1;
+
+    /* see layout of [tmp] in div_block() */
+    len = low_level_fast_mul_tmp_len(r, r);
+    len1 = low_level_fast_mul_tmp_len(n, r);
+    len = (len > len1) ? len : len1;
+
+    return n + r + 1 + len;
+}
+
+/**
+    Calculates quotient and reminder of a / b, using reciprocal [v]
+    of [b], calculated by low_level_recip(). Every block of quotient
+    is calculated by two multiplications by low_level_fast_mul().
+    Quotient saves to address [c], reminder - to address [a].
+    Higher digits of [a] after reminder are set to zero.
+
+    Quotient is calculated by blocks of length(b) digits, starting
+    from the highest one.
+
+    Restrictions:
+        1) length(a) > length(b) > 0
+        2) highest bit of [b] must be set to 1
+        3) higher length(b) digits of [a] must be less than [b]
+        4) address [a] cannot be equal to [b]
+        5) [v] must points to array of size length(b) + 1, which
+           contains reciprocal of [b]
+        6) [c] must points to array with size length(a) - length(b)
+        7) address [c] cannot be equal to [a], [b] or [v]
+        8) [tmp] must points to array of size, returned by
+           low_level_div_newton_tmp_len(length(a), length(b))
+*/
+void low_level_div_newton(big_int_word *a, big_int_word *a_end,
+                          const big_int_word *b, const big_int_word *b_end,
+                          const big_int_word *v, big_int_word *c, big_int_word *c_end,
+                          big_int_word *tmp)
+{
+    size_t b_len, c_len, r;
+
+    b_len = b_end - b;
+    c_len = c_end - c;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) == b_len + c_len);
+    assert((*(b_end - 1) >> (BIG_INT_WORD_BITS_CNT - 1)) == 1);
+    assert(a != b);
+    assert(c != a && c != b && c != v);
+    assert(low_level_cmp(a_end - b_len, b, b_len) < 0);
+
+    /* the highest block of quotient can be shorter than [b] */
+    r = c_len % b_len;
+    if (r == 0) {
+        r = b_len;
+    }
+    c_len -= r;
+    div_block(a + c_len, b, b_len, v, c + c_len, r, tmp);
+    while (c_len > 0) {
+        c_len -= b_len;
+        div_block(a + c_len, b, b_len, v, c + c_len, b_len, tmp);
+    }
+    memset(a + b_len, 0, BIG_INT_WORD_BYTES_CNT * (a_end - a - b_len));
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_div_newton() to divide number with length [a_len]
+    by number with length [b_len].
+
+    Restrictions:
+        1) a_len > b_len > 0
+*/
+size_t low_level_div_newton_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t len, len1, r;
+
+    assert(a_len > b_len);
+    assert(b_len > 0);
+
+    /* see low_level_div_newton() */
+    r = (a_len - b_len) % b_len;
+    len = div_block_tmp_len(b_len, b_len);
+    if (r) {
+        len1 = div_block_tmp_len(b_len, r);
+        len = (len > len1) ? len : len1;
+    }
+
+    return len;
+}
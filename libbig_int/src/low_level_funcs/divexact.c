@@ -0,0 +1,394 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Exact division by odd divisor [b] works from the lower digits of
+    dividend (Hensel's division). Every digit of quotient is found as
+        q = a0 * b0^(-1) (mod B),
+    where B = 2^BIG_INT_WORD_BITS_CNT, so no quotient digit must be
+    estimated and corrected, like in low_level_div().
+*/
+
+static big_int_word word_inverse(big_int_word b0);
+static void divexact_schoolbook(big_int_word *c, const big_int_word *b, size_t b_len,
+                                size_t c_len);
+static void divexact_dc(big_int_word *c, const big_int_word *b, size_t b_len,
+                        size_t c_len, big_int_word *tmp);
+static size_t divexact_dc_tmp_len(size_t b_len, size_t c_len);
+static void neg(big_int_word *a, big_int_word *a_end);
+static void binvert(const big_int_word *b, size_t b_len, big_int_word *x, size_t n,
+                    big_int_word *tmp);
+static size_t binvert_tmp_len(size_t b_len, size_t n);
+
+/**
+    Private function.
+
+    Returns b0^(-1) (mod B) for odd digit [b0].
+*/
+static big_int_word word_inverse(big_int_word b0)
+{
+    return (big_int_word) (0 - low_level_mont_inverse(b0));
+}
+
+/**
+    Private function.
+
+    Calculates [c_len] lower digits of quotient a / b by Hensel's
+    schoolbook algorithm. [c] contains [c_len] lower digits of [a]
+    on input and is replaced by quotient. Only [c_len] lower digits
+    of [b] are used.
+
+    Restrictions:
+        1) [b] must be odd
+        2) [c] must points to array of size [c_len]
+*/
+static void divexact_schoolbook(big_int_word *c, const big_int_word *b, size_t b_len,
+                                size_t c_len)
+{
+    big_int_word inv, q, flag_c, tmp;
+    size_t i, j, len;
+
+    assert(b[0] & 1);
+
+    inv = word_inverse(b[0]);
+    if (b_len == 1) {
+        /* c[i] - flag_c = q * b[0] + (hi(q * b[0]) - flag_c) * B */
+        flag_c = 0;
+        for (i = 0; i < c_len; i++) {
+            tmp = c[i];
+            q = (big_int_word) ((big_int_dword) (big_int_word) (tmp - flag_c) * inv);
+            c[i] = q;
+            flag_c = (big_int_word) (BIG_INT_HI_WORD((big_int_dword) q * b[0]) + ((tmp < flag_c) ? 1 : 0));
+        }
+        return;
+    }
+
+    for (i = 0; i < c_len; i++) {
+        q = (big_int_word) ((big_int_dword) c[i] * inv);
+        len = c_len - i;
+        if (len > b_len) {
+            len = b_len;
+        }
+        flag_c = low_level_submul_1(b, b + len, q, c + i);
+        assert(c[i] == 0);
+        c[i] = q;
+        /* propagate borrow to the higher digits of reminder */
+        for (j = i + len; flag_c && j < c_len; j++) {
+            tmp = c[j];
+            c[j] = (big_int_word) (tmp - flag_c);
+            flag_c = (tmp < flag_c) ? 1 : 0;
+        }
+    }
+}
+
+/**
+    Private function.
+
+    Calculates [c_len] lower digits of quotient a / b by divide and
+    conquer Hensel's algorithm, like Burnikel-Ziegler division does
+    from the higher digits. Quotient [q0] of the lower half of [c] is
+    calculated recursively, then q0 * b is subtracted from the higher
+    half of [c], which is divided recursively too.
+    [c] contains [c_len] lower digits of [a] on input and is replaced
+    by quotient. Only [c_len] lower digits of [b] are used.
+
+    Restrictions:
+        1) [b] must be odd
+        2) [c] must points to array of size [c_len]
+        3) [tmp] must points to array of size, returned by
+           divexact_dc_tmp_len(b_len, c_len)
+
+    Layout of [tmp]:
+        p[c_len] - lower digits of q0 * b
+        tmp for low_level_mul_low() and recursive calls
+*/
+static void divexact_dc(big_int_word *c, const big_int_word *b, size_t b_len,
+                        size_t c_len, big_int_word *tmp)
+{
+    size_t lo, len;
+
+    if (b_len < BIG_INT_DIVEXACT_THRESHOLD || c_len < BIG_INT_DIVEXACT_THRESHOLD) {
+        divexact_schoolbook(c, b, b_len, c_len);
+        return;
+    }
+
+    lo = c_len - c_len / 2;
+    divexact_dc(c, b, b_len, lo, tmp);
+
+    len = (b_len < c_len) ? b_len : c_len;
+    low_level_mul_low(c, c + lo, b, b + len, tmp, c_len, tmp + c_len);
+    low_level_subfrom(c + lo, c + c_len, tmp + lo, tmp + c_len);
+
+    divexact_dc(c + lo, b, b_len, c_len - lo, tmp);
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for divexact_dc()
+*/
+static size_t divexact_dc_tmp_len(size_t b_len, size_t c_len)
+{
+    size_t lo, len, tmp_len, tmp_len1;
+
+    if (b_len < BIG_INT_DIVEXACT_THRESHOLD || c_len < BIG_INT_DIVEXACT_THRESHOLD) {
+        return 0;
+    }
+
+    lo = c_len - c_len / 2;
+    len = (b_len < c_len) ? b_len : c_len;
+    tmp_len = c_len + low_level_mul_low_tmp_len(lo, len, c_len);
+    tmp_len1 = divexact_dc_tmp_len(b_len, lo);
+    if (tmp_len1 > tmp_len) {
+        tmp_len = tmp_len1;
+    }
+    return tmp_len;
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = -a (mod B^length(a))
+*/
+static void neg(big_int_word *a, big_int_word *a_end)
+{
+    while (a < a_end && *a == 0) {
+        a++;
+    }
+    if (a < a_end) {
+        *a = (big_int_word) (0 - *a);
+        a++;
+        while (a < a_end) {
+            *a = (big_int_word) ~(*a);
+            a++;
+        }
+    }
+}
+
+/**
+    Private function.
+
+    Calculates 2-adic inverse of [b]:
+        x = b^(-1) (mod B^n)
+    Inverse with k = ceil(n / 2) digits is calculated recursively, then
+    it is lifted to [n] digits by Newton's iteration
+        x = x + x * (1 - b * x),
+    which doubles number of correct digits of [x]. Short inverses
+    are calculated by Hensel's schoolbook division of 1 by [b].
+
+    Restrictions:
+        1) [b] must be odd
+        2) [x] must points to array of size [n]
+        3) [tmp] must points to array of size, returned by
+           binvert_tmp_len(b_len, n)
+
+    Layout of [tmp]:
+        e[n] - lower digits of b * x
+        tmp for low_level_mul_low() and recursive call
+*/
+static void binvert(const big_int_word *b, size_t b_len, big_int_word *x, size_t n,
+                    big_int_word *tmp)
+{
+    big_int_word *e;
+    size_t k, len;
+
+    assert(b[0] & 1);
+    assert(n > 0);
+
+    e = tmp;
+    tmp += n;
+
+    if (n < BIG_INT_DIVEXACT_THRESHOLD) {
+        memset(x, 0, BIG_INT_WORD_BYTES_CNT * n);
+        x[0] = 1;
+        divexact_schoolbook(x, b, b_len, n);
+        return;
+    }
+
+    k = n - n / 2;
+    binvert(b, b_len, x, k, tmp);
+
+    /*
+        e = b * x (mod B^n). Lower [k] digits of [e] are (1, 0, ..., 0),
+        so 1 - b * x = -e[k..n) * B^k (mod B^n)
+    */
+    len = (b_len < n) ? b_len : n;
+    low_level_mul_low(b, b + len, x, x + k, e, n, tmp);
+    neg(e + k, e + n);
+    low_level_mul_low(x, x + n - k, e + k, e + n, x + k, n - k, tmp);
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for binvert()
+*/
+static size_t binvert_tmp_len(size_t b_len, size_t n)
+{
+    size_t k, len, tmp_len, tmp_len1;
+
+    if (n < BIG_INT_DIVEXACT_THRESHOLD) {
+        return 0;
+    }
+
+    k = n - n / 2;
+    len = (b_len < n) ? b_len : n;
+    tmp_len = binvert_tmp_len(b_len, k);
+    tmp_len1 = low_level_mul_low_tmp_len(len, k, n);
+    if (tmp_len1 > tmp_len) {
+        tmp_len = tmp_len1;
+    }
+    tmp_len1 = low_level_mul_low_tmp_len(n - k, n - k, n - k);
+    if (tmp_len1 > tmp_len) {
+        tmp_len = tmp_len1;
+    }
+    return n + tmp_len;
+}
+
+/**
+    Divides [a] by [b], if [a] is divisible by [b]:
+        c = a / b
+    If [a] isn't divisible by [b], then [c] is undefined.
+
+    Uses Hensel's schoolbook division, if lengths of divisor and
+    quotient are less than BIG_INT_DIVEXACT_THRESHOLD digits,
+    else multiplies [a] by 2-adic inverse of [b], calculated
+    by Newton's iteration.
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+        2) [b] must be odd
+        3) [c] must points to array of size length(a) - length(b) + 1
+        4) address [c] cannot be equal to [a] or [b]
+        5) [tmp] must points to array of size, returned by
+           low_level_divexact_tmp_len(length(a), length(b))
+
+    Layout of [tmp] for Newton's iteration:
+        x[c_len] - 2-adic inverse of [b]
+        tmp for binvert() and low_level_mul_low()
+*/
+void low_level_divexact(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len, c_len;
+    big_int_word *x;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(b[0] & 1);
+    assert(c != a && c != b);
+
+    c_len = a_len - b_len + 1;
+    if (b_len >= BIG_INT_NEWTON_DIV_THRESHOLD && c_len >= BIG_INT_NEWTON_DIV_THRESHOLD) {
+        /* c = a * b^(-1) (mod B^c_len) */
+        x = tmp;
+        tmp += c_len;
+        binvert(b, b_len, x, c_len, tmp);
+        low_level_mul_low(a, a + c_len, x, x + c_len, c, c_len, tmp);
+        return;
+    }
+
+    memcpy(c, a, BIG_INT_WORD_BYTES_CNT * c_len);
+    divexact_dc(c, b, b_len, c_len, tmp);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_divexact() to divide number with length [a_len]
+    by number with length [b_len]. Returned value can be zero.
+
+    Restrictions:
+        1) a_len >= b_len > 0
+*/
+size_t low_level_divexact_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t c_len, len, len1;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+
+    c_len = a_len - b_len + 1;
+    if (b_len >= BIG_INT_NEWTON_DIV_THRESHOLD && c_len >= BIG_INT_NEWTON_DIV_THRESHOLD) {
+        len = binvert_tmp_len(b_len, c_len);
+        len1 = low_level_mul_low_tmp_len(c_len, c_len, c_len);
+        return c_len + ((len > len1) ? len : len1);
+    }
+    return divexact_dc_tmp_len(b_len, c_len);
+}
+
+/**
+    Checks, whether [a] is divisible by [b].
+    Subtracts from [a] multiples of [b], which zero lower digits of [a],
+    like Hensel's division does. [a] is divisible by [b] if and only if
+    the result is zero.
+
+    Returns non-zero value, if [a] is divisible by [b], else returns 0.
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+        2) [b] must be odd
+        3) [tmp] must points to array of size length(a) + 1
+*/
+int low_level_divisible(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *tmp)
+{
+    big_int_word inv, q, flag_c, t;
+    size_t a_len, b_len, i, j;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(b[0] & 1);
+
+    /*
+        a - q * b > -B^(a_len + 1), where q < B^(a_len - b_len + 1)
+        is the Hensel's quotient, so (a_len + 1) digits is enough
+        to distinguish zero reminder from non-zero
+    */
+    memcpy(tmp, a, BIG_INT_WORD_BYTES_CNT * a_len);
+    tmp[a_len] = 0;
+    inv = word_inverse(b[0]);
+    for (i = 0; i <= a_len - b_len; i++) {
+        q = (big_int_word) ((big_int_dword) tmp[i] * inv);
+        if (q == 0) {
+            continue;
+        }
+        flag_c = low_level_submul_1(b, b_end, q, tmp + i);
+        assert(tmp[i] == 0);
+        for (j = i + b_len; flag_c && j <= a_len; j++) {
+            t = tmp[j];
+            tmp[j] = (big_int_word) (t - flag_c);
+            flag_c = (t < flag_c) ? 1 : 0;
+        }
+    }
+    for (i = a_len - b_len + 1; i <= a_len; i++) {
+        if (tmp[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
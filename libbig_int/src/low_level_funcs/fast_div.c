@@ -0,0 +1,129 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Division algorithms, which can be chosen by low_level_fast_div()
+*/
+typedef enum {
+    DIV_SCHOOLBOOK,
+    DIV_BZ,
+    DIV_NEWTON
+} div_algorithm;
+
+static div_algorithm choose_div_algorithm(size_t b_len, size_t c_len);
+
+/**
+    Private function.
+
+    Returns the fastest division algorithm for divisor with length [b_len]
+    and quotient with length [c_len].
+*/
+static div_algorithm choose_div_algorithm(size_t b_len, size_t c_len)
+{
+    if (b_len >= BIG_INT_NEWTON_DIV_THRESHOLD && c_len >= BIG_INT_NEWTON_DIV_THRESHOLD) {
+        return DIV_NEWTON;
+    }
+    if (b_len >= BIG_INT_BZ_DIV_THRESHOLD && c_len >= BIG_INT_BZ_DIV_THRESHOLD) {
+        return DIV_BZ;
+    }
+    return DIV_SCHOOLBOOK;
+}
+
+/**
+    Calculates quotient and reminder of a / b.
+    Quotient saves to address [c], reminder - to address [a].
+    Higher digits of [a] after reminder are set to zero.
+
+    Chooses the fastest division algorithm depending on
+    length of numbers:
+        - schoolbook low_level_div(), if length of divisor or length
+          of quotient is less than BIG_INT_BZ_DIV_THRESHOLD digits
+        - low_level_div_bz(), if length of divisor or length of quotient
+          is less than BIG_INT_NEWTON_DIV_THRESHOLD digits
+        - low_level_div_newton() with reciprocal of divisor, calculated
+          by low_level_recip(), for longer numbers
+
+    Restrictions:
+        1) length(a) > length(b) > 0
+        2) highest bit of [b] must be set to 1
+        3) higher length(b) digits of [a] must be less than [b]
+        4) address [a] cannot be equal to [b]
+        5) [c] must points to array with size length(a) - length(b)
+        6) address [c] cannot be equal to [a] or [b]
+        7) [tmp] must points to array of size, returned by
+           low_level_fast_div_tmp_len(length(a), length(b))
+*/
+void low_level_fast_div(big_int_word *a, big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *c_end, big_int_word *tmp)
+{
+    size_t b_len;
+
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) > b_len);
+
+    switch (choose_div_algorithm(b_len, c_end - c)) {
+    case DIV_NEWTON:
+        /*
+            layout of [tmp]:
+                reciprocal of [b] - [b_len + 1] digits
+                the rest is used by low_level_recip() and low_level_div_newton()
+        */
+        low_level_recip(b, b_end, tmp, tmp + b_len + 1);
+        low_level_div_newton(a, a_end, b, b_end, tmp, c, c_end, tmp + b_len + 1);
+        break;
+    case DIV_BZ:
+        low_level_div_bz(a, a_end, b, b_end, c, c_end, tmp);
+        break;
+    default:
+        low_level_div(a, a_end, b, b_end, c, c_end);
+        break;
+    }
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_fast_div() to divide number with length [a_len]
+    by number with length [b_len]. Returned value can be zero.
+
+    Restrictions:
+        1) a_len > b_len > 0
+*/
+size_t low_level_fast_div_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t len, len1;
+
+    assert(b_len > 0);
+    assert(a_len > b_len);
+
+    switch (choose_div_algorithm(b_len, a_len - b_len)) {
+    case DIV_NEWTON:
+        /* see layout of [tmp] in low_level_fast_div() */
+        len = low_level_recip_tmp_len(b_len);
+        len1 = low_level_div_newton_tmp_len(a_len, b_len);
+        len = (len > len1) ? len : len1;
+        return b_len + 1 + len;
+    case DIV_BZ:
+        return low_level_div_bz_tmp_len(a_len, b_len);
+    default:
+        break;
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Multiplication algorithms, which can be chosen by low_level_fast_mul()
+*/
+typedef enum {
+    MUL_SCHOOLBOOK,
+    MUL_KARATSUBA,
+    MUL_TOOM3,
+    MUL_TOOM4,
+    MUL_NTT,
+    MUL_IFMA,
+    MUL_UNBALANCED
+} mul_algorithm;
+
+static mul_algorithm choose_mul_algorithm(size_t a_len, size_t b_len);
+static void mul_unbalanced(const big_int_word *a, const big_int_word *a_end,
+                           const big_int_word *b, const big_int_word *b_end,
+                           big_int_word *c, big_int_word *tmp);
+
+/**
+    Private function.
+
+    Returns the fastest multiplication algorithm for numbers
+    with lengths [a_len] and [b_len], where a_len >= b_len.
+    Toom-Cook algorithms are used only for numbers with close lengths.
+    If lengths are too different, returns MUL_UNBALANCED.
+    NTT is used for any lengths, which it supports.
+    AVX-512 IFMA kernel is used for numbers with lengths from
+    BIG_INT_IFMA_MIN_LEN to BIG_INT_IFMA_MAX_LEN, if the processor supports it.
+*/
+static mul_algorithm choose_mul_algorithm(size_t a_len, size_t b_len)
+{
+#if defined(BIG_INT_X86_64_IFMA)
+    if ((low_level_cpu_features & LOW_LEVEL_CPU_IFMA) &&
+        b_len >= BIG_INT_IFMA_MIN_LEN && a_len <= BIG_INT_IFMA_MAX_LEN) {
+        return MUL_IFMA;
+    }
+#endif
+    if (b_len < BIG_INT_KARATSUBA_MUL_THRESHOLD) {
+        return MUL_SCHOOLBOOK;
+    }
+    if (b_len >= BIG_INT_NTT_MUL_THRESHOLD && a_len + b_len <= BIG_INT_NTT_MAX_LEN) {
+        return MUL_NTT;
+    }
+    if (b_len >= BIG_INT_TOOM4_MUL_THRESHOLD && b_len > 3 * ((a_len + 3) / 4)) {
+        return MUL_TOOM4;
+    }
+    if (b_len >= BIG_INT_TOOM3_MUL_THRESHOLD && b_len > 2 * ((a_len + 2) / 3)) {
+        return MUL_TOOM3;
+    }
+    if (b_len > (a_len + 1) / 2) {
+        return MUL_KARATSUBA;
+    }
+    return MUL_UNBALANCED;
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a * b,
+    where [a] is much longer than [b]. [a] is splitted into pieces with length(b)
+    digits, then every piece is multiplied by [b] using low_level_fast_mul().
+
+    Restrictions are the same as for low_level_fast_mul()
+*/
+static void mul_unbalanced(const big_int_word *a, const big_int_word *a_end,
+                           const big_int_word *b, const big_int_word *b_end,
+                           big_int_word *c, big_int_word *tmp)
+{
+    size_t b_len, len;
+    const big_int_word *aa;
+    big_int_word *cc, *p;
+    big_int_word flag_c;
+
+    b_len = b_end - b;
+    p = tmp;
+    tmp += 2 * b_len;
+
+    low_level_fast_mul(a, a + b_len, b, b_end, c, tmp);
+    aa = a + b_len;
+    cc = c + b_len;
+    while (aa < a_end) {
+        len = a_end - aa;
+        if (len >= b_len) {
+            len = b_len;
+            low_level_fast_mul(aa, aa + len, b, b_end, p, tmp);
+        } else {
+            low_level_fast_mul(b, b_end, aa, aa + len, p, tmp);
+        }
+        /*
+            [cc] contains [b_len] higher digits of the previous product.
+            Add the current product [p] to it.
+        */
+        memcpy(cc + b_len, p + b_len, BIG_INT_WORD_BYTES_CNT * len);
+        flag_c = low_level_addto(cc, cc + b_len + len, p, p + b_len);
+        assert(flag_c == 0);
+        (void) flag_c;
+        aa += len;
+        cc += len;
+    }
+}
+
+/**
+    Calculates
+        c = a * b
+
+    Chooses the fastest multiplication algorithm depending on
+    length of numbers:
+        - schoolbook low_level_mul() for numbers, shorter than
+          BIG_INT_KARATSUBA_MUL_THRESHOLD digits
+        - low_level_mul_karatsuba() for numbers, shorter than
+          BIG_INT_TOOM3_MUL_THRESHOLD digits
+        - low_level_mul_toom3() for numbers, shorter than
+          BIG_INT_TOOM4_MUL_THRESHOLD digits
+        - low_level_mul_toom4() for numbers, shorter than
+          BIG_INT_NTT_MUL_THRESHOLD digits
+        - low_level_mul_ntt() for longer numbers
+    On processors with AVX-512 IFMA extension low_level_mul_ifma()
+    is used for numbers with lengths from BIG_INT_IFMA_MIN_LEN
+    to BIG_INT_IFMA_MAX_LEN digits.
+    If length(a) is much greater than length(b), then [a] is splitted
+    into pieces with length(b) digits.
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+        2) [c] must points to array of size length(a) + length(b)
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_fast_mul_tmp_len(length(a), length(b))
+*/
+void low_level_fast_mul(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(a != c);
+    assert(b != c);
+
+    switch (choose_mul_algorithm(a_len, b_len)) {
+    case MUL_SCHOOLBOOK:
+        low_level_mul(a, a_end, b, b_end, c);
+        break;
+    case MUL_KARATSUBA:
+        low_level_mul_karatsuba(a, a_end, b, b_end, c, tmp);
+        break;
+    case MUL_TOOM3:
+        low_level_mul_toom3(a, a_end, b, b_end, c, tmp);
+        break;
+    case MUL_TOOM4:
+        low_level_mul_toom4(a, a_end, b, b_end, c, tmp);
+        break;
+    case MUL_NTT:
+        low_level_mul_ntt(a, a_end, b, b_end, c, tmp);
+        break;
+#if defined(BIG_INT_X86_64_IFMA)
+    case MUL_IFMA:
+        low_level_mul_ifma(a, a_end, b, b_end, c, tmp);
+        break;
+#endif
+    default:
+        mul_unbalanced(a, a_end, b, b_end, c, tmp);
+        break;
+    }
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_fast_mul() to multiply numbers with lengths [a_len] and [b_len].
+    Returned value can be zero.
+
+    Restrictions:
+        1) a_len >= b_len > 0
+*/
+size_t low_level_fast_mul_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t len, len1;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+
+    switch (choose_mul_algorithm(a_len, b_len)) {
+    case MUL_SCHOOLBOOK:
+        return 0;
+    case MUL_KARATSUBA:
+        return low_level_mul_karatsuba_tmp_len(a_len, b_len);
+    case MUL_TOOM3:
+        return low_level_mul_toom3_tmp_len(a_len, b_len);
+    case MUL_TOOM4:
+        return low_level_mul_toom4_tmp_len(a_len, b_len);
+    case MUL_NTT:
+        return low_level_mul_ntt_tmp_len(a_len, b_len);
+#if defined(BIG_INT_X86_64_IFMA)
+    case MUL_IFMA:
+        return low_level_mul_ifma_tmp_len(a_len, b_len);
+#endif
+    default:
+        break;
+    }
+    /* see mul_unbalanced() */
+    len = low_level_fast_mul_tmp_len(b_len, b_len);
+    if (a_len % b_len) {
+        len1 = low_level_fast_mul_tmp_len(b_len, a_len % b_len);
+        len = (len > len1) ? len : len1;
+    }
+    return 2 * b_len + len;
+}
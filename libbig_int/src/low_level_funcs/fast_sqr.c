@@ -0,0 +1,149 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Squaring algorithms, which can be chosen by low_level_fast_sqr()
+*/
+typedef enum {
+    SQR_SCHOOLBOOK,
+    SQR_KARATSUBA,
+    SQR_TOOM3,
+    SQR_TOOM4,
+    SQR_NTT,
+    SQR_IFMA
+} sqr_algorithm;
+
+static sqr_algorithm choose_sqr_algorithm(size_t a_len);
+
+/**
+    Private function.
+
+    Returns the fastest squaring algorithm for number with length [a_len]
+*/
+static sqr_algorithm choose_sqr_algorithm(size_t a_len)
+{
+#if defined(BIG_INT_X86_64_IFMA)
+    if ((low_level_cpu_features & LOW_LEVEL_CPU_IFMA) &&
+        a_len >= BIG_INT_IFMA_MIN_LEN && a_len <= BIG_INT_IFMA_MAX_LEN) {
+        return SQR_IFMA;
+    }
+#endif
+    if (a_len < BIG_INT_KARATSUBA_SQR_THRESHOLD) {
+        return SQR_SCHOOLBOOK;
+    }
+    if (a_len >= BIG_INT_NTT_SQR_THRESHOLD && 2 * a_len <= BIG_INT_NTT_MAX_LEN) {
+        return SQR_NTT;
+    }
+    if (a_len >= BIG_INT_TOOM4_SQR_THRESHOLD && a_len > 3 * ((a_len + 3) / 4)) {
+        return SQR_TOOM4;
+    }
+    if (a_len >= BIG_INT_TOOM3_SQR_THRESHOLD && a_len > 2 * ((a_len + 2) / 3)) {
+        return SQR_TOOM3;
+    }
+    return SQR_KARATSUBA;
+}
+
+/**
+    Calculates
+        c = a * a
+
+    Chooses the fastest squaring algorithm depending on
+    length of number:
+        - schoolbook low_level_sqr() for numbers, shorter than
+          BIG_INT_KARATSUBA_SQR_THRESHOLD digits
+        - low_level_sqr_karatsuba() for numbers, shorter than
+          BIG_INT_TOOM3_SQR_THRESHOLD digits
+        - low_level_sqr_toom3() for numbers, shorter than
+          BIG_INT_TOOM4_SQR_THRESHOLD digits
+        - low_level_sqr_toom4() for numbers, shorter than
+          BIG_INT_NTT_SQR_THRESHOLD digits
+        - low_level_sqr_ntt() for longer numbers
+    On processors with AVX-512 IFMA extension low_level_sqr_ifma()
+    is used for numbers with lengths from BIG_INT_IFMA_MIN_LEN
+    to BIG_INT_IFMA_MAX_LEN digits.
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size 2 * length(a)
+        3) address [c] cannot be equal to [a]
+        4) [tmp] must points to array of size, returned by
+           low_level_fast_sqr_tmp_len(length(a))
+*/
+void low_level_fast_sqr(const big_int_word *a, const big_int_word *a_end,
+                        big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len;
+
+    a_len = a_end - a;
+
+    assert(a_len > 0);
+    assert(a != c);
+
+    switch (choose_sqr_algorithm(a_len)) {
+    case SQR_SCHOOLBOOK:
+        low_level_sqr(a, a_end, c);
+        break;
+    case SQR_KARATSUBA:
+        low_level_sqr_karatsuba(a, a_end, c, tmp);
+        break;
+    case SQR_TOOM3:
+        low_level_sqr_toom3(a, a_end, c, tmp);
+        break;
+    case SQR_TOOM4:
+        low_level_sqr_toom4(a, a_end, c, tmp);
+        break;
+#if defined(BIG_INT_X86_64_IFMA)
+    case SQR_IFMA:
+        low_level_sqr_ifma(a, a_end, c, tmp);
+        break;
+#endif
+    default:
+        low_level_sqr_ntt(a, a_end, c, tmp);
+        break;
+    }
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_fast_sqr() to square number with length [a_len].
+    Returned value can be zero.
+
+    Restrictions:
+        1) a_len > 0
+*/
+size_t low_level_fast_sqr_tmp_len(size_t a_len)
+{
+    assert(a_len > 0);
+
+    switch (choose_sqr_algorithm(a_len)) {
+    case SQR_SCHOOLBOOK:
+        return 0;
+    case SQR_KARATSUBA:
+        return low_level_sqr_karatsuba_tmp_len(a_len);
+    case SQR_TOOM3:
+        return low_level_sqr_toom3_tmp_len(a_len);
+    case SQR_TOOM4:
+        return low_level_sqr_toom4_tmp_len(a_len);
+#if defined(BIG_INT_X86_64_IFMA)
+    case SQR_IFMA:
+        return low_level_sqr_ifma_tmp_len(a_len);
+#endif
+    default:
+        return low_level_sqr_ntt_tmp_len(a_len);
+    }
+}
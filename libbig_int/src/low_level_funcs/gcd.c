@@ -0,0 +1,283 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy */
+#include "big_int.h"
+#include "low_level_funcs.h"
+#include "get_bit_length.h"
+
+/*
+    Lehmer's GCD algorithm (Knuth, TAOCP vol. 2, 4.5.2, algorithm L).
+    Quotients of Euclid's algorithm are found by leading bits of
+    numbers only, while they are guaranteed to be the same as quotients
+    of the full numbers. Then all these steps are applied to the full
+    numbers at once, by multiplication by 2x2 matrix
+        |  A  B |
+        |  C  D |
+    where
+        u' = A * u + B * v
+        v' = C * u + D * v
+    Signs of matrix elements are alternated with every step, so only
+    their absolute values are stored in array m[] = {|A|, |B|, |C|, |D|}.
+    After even number of steps A >= 0, B <= 0, C <= 0, D >= 0.
+    After odd number of steps A <= 0, B >= 0, C >= 0, D <= 0.
+*/
+
+/* length (in bits) of leading parts of numbers, used by low_level_gcd_lehmer() */
+#define LEHMER_BITS_CNT (2 * BIG_INT_WORD_BITS_CNT - 1)
+
+static big_int_dword top_bits(const big_int_word *a, size_t len, size_t n_bit);
+static big_int_dword quotient(big_int_dword x, big_int_dword y);
+static big_int_word lin_comb(const big_int_word *a, big_int_word x,
+                             const big_int_word *b, big_int_word y,
+                             size_t len, big_int_word *c);
+
+/**
+    Private function.
+
+    Returns LEHMER_BITS_CNT bits of [a] starting from [n_bit] bit.
+    Digits of [a] higher than [len] are treated as zeros.
+*/
+static big_int_dword top_bits(const big_int_word *a, size_t len, size_t n_bit)
+{
+    big_int_word a0, a1, a2;
+    big_int_dword n;
+    size_t i, shift;
+
+    i = n_bit / BIG_INT_WORD_BITS_CNT;
+    shift = n_bit % BIG_INT_WORD_BITS_CNT;
+    a0 = (i < len) ? a[i] : 0;
+    a1 = (i + 1 < len) ? a[i + 1] : 0;
+    a2 = (i + 2 < len) ? a[i + 2] : 0;
+
+    n = (big_int_dword) a0 >> shift;
+    n |= (big_int_dword) ((big_int_dword) a1 << (BIG_INT_WORD_BITS_CNT - shift));
+    if (shift) {
+        n |= (big_int_dword) ((big_int_dword) a2 << (2 * BIG_INT_WORD_BITS_CNT - shift));
+    }
+    return (big_int_dword) (n & (((big_int_dword) 1 << LEHMER_BITS_CNT) - 1));
+}
+
+/**
+    Private function.
+
+    Returns x / y. Quotients of Euclid's algorithm are usually small,
+    so they are checked before the division.
+
+    Restrictions:
+        1) y > 0
+*/
+static big_int_dword quotient(big_int_dword x, big_int_dword y)
+{
+    if (x < y) {
+        return 0;
+    }
+    x = (big_int_dword) (x - y);
+    if (x < y) {
+        return 1;
+    }
+    return (big_int_dword) (x / y + 1);
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a * x - b * y
+    Returns the highest digit of the result.
+
+    Restrictions:
+        1) [a], [b], [c] must points to arrays of size [len] > 0
+        2) a * x - b * y must be not negative
+*/
+static big_int_word lin_comb(const big_int_word *a, big_int_word x,
+                             const big_int_word *b, big_int_word y,
+                             size_t len, big_int_word *c)
+{
+    big_int_word flag_c;
+
+    flag_c = low_level_mul_1(a, a + len, x, c);
+    flag_c = (big_int_word) (flag_c - low_level_submul_1(b, b + len, y, c));
+
+    return flag_c;
+}
+
+/**
+    Simulates up to [max_steps] steps of Euclid's algorithm for numbers
+    [u] and [v], using their leading bits only. Stores absolute values of
+    elements of matrix, which applies these steps, to m[4].
+    Elements of the matrix are not greater than BIG_INT_MAX_WORD_NUM.
+    Returns number of simulated steps. If it is zero, then quotient
+    of the next step cannot be found by leading bits, so it must be
+    found by full division.
+
+    Restrictions:
+        1) [u] and [v] must points to arrays of size [len] > 0
+        2) u >= v, the highest digit of [u] isn't zero
+        3) [m] must points to array of size 4
+*/
+size_t low_level_gcd_lehmer(const big_int_word *u, const big_int_word *v, size_t len,
+                            size_t max_steps, big_int_word *m)
+{
+    big_int_dword uu, vv, a, b, c, d, x1, y1, x2, y2, q, t;
+    size_t n_bits, n_steps;
+
+    assert(len > 0);
+    assert(u[len - 1] != 0);
+
+    /* leading bits of [u] and [v] at the same position */
+    n_bits = (len - 1) * BIG_INT_WORD_BITS_CNT + get_bit_length(u[len - 1]);
+    n_bits = (n_bits > LEHMER_BITS_CNT) ? n_bits - LEHMER_BITS_CNT : 0;
+    uu = top_bits(u, len, n_bits);
+    vv = top_bits(v, len, n_bits);
+
+    a = 1;
+    b = 0;
+    c = 0;
+    d = 1;
+    n_steps = 0;
+    while (n_steps < max_steps) {
+        /*
+            The quotient of the full numbers lies between
+            (uu + A) / (vv + C) and (uu + B) / (vv + D)
+        */
+        if (n_steps & 1) {
+            if (uu < a || vv < d) {
+                break;
+            }
+            x1 = uu - a;
+            y1 = vv + c;
+            x2 = uu + b;
+            y2 = vv - d;
+        } else {
+            if (uu < b || vv < c) {
+                break;
+            }
+            x1 = uu + a;
+            y1 = vv - c;
+            x2 = uu - b;
+            y2 = vv + d;
+        }
+        if (y1 == 0 || y2 == 0) {
+            break;
+        }
+        q = quotient(x1, y1);
+        if (q > BIG_INT_MAX_WORD_NUM || q != quotient(x2, y2)) {
+            /* quotients are too big or different */
+            break;
+        }
+
+        /* elements of the matrix must fit to digit */
+        t = a + q * c;
+        x1 = b + q * d;
+        if (BIG_INT_HI_WORD(t) || BIG_INT_HI_WORD(x1)) {
+            break;
+        }
+        /* q * vv cannot overflow, because q * c < B */
+        x2 = q * vv;
+        if (x2 > uu) {
+            break;
+        }
+        a = c;
+        c = t;
+        b = d;
+        d = x1;
+        t = uu - x2;
+        uu = vv;
+        vv = t;
+        n_steps++;
+    }
+
+    m[0] = (big_int_word) a;
+    m[1] = (big_int_word) b;
+    m[2] = (big_int_word) c;
+    m[3] = (big_int_word) d;
+    return n_steps;
+}
+
+/**
+    Applies matrix m[4], returned by low_level_gcd_lehmer(), to [u] and [v]:
+        u' = A * u + B * v
+        v' = C * u + D * v
+
+    Restrictions:
+        1) [u] and [v] must points to arrays of size [len] > 0
+        2) [n_steps] must be the value, returned by low_level_gcd_lehmer()
+        3) [tmp] must points to array of size 2 * len
+*/
+void low_level_gcd_matrix_mul(const big_int_word *m, size_t n_steps,
+                              big_int_word *u, big_int_word *v, size_t len,
+                              big_int_word *tmp)
+{
+    big_int_word flag_c;
+
+    assert(len > 0);
+
+    if (n_steps & 1) {
+        flag_c = lin_comb(v, m[1], u, m[0], len, tmp);
+        assert(flag_c == 0);
+        flag_c = lin_comb(u, m[2], v, m[3], len, tmp + len);
+        assert(flag_c == 0);
+    } else {
+        flag_c = lin_comb(u, m[0], v, m[1], len, tmp);
+        assert(flag_c == 0);
+        flag_c = lin_comb(v, m[3], u, m[2], len, tmp + len);
+        assert(flag_c == 0);
+    }
+    (void) flag_c;
+    memcpy(u, tmp, BIG_INT_WORD_BYTES_CNT * len);
+    memcpy(v, tmp + len, BIG_INT_WORD_BYTES_CNT * len);
+}
+
+/**
+    Returns GCD of digits [a] and [b] by binary algorithm.
+    GCD(0, 0) = 0.
+*/
+big_int_word low_level_gcd_1(big_int_word a, big_int_word b)
+{
+    big_int_word t;
+    size_t shift;
+
+    if (a == 0) {
+        return b;
+    }
+    if (b == 0) {
+        return a;
+    }
+
+    /* common power of 2 */
+    shift = 0;
+    while (!((a | b) & 1)) {
+        a >>= 1;
+        b >>= 1;
+        shift++;
+    }
+    while (!(a & 1)) {
+        a >>= 1;
+    }
+    do {
+        while (!(b & 1)) {
+            b >>= 1;
+        }
+        if (a > b) {
+            t = a;
+            a = b;
+            b = t;
+        }
+        b = (big_int_word) (b - a);
+    } while (b);
+
+    return (big_int_word) (a << shift);
+}
@@ -0,0 +1,181 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Montgomery multiplication modulo odd number [n] with length [n_len].
+    Numbers are kept in Montgomery form a' = a * R (mod n),
+    where R = 2^(BIG_INT_WORD_BITS_CNT * n_len). Then
+        a' * b' * R^(-1) = (a * b)' (mod n),
+    and reduction by R^(-1) needs no division.
+*/
+
+/**
+    Returns
+        -1 / n0 (mod 2^BIG_INT_WORD_BITS_CNT)
+
+    Restrictions:
+        1) [n0] must be odd
+*/
+big_int_word low_level_mont_inverse(big_int_word n0)
+{
+    big_int_word inv;
+    size_t n_bits;
+
+    assert(n0 & 1);
+
+    /*
+        n0 * n0 = 1 (mod 8), so [inv] is correct for 3 lower bits.
+        Every Newton's step inv = inv * (2 - n0 * inv) doubles
+        the number of correct bits.
+    */
+    inv = n0;
+    for (n_bits = 3; n_bits < BIG_INT_WORD_BITS_CNT; n_bits *= 2) {
+        inv = (big_int_word) (inv * (2 - (big_int_dword) n0 * inv));
+    }
+    assert((big_int_word) ((big_int_dword) n0 * inv) == 1);
+
+    return (big_int_word) (0 - inv);
+}
+
+/**
+    Calculates
+        c = t * R^(-1) (mod n),
+    where R = 2^(BIG_INT_WORD_BITS_CNT * n_len).
+    [t] is destroyed.
+
+    Restrictions:
+        1) [t] must points to array of size 2 * n_len + 1 and
+           t < n * R
+        2) [n] must be odd and n0_inv = low_level_mont_inverse(n[0])
+        3) [c] must points to array of size n_len
+        4) address [c] cannot be equal to [n]
+*/
+void low_level_mont_redc(big_int_word *t, const big_int_word *n, size_t n_len,
+                         big_int_word n0_inv, big_int_word *c)
+{
+    big_int_word *tt, *t_end;
+    big_int_word flag_c;
+    size_t i;
+
+    assert(n_len > 0);
+    assert(n[0] & 1);
+
+    /* add multiples of [n] to [t], so the lower digits of [t] become zeros */
+    t[2 * n_len] = 0;
+    t_end = t + 2 * n_len + 1;
+    for (i = 0; i < n_len; i++) {
+        flag_c = low_level_addmul_1(n, n + n_len,
+            (big_int_word) ((big_int_dword) t[i] * n0_inv), t + i);
+        assert(t[i] == 0);
+        /* add carry to the higher digits of [t] */
+        tt = t + i + n_len;
+        *tt += flag_c;
+        if (*tt < flag_c) {
+            do {
+                tt++;
+                assert(tt < t_end);
+            } while (!++(*tt));
+        }
+    }
+    (void) t_end;
+
+    /*
+        now t / R < 2 * n. Subtract [n], if t / R >= n.
+    */
+    tt = t + n_len;
+    if (tt[n_len] || low_level_cmp(tt, n, n_len) >= 0) {
+        low_level_sub(tt, tt + n_len + 1, n, n + n_len, tt);
+        assert(tt[n_len] == 0);
+    }
+    memcpy(c, tt, BIG_INT_WORD_BYTES_CNT * n_len);
+}
+
+/**
+    Calculates
+        c = a * b * R^(-1) (mod n),
+    where R = 2^(BIG_INT_WORD_BITS_CNT * n_len).
+
+    Restrictions:
+        1) [a], [b] and [c] must points to arrays of size n_len,
+           a < n, b < n
+        2) [n] must be odd and n0_inv = low_level_mont_inverse(n[0])
+        3) address [c] can be equal to [a] or [b], but not to [n]
+        4) [tmp] must points to array of size, returned by
+           low_level_mont_mul_tmp_len(n_len)
+*/
+void low_level_mont_mul(const big_int_word *a, const big_int_word *b,
+                        const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                        big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *t;
+
+    /*
+        layout of [tmp]:
+            t = a * b - [2 * n_len + 1] digits
+            the rest is used by low_level_fast_mul()
+    */
+    t = tmp;
+    if (a == b) {
+        low_level_fast_sqr(a, a + n_len, t, t + 2 * n_len + 1);
+    } else {
+        low_level_fast_mul(a, a + n_len, b, b + n_len, t, t + 2 * n_len + 1);
+    }
+    low_level_mont_redc(t, n, n_len, n0_inv, c);
+}
+
+/**
+    Calculates
+        c = a * a * R^(-1) (mod n),
+    where R = 2^(BIG_INT_WORD_BITS_CNT * n_len).
+
+    Restrictions are the same as for low_level_mont_mul()
+*/
+void low_level_mont_sqr(const big_int_word *a,
+                        const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                        big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *t;
+
+    /* see layout of [tmp] in low_level_mont_mul() */
+    t = tmp;
+    low_level_fast_sqr(a, a + n_len, t, t + 2 * n_len + 1);
+    low_level_mont_redc(t, n, n_len, n0_inv, c);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mont_mul() and low_level_mont_sqr() with modulus
+    length [n_len].
+
+    Restrictions:
+        1) n_len > 0
+*/
+size_t low_level_mont_mul_tmp_len(size_t n_len)
+{
+    size_t len, len1;
+
+    assert(n_len > 0);
+
+    /* see layout of [tmp] in low_level_mont_mul() */
+    len = low_level_fast_mul_tmp_len(n_len, n_len);
+    len1 = low_level_fast_sqr_tmp_len(n_len);
+    len = (len > len1) ? len : len1;
+
+    return 2 * n_len + 1 + len;
+}
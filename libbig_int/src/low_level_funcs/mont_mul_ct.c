@@ -0,0 +1,334 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Constant-time Montgomery arithmetic. Running time and memory access
+    pattern of these functions depend only on lengths of numbers,
+    but not on their values: there are no branches and no table
+    indexes, which depend on digits of numbers.
+*/
+
+static big_int_word add_n(const big_int_word *a, const big_int_word *b, size_t len,
+                          big_int_word *c);
+static big_int_word sub_n(const big_int_word *a, const big_int_word *b, size_t len,
+                          big_int_word *c);
+static void select_n(big_int_word mask, const big_int_word *a, size_t len, big_int_word *c);
+static big_int_word get_window(const big_int_word *b, size_t bit_pos, size_t window_bits);
+
+/**
+    Private function.
+
+    Calculates
+        c = a + b,
+    where length(a) = length(b) = [len].
+
+    Returns carry digit (0 or 1).
+    Address [c] can be equal to [a] or [b].
+*/
+static big_int_word add_n(const big_int_word *a, const big_int_word *b, size_t len,
+                          big_int_word *c)
+{
+    big_int_dword tmp;
+    size_t i;
+
+    tmp = 0;
+    for (i = 0; i < len; i++) {
+        tmp += a[i];
+        tmp += b[i];
+        c[i] = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    }
+
+    return BIG_INT_LO_WORD(tmp);
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a - b,
+    where length(a) = length(b) = [len].
+
+    Returns borrow digit (0 or 1).
+    Address [c] can be equal to [a] or [b].
+*/
+static big_int_word sub_n(const big_int_word *a, const big_int_word *b, size_t len,
+                          big_int_word *c)
+{
+    big_int_dword tmp;
+    big_int_word borrow;
+    size_t i;
+
+    borrow = 0;
+    for (i = 0; i < len; i++) {
+        tmp = (big_int_dword) a[i] - b[i] - borrow;
+        c[i] = BIG_INT_LO_WORD(tmp);
+        borrow = BIG_INT_HI_WORD(tmp) & 1;
+    }
+
+    return borrow;
+}
+
+/**
+    Private function.
+
+    Copies [a] to [c], if all bits of [mask] are set.
+    Leaves [c] unchanged, if [mask] is zero.
+*/
+static void select_n(big_int_word mask, const big_int_word *a, size_t len, big_int_word *c)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        c[i] = (c[i] & ~mask) | (a[i] & mask);
+    }
+}
+
+/**
+    Private function.
+
+    Returns [window_bits] bits of [b], starting from bit number [bit_pos].
+    Bits of [b] are read only from digits, which contain these bits.
+*/
+static big_int_word get_window(const big_int_word *b, size_t bit_pos, size_t window_bits)
+{
+    size_t digit_pos, shift;
+    big_int_word value;
+
+    digit_pos = bit_pos / BIG_INT_WORD_BITS_CNT;
+    shift = bit_pos % BIG_INT_WORD_BITS_CNT;
+    value = b[digit_pos] >> shift;
+    if (shift + window_bits > BIG_INT_WORD_BITS_CNT) {
+        value |= b[digit_pos + 1] << (BIG_INT_WORD_BITS_CNT - shift);
+    }
+
+    return value & (((big_int_word) 1 << window_bits) - 1);
+}
+
+/**
+    Calculates
+        c = a * b * R^(-1) (mod n)
+    in constant time, where R = 2^(BIG_INT_WORD_BITS_CNT * n_len).
+
+    Restrictions:
+        1) [a], [b] and [c] must points to arrays of size n_len,
+           a * b < n * R (it is true, if a < n or b < n)
+        2) [n] must be odd and n0_inv = low_level_mont_inverse(n[0])
+        3) address [c] can be equal to [a] or [b], but not to [n]
+        4) [tmp] must points to array of size 2 * n_len + 1
+*/
+void low_level_mont_mul_ct(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                           big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *t, *tt;
+    big_int_dword sum;
+    big_int_word carry, hi;
+    size_t i;
+
+    assert(n_len > 0);
+    assert(n[0] & 1);
+
+    /* t = a * b by rows of schoolbook multiplication */
+    t = tmp;
+    memset(t, 0, BIG_INT_WORD_BYTES_CNT * (2 * n_len + 1));
+    for (i = 0; i < n_len; i++) {
+        t[i + n_len] = low_level_addmul_1(a, a + n_len, b[i], t + i);
+    }
+
+    /*
+        Montgomery reduction. Carry from digit [i + n_len] is added
+        to the digit [i + n_len + 1] on the next step, so carries
+        are never propagated along the number.
+    */
+    carry = 0;
+    for (i = 0; i < n_len; i++) {
+        hi = low_level_addmul_1(n, n + n_len,
+            (big_int_word) ((big_int_dword) t[i] * n0_inv), t + i);
+        sum = (big_int_dword) t[i + n_len] + hi + carry;
+        t[i + n_len] = BIG_INT_LO_WORD(sum);
+        carry = BIG_INT_HI_WORD(sum);
+    }
+
+    /*
+        now t / R = carry * R + tt < 2 * n. Subtract [n], if t / R >= n.
+        Lower digits of [t] are zeros and are used as temporary buffer.
+    */
+    tt = t + n_len;
+    hi = sub_n(tt, n, n_len, t);
+    /* subtract, if there is carry or there is no borrow */
+    select_n(0 - (carry | (hi ^ 1)), t, n_len, tt);
+    memcpy(c, tt, BIG_INT_WORD_BYTES_CNT * n_len);
+}
+
+/**
+    Calculates
+        c = a + b (mod n)
+    in constant time.
+
+    Restrictions:
+        1) [a], [b] and [c] must points to arrays of size n_len,
+           a < n, b < n
+        2) address [c] can be equal to [a] or [b], but not to [n]
+        3) [tmp] must points to array of size n_len
+*/
+void low_level_addmod_ct(const big_int_word *a, const big_int_word *b,
+                         const big_int_word *n, size_t n_len,
+                         big_int_word *c, big_int_word *tmp)
+{
+    big_int_word carry, borrow;
+
+    carry = add_n(a, b, n_len, c);
+    borrow = sub_n(c, n, n_len, tmp);
+    /* subtract, if there is carry or there is no borrow */
+    select_n(0 - (carry | (borrow ^ 1)), tmp, n_len, c);
+}
+
+/**
+    Calculates
+        c = a - b (mod n)
+    in constant time.
+
+    Restrictions are the same as for low_level_addmod_ct()
+*/
+void low_level_submod_ct(const big_int_word *a, const big_int_word *b,
+                         const big_int_word *n, size_t n_len,
+                         big_int_word *c, big_int_word *tmp)
+{
+    big_int_word borrow;
+
+    borrow = sub_n(a, b, n_len, c);
+    add_n(c, n, n_len, tmp);
+    /* add [n], if there is borrow */
+    select_n(0 - borrow, tmp, n_len, c);
+}
+
+/**
+    Copies number with index [idx] from [table] to [c].
+    [table] contains [cnt] numbers with length [len] digits.
+    All numbers of [table] are read, so memory access pattern
+    does not depend on [idx].
+
+    Restrictions:
+        1) idx < cnt
+        2) [c] must points to array of size [len]
+*/
+void low_level_select_ct(const big_int_word *table, size_t cnt, size_t len,
+                         big_int_word idx, big_int_word *c)
+{
+    big_int_word mask, d;
+    size_t i;
+
+    assert(idx < cnt);
+
+    memset(c, 0, BIG_INT_WORD_BYTES_CNT * len);
+    for (i = 0; i < cnt; i++) {
+        /* mask = (i == idx) ? ~0 : 0 */
+        d = (big_int_word) i ^ idx;
+        d |= (big_int_word) (0 - d);
+        mask = (big_int_word) ((d >> (BIG_INT_WORD_BITS_CNT - 1)) - 1);
+        select_n(mask, table, len, c);
+        table += len;
+    }
+}
+
+/**
+    Calculates
+        c = pow(a, b) (mod n)
+    in constant time by fixed-window exponentiation. [a] and [c]
+    are in Montgomery form. All [b_len] digits of [b] are processed
+    by windows of [window_bits] bits, so running time and memory access
+    pattern depend only on [b_len], [n_len] and [window_bits].
+
+    Restrictions:
+        1) [a] and [c] must points to arrays of size n_len, a < n
+        2) [n] must be odd and n0_inv = low_level_mont_inverse(n[0])
+        3) [one] must contain R (mod n) with length n_len,
+           where R = 2^(BIG_INT_WORD_BITS_CNT * n_len)
+        4) b_len > 0 and 0 < window_bits < BIG_INT_WORD_BITS_CNT
+        5) address [c] can be equal to [a]
+        6) [tmp] must points to array of size, returned by
+           low_level_mont_pow_ct_tmp_len(n_len, window_bits)
+*/
+void low_level_mont_pow_ct(const big_int_word *a, const big_int_word *b, size_t b_len,
+                           const big_int_word *n, size_t n_len, big_int_word n0_inv,
+                           const big_int_word *one, size_t window_bits,
+                           big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *table, *x, *y, *t;
+    big_int_word window;
+    size_t table_cnt, n_bits, bit_pos, i;
+
+    assert(b_len > 0);
+    assert(window_bits > 0 && window_bits < BIG_INT_WORD_BITS_CNT);
+
+    /*
+        layout of [tmp]:
+            table = {1, a, a^2, ..., a^(table_cnt - 1)} - [table_cnt * n_len] digits
+            x - [n_len] digits
+            y - [n_len] digits
+            t - [2 * n_len + 1] digits, used by low_level_mont_mul_ct()
+    */
+    table_cnt = (size_t) 1 << window_bits;
+    table = tmp;
+    x = table + table_cnt * n_len;
+    y = x + n_len;
+    t = y + n_len;
+
+    memcpy(table, one, BIG_INT_WORD_BYTES_CNT * n_len);
+    memcpy(table + n_len, a, BIG_INT_WORD_BYTES_CNT * n_len);
+    for (i = 2; i < table_cnt; i++) {
+        low_level_mont_mul_ct(table + (i - 1) * n_len, a, n, n_len, n0_inv,
+            table + i * n_len, t);
+    }
+
+    /*
+        number of processed bits is multiple of [window_bits].
+        Bits above b_len digits are zeros.
+    */
+    n_bits = (b_len * BIG_INT_WORD_BITS_CNT + window_bits - 1) / window_bits * window_bits;
+    memcpy(x, one, BIG_INT_WORD_BYTES_CNT * n_len);
+    bit_pos = n_bits;
+    while (bit_pos > 0) {
+        bit_pos -= window_bits;
+        for (i = 0; i < window_bits; i++) {
+            low_level_mont_mul_ct(x, x, n, n_len, n0_inv, x, t);
+        }
+        if (bit_pos + window_bits > b_len * BIG_INT_WORD_BITS_CNT) {
+            /* the highest window is partially out of [b] */
+            window = b[b_len - 1] >> (bit_pos % BIG_INT_WORD_BITS_CNT);
+        } else {
+            window = get_window(b, bit_pos, window_bits);
+        }
+        low_level_select_ct(table, table_cnt, n_len, window, y);
+        low_level_mont_mul_ct(x, y, n, n_len, n0_inv, x, t);
+    }
+    memcpy(c, x, BIG_INT_WORD_BYTES_CNT * n_len);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mont_pow_ct() with modulus length [n_len] and
+    window width [window_bits].
+*/
+size_t low_level_mont_pow_ct_tmp_len(size_t n_len, size_t window_bits)
+{
+    /* see layout of [tmp] in low_level_mont_pow_ct() */
+    return (((size_t) 1 << window_bits) + 4) * n_len + 1;
+}
@@ -13,6 +13,7 @@
        e-mail:  valyala@gmail.com
 *************************************************************************/
 #include <assert.h>
+#include <string.h> /* for memcpy, memset */
 #include "big_int.h"
 #include "low_level_funcs.h"
 
@@ -39,6 +40,13 @@ void low_level_mul(const big_int_word *a, const big_int_word *a_end,
     assert(a != c);
     assert(b != c);
 
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        low_level_mul_adx(a, a_end, b, b_end, c);
+        return;
+    }
+#endif
+
     /* fill [c] by zeros */
     c_end = c + (a_end - a) + (b_end - b);
     cc = c;
@@ -62,3 +70,204 @@ void low_level_mul(const big_int_word *a, const big_int_word *a_end,
         *cc = BIG_INT_LO_WORD(tmp1);
     } while (bb < b_end);
 }
+
+/**
+    Calculates
+        c = c + a * b,
+    where [b] is a digit.
+
+    Returns carry digit from the highest digit of [c].
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size length(a)
+*/
+big_int_word low_level_addmul_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c)
+{
+    big_int_dword tmp;
+
+    assert(a_end - a > 0);
+
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        return low_level_addmul_1_adx(a, a_end, b, c);
+    }
+#endif
+
+    tmp = 0;
+    do {
+        tmp += (big_int_dword) b * (*a++);
+        tmp += *c;
+        *c++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    } while (a < a_end);
+
+    return BIG_INT_LO_WORD(tmp);
+}
+
+/**
+    Calculates
+        c = c - a * b,
+    where [b] is a digit.
+
+    Returns borrow digit from the highest digit of [c].
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size length(a)
+*/
+big_int_word low_level_submul_1(const big_int_word *a, const big_int_word *a_end,
+                                big_int_word b, big_int_word *c)
+{
+    big_int_dword tmp;
+    big_int_word lo, flag_c;
+
+    assert(a_end - a > 0);
+
+    flag_c = 0;
+    do {
+        tmp = (big_int_dword) b * (*a++) + flag_c;
+        lo = BIG_INT_LO_WORD(tmp);
+        flag_c = BIG_INT_HI_WORD(tmp);
+        if (*c < lo) {
+            flag_c++;
+        }
+        *c = (big_int_word) (*c - lo);
+        c++;
+    } while (a < a_end);
+
+    return flag_c;
+}
+
+/**
+    Calculates
+        c = a * b,
+    where [b] is a digit.
+
+    Returns the highest digit of product. Other digits are stored
+    into [c].
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size length(a).
+           Address [c] can be equal to [a]
+*/
+big_int_word low_level_mul_1(const big_int_word *a, const big_int_word *a_end,
+                             big_int_word b, big_int_word *c)
+{
+    big_int_dword tmp;
+
+    assert(a_end - a > 0);
+
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        return low_level_mul_1_adx(a, a_end, b, c);
+    }
+#endif
+
+    tmp = 0;
+    do {
+        tmp += (big_int_dword) b * (*a++);
+        *c++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    } while (a < a_end);
+
+    return BIG_INT_LO_WORD(tmp);
+}
+
+/**
+    Calculates [c_len] lower digits of a * b:
+        c = a * b (mod B^c_len),
+    where B = 2^BIG_INT_WORD_BITS_CNT. Digits of [a] and [b], which are
+    higher than [c_len], are ignored. For short numbers schoolbook
+    multiplication skips digits of product, which are higher than [c_len].
+
+    Restrictions:
+        1) length(a) > 0, length(b) > 0, c_len > 0
+        2) [c] must points to array of size [c_len]
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_mul_low_tmp_len(length(a), length(b), c_len)
+*/
+void low_level_mul_low(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c, size_t c_len, big_int_word *tmp)
+{
+    const big_int_word *t;
+    big_int_word flag_c;
+    size_t a_len, b_len, len, i;
+
+    assert(a_end - a > 0);
+    assert(b_end - b > 0);
+    assert(c_len > 0);
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+    if (a_len > c_len) {
+        a_len = c_len;
+    }
+    if (b_len > c_len) {
+        b_len = c_len;
+    }
+    if (a_len < b_len) {
+        t = a;
+        a = b;
+        b = t;
+        len = a_len;
+        a_len = b_len;
+        b_len = len;
+    }
+
+    if (b_len >= BIG_INT_KARATSUBA_MUL_THRESHOLD) {
+        low_level_fast_mul(a, a + a_len, b, b + b_len, tmp, tmp + a_len + b_len);
+        len = (a_len + b_len < c_len) ? a_len + b_len : c_len;
+        memcpy(c, tmp, BIG_INT_WORD_BYTES_CNT * len);
+        memset(c + len, 0, BIG_INT_WORD_BYTES_CNT * (c_len - len));
+        return;
+    }
+
+    /* schoolbook multiplication, which skips digits higher than [c_len] */
+    memset(c, 0, BIG_INT_WORD_BYTES_CNT * c_len);
+    for (i = 0; i < b_len; i++) {
+        len = c_len - i;
+        if (len > a_len) {
+            len = a_len;
+        }
+        flag_c = low_level_addmul_1(a, a + len, b[i], c + i);
+        if (i + len < c_len) {
+            c[i + len] = flag_c;
+        }
+    }
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_low() to calculate [c_len] lower digits of product
+    of numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) a_len > 0, b_len > 0, c_len > 0
+*/
+size_t low_level_mul_low_tmp_len(size_t a_len, size_t b_len, size_t c_len)
+{
+    size_t len;
+
+    assert(a_len > 0 && b_len > 0 && c_len > 0);
+
+    if (a_len > c_len) {
+        a_len = c_len;
+    }
+    if (b_len > c_len) {
+        b_len = c_len;
+    }
+    if (a_len < b_len) {
+        len = a_len;
+        a_len = b_len;
+        b_len = len;
+    }
+    if (b_len < BIG_INT_KARATSUBA_MUL_THRESHOLD) {
+        return 0;
+    }
+    return a_len + b_len + low_level_fast_mul_tmp_len(a_len, b_len);
+}
@@ -0,0 +1,270 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+static int abs_sub(const big_int_word *a, size_t a_len,
+                   const big_int_word *b, size_t b_len, big_int_word *c);
+
+/**
+    Private function.
+
+    Calculates
+        c = abs(a - b)
+
+    Returns 1, if a < b. Else returns 0.
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+        2) [c] must points to array of size length(a)
+        3) address [c] cannot be equal to [b]
+*/
+static int abs_sub(const big_int_word *a, size_t a_len,
+                   const big_int_word *b, size_t b_len, big_int_word *c)
+{
+    const big_int_word *aa;
+    int cmp_flag;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+
+    /* if higher digits of [a] are not zeros, then a > b */
+    aa = a + a_len;
+    while (aa > a + b_len && !*(aa - 1)) {
+        aa--;
+    }
+    if (aa > a + b_len) {
+        cmp_flag = 1;
+    } else {
+        cmp_flag = low_level_cmp(a, b, b_len);
+    }
+
+    if (cmp_flag >= 0) {
+        low_level_sub((big_int_word *) a, (big_int_word *) a + a_len, b, b + b_len, c);
+        return 0;
+    }
+
+    /* a < b, so higher digits of [a] are zeros */
+    low_level_sub((big_int_word *) b, (big_int_word *) b + b_len, a, a + b_len, c);
+    if (a_len > b_len) {
+        memset(c + b_len, 0, BIG_INT_WORD_BYTES_CNT * (a_len - b_len));
+    }
+    return 1;
+}
+
+/**
+    Calculates
+        c = a * b
+    by Karatsuba's algorithm:
+        a = a1 * B^h + a0
+        b = b1 * B^h + b0
+        a * b = a1*b1 * B^2h + (a0*b0 + a1*b1 - (a0 - a1)*(b0 - b1)) * B^h + a0*b0,
+    where B = 2^BIG_INT_WORD_BITS_CNT and h = (length(a) + 1) / 2.
+
+    Products of halves are calculated by low_level_fast_mul(), so
+    the algorithm is applied recursively.
+
+    Restrictions:
+        1) length(a) >= length(b) > (length(a) + 1) / 2
+        2) [c] must points to array of size length(a) + length(b)
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_mul_karatsuba_tmp_len(length(a), length(b))
+*/
+void low_level_mul_karatsuba(const big_int_word *a, const big_int_word *a_end,
+                             const big_int_word *b, const big_int_word *b_end,
+                             big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len, c_len, h;
+    big_int_word *da, *db, *p, *t, *t_end;
+    big_int_word flag_c;
+    int sign;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+    h = (a_len + 1) / 2;
+    c_len = a_len + b_len;
+
+    assert(b_len > h);
+    assert(a_len >= b_len);
+    assert(a != c);
+    assert(b != c);
+
+    /*
+        layout of [tmp]:
+            da = abs(a0 - a1) - [h] digits
+            db = abs(b0 - b1) - [h] digits
+            p = da * db - [2h] digits
+            the rest is used by recursive calls and for [t]
+    */
+    da = tmp;
+    db = da + h;
+    p = db + h;
+    t = p + 2 * h;
+
+    sign = abs_sub(a, h, a + h, a_len - h, da);
+    sign ^= abs_sub(b, h, b + h, b_len - h, db);
+
+    low_level_fast_mul(da, da + h, db, db + h, p, t);
+    low_level_fast_mul(a, a + h, b, b + h, c, t);
+    low_level_fast_mul(a + h, a_end, b + h, b_end, c + 2 * h, t);
+
+    /* t = a0*b0 + a1*b1 */
+    memcpy(t, c, BIG_INT_WORD_BYTES_CNT * 2 * h);
+    t[2 * h] = low_level_addto(t, t + 2 * h, c + 2 * h, c + c_len);
+    t_end = t + 2 * h + 1;
+
+    /*
+        t = a0*b0 + a1*b1 - (a0 - a1)*(b0 - b1)
+        [sign] is set, if (a0 - a1)*(b0 - b1) is negative
+    */
+    if (sign) {
+        flag_c = low_level_addto(t, t_end, p, p + 2 * h);
+    } else {
+        flag_c = low_level_subfrom(t, t_end, p, p + 2 * h);
+    }
+    assert(flag_c == 0);
+
+    /*
+        c += t * B^h
+        Higher digits of [t], which are out of [c], are always zeros.
+    */
+    while ((size_t) (t_end - t) > c_len - h) {
+        t_end--;
+        assert(*t_end == 0);
+    }
+    flag_c = low_level_addto(c + h, c + c_len, t, t_end);
+    assert(flag_c == 0);
+    (void) flag_c;
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_karatsuba() to multiply numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) a_len >= b_len > (a_len + 1) / 2
+*/
+size_t low_level_mul_karatsuba_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t h, len, len1;
+
+    assert(b_len > (a_len + 1) / 2);
+    assert(a_len >= b_len);
+
+    /* see layout of [tmp] in low_level_mul_karatsuba() */
+    h = (a_len + 1) / 2;
+    len = 2 * h + 1;
+    len1 = low_level_fast_mul_tmp_len(h, h);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_mul_tmp_len(a_len - h, b_len - h);
+    len = (len > len1) ? len : len1;
+
+    return 4 * h + len;
+}
+
+/**
+    Calculates
+        c = a * a
+    by Karatsuba's algorithm:
+        a = a1 * B^h + a0
+        a * a = a1^2 * B^2h + (a0^2 + a1^2 - (a0 - a1)^2) * B^h + a0^2,
+    where B = 2^BIG_INT_WORD_BITS_CNT and h = (length(a) + 1) / 2.
+
+    Squares of halves are calculated by low_level_fast_sqr(), so
+    the algorithm is applied recursively.
+
+    Restrictions:
+        1) length(a) > 1
+        2) [c] must points to array of size 2 * length(a)
+        3) address [c] cannot be equal to [a]
+        4) [tmp] must points to array of size, returned by
+           low_level_sqr_karatsuba_tmp_len(length(a))
+*/
+void low_level_sqr_karatsuba(const big_int_word *a, const big_int_word *a_end,
+                             big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, c_len, h;
+    big_int_word *da, *p, *t, *t_end;
+    big_int_word flag_c;
+
+    a_len = a_end - a;
+    h = (a_len + 1) / 2;
+    c_len = 2 * a_len;
+
+    assert(a_len > 1);
+    assert(a != c);
+
+    /*
+        layout of [tmp]:
+            da = abs(a0 - a1) - [h] digits
+            p = da * da - [2h] digits
+            the rest is used by recursive calls and for [t]
+    */
+    da = tmp;
+    p = da + h;
+    t = p + 2 * h;
+
+    abs_sub(a, h, a + h, a_len - h, da);
+
+    low_level_fast_sqr(da, da + h, p, t);
+    low_level_fast_sqr(a, a + h, c, t);
+    low_level_fast_sqr(a + h, a_end, c + 2 * h, t);
+
+    /* t = a0^2 + a1^2 - (a0 - a1)^2 */
+    memcpy(t, c, BIG_INT_WORD_BYTES_CNT * 2 * h);
+    t[2 * h] = low_level_addto(t, t + 2 * h, c + 2 * h, c + c_len);
+    t_end = t + 2 * h + 1;
+    flag_c = low_level_subfrom(t, t_end, p, p + 2 * h);
+    assert(flag_c == 0);
+
+    /*
+        c += t * B^h
+        Higher digits of [t], which are out of [c], are always zeros.
+    */
+    while ((size_t) (t_end - t) > c_len - h) {
+        t_end--;
+        assert(*t_end == 0);
+    }
+    flag_c = low_level_addto(c + h, c + c_len, t, t_end);
+    assert(flag_c == 0);
+    (void) flag_c;
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_sqr_karatsuba() to square number with length [a_len].
+
+    Restrictions:
+        1) a_len > 1
+*/
+size_t low_level_sqr_karatsuba_tmp_len(size_t a_len)
+{
+    size_t h, len, len1;
+
+    assert(a_len > 1);
+
+    /* see layout of [tmp] in low_level_sqr_karatsuba() */
+    h = (a_len + 1) / 2;
+    len = 2 * h + 1;
+    len1 = low_level_fast_sqr_tmp_len(h);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_sqr_tmp_len(a_len - h);
+    len = (len > len1) ? len : len1;
+
+    return 3 * h + len;
+}
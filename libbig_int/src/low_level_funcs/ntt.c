@@ -0,0 +1,551 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Multiplication by number-theoretic transform (NTT).
+
+    Numbers are splitted into 32-bit chunks. Convolution of chunks is
+    calculated modulo three primes p = k * 2^m + 1 < 2^31 by NTT,
+    then recovered by Chinese remainder theorem (Garner's algorithm).
+    Product of primes is greater than 2^89, so coefficients of convolution
+    up to 2^24 * (2^32 - 1)^2 are recovered exactly.
+*/
+
+/* 32-bit and 64-bit unsigned types for arithmetic modulo primes */
+#if defined(_MSC_VER)
+typedef unsigned __int32 ntt_word;
+typedef unsigned __int64 ntt_dword;
+#else
+typedef uint32_t ntt_word;
+typedef uint64_t ntt_dword;
+#endif
+
+#define NTT_CHUNK_BITS_CNT 32
+#define NTT_PRIMES_CNT 3
+
+/* maximum length of transform, supported by all primes */
+#define NTT_MAX_LOG2_LEN 24
+
+typedef struct {
+    ntt_word p; /* prime */
+    ntt_word g; /* generator of multiplicative group modulo [p] */
+    ntt_word p_inv; /* -1 / p mod 2^32 */
+    ntt_word r2; /* 2^64 mod p */
+} ntt_prime;
+
+static void prime_init(ntt_prime *pr, ntt_word p, ntt_word g);
+static ntt_word mod_mul(ntt_word a, ntt_word b, ntt_word p);
+static ntt_word mod_pow(ntt_word a, ntt_word n, ntt_word p);
+static ntt_word mont_mul(ntt_word a, ntt_word b, const ntt_prime *pr);
+static ntt_word add_mod(ntt_word a, ntt_word b, ntt_word p);
+static ntt_word sub_mod(ntt_word a, ntt_word b, ntt_word p);
+static void make_roots(ntt_word *roots, size_t n, const ntt_prime *pr);
+static void ntt_forward(ntt_word *f, size_t n, const ntt_word *roots, const ntt_prime *pr);
+static void ntt_inverse(ntt_word *f, size_t n, const ntt_word *roots, const ntt_prime *pr);
+static void to_chunks(const big_int_word *a, size_t a_len, ntt_word *f, size_t n, ntt_word p);
+static size_t chunks_cnt(size_t len);
+static size_t transform_len(size_t a_len, size_t b_len);
+static void garner(ntt_word *const *r, const ntt_prime *pr, big_int_word *c, size_t c_len, size_t n);
+static void ntt_mul(const big_int_word *a, size_t a_len, const big_int_word *b, size_t b_len,
+                    big_int_word *c, big_int_word *tmp);
+static size_t ntt_mul_tmp_len(size_t a_len, size_t b_len, int is_sqr);
+
+/**
+    Private function.
+
+    Initializes constants for Montgomery multiplication modulo prime [p]
+*/
+static void prime_init(ntt_prime *pr, ntt_word p, ntt_word g)
+{
+    ntt_word inv;
+    int i;
+
+    pr->p = p;
+    pr->g = g;
+
+    /* Newton's iteration: every step doubles number of correct bits of 1 / p */
+    inv = p;
+    for (i = 0; i < 4; i++) {
+        inv *= 2 - p * inv;
+    }
+    pr->p_inv = (ntt_word) 0 - inv;
+
+    pr->r2 = (ntt_word) (((ntt_dword) 1 << NTT_CHUNK_BITS_CNT) % p);
+    pr->r2 = mod_mul(pr->r2, pr->r2, p);
+}
+
+/**
+    Private function.
+
+    Returns a * b mod p
+*/
+static ntt_word mod_mul(ntt_word a, ntt_word b, ntt_word p)
+{
+    return (ntt_word) ((ntt_dword) a * b % p);
+}
+
+/**
+    Private function.
+
+    Returns a ^ n mod p
+*/
+static ntt_word mod_pow(ntt_word a, ntt_word n, ntt_word p)
+{
+    ntt_word res;
+
+    res = 1;
+    while (n) {
+        if (n & 1) {
+            res = mod_mul(res, a, p);
+        }
+        a = mod_mul(a, a, p);
+        n >>= 1;
+    }
+    return res;
+}
+
+/**
+    Private function.
+
+    Returns a * b / 2^32 mod p (Montgomery multiplication)
+
+    Restrictions:
+        1) a < p, b < p
+*/
+static ntt_word mont_mul(ntt_word a, ntt_word b, const ntt_prime *pr)
+{
+    ntt_dword t;
+    ntt_word m, u;
+
+    t = (ntt_dword) a * b;
+    m = (ntt_word) t * pr->p_inv;
+    u = (ntt_word) ((t + (ntt_dword) m * pr->p) >> NTT_CHUNK_BITS_CNT);
+    return (u >= pr->p) ? u - pr->p : u;
+}
+
+/**
+    Private function.
+
+    Returns a + b mod p
+*/
+static ntt_word add_mod(ntt_word a, ntt_word b, ntt_word p)
+{
+    a += b;
+    return (a >= p) ? a - p : a;
+}
+
+/**
+    Private function.
+
+    Returns a - b mod p
+*/
+static ntt_word sub_mod(ntt_word a, ntt_word b, ntt_word p)
+{
+    return (a >= b) ? a - b : a + p - b;
+}
+
+/**
+    Private function.
+
+    Fills [roots] with powers of roots of unity in Montgomery form:
+        roots[h + j] = w(2h)^j * 2^32 mod p,
+    where w(m) is the primitive root of unity of degree [m],
+    h = 1, 2, 4, ..., n/2 and j = 0, 1, ..., h - 1.
+*/
+static void make_roots(ntt_word *roots, size_t n, const ntt_prime *pr)
+{
+    size_t h, j;
+    ntt_word w;
+
+    /* w = w(n) in Montgomery form */
+    w = mod_pow(pr->g, (ntt_word) ((pr->p - 1) / n), pr->p);
+    w = mont_mul(w, pr->r2, pr);
+
+    h = n / 2;
+    roots[h] = mont_mul(1, pr->r2, pr);
+    for (j = 1; j < h; j++) {
+        roots[h + j] = mont_mul(roots[h + j - 1], w, pr);
+    }
+    /* w(h) = w(2h)^2 */
+    while (h > 1) {
+        for (j = 0; j < h / 2; j++) {
+            roots[h / 2 + j] = roots[h + 2 * j];
+        }
+        h /= 2;
+    }
+}
+
+/**
+    Private function.
+
+    Forward transform (decimation in frequency).
+    Input is in natural order, output is in bit-reversed order.
+*/
+static void ntt_forward(ntt_word *f, size_t n, const ntt_word *roots, const ntt_prime *pr)
+{
+    size_t m, h, s, j;
+    ntt_word u, v, p;
+
+    p = pr->p;
+    for (m = n; m >= 2; m /= 2) {
+        h = m / 2;
+        for (s = 0; s < n; s += m) {
+            for (j = 0; j < h; j++) {
+                u = f[s + j];
+                v = f[s + j + h];
+                f[s + j] = add_mod(u, v, p);
+                f[s + j + h] = mont_mul(sub_mod(u, v, p), roots[h + j], pr);
+            }
+        }
+    }
+}
+
+/**
+    Private function.
+
+    Inverse transform without division by [n] (decimation in time).
+    Input is in bit-reversed order, output is in natural order.
+    Uses w(m)^(-j) = -w(m)^(h - j), where h = m / 2.
+*/
+static void ntt_inverse(ntt_word *f, size_t n, const ntt_word *roots, const ntt_prime *pr)
+{
+    size_t m, h, s, j;
+    ntt_word u, v, p;
+
+    p = pr->p;
+    for (m = 2; m <= n; m *= 2) {
+        h = m / 2;
+        for (s = 0; s < n; s += m) {
+            u = f[s];
+            v = f[s + h];
+            f[s] = add_mod(u, v, p);
+            f[s + h] = sub_mod(u, v, p);
+            for (j = 1; j < h; j++) {
+                u = f[s + j];
+                v = mont_mul(f[s + j + h], roots[m - j], pr);
+                f[s + j] = sub_mod(u, v, p);
+                f[s + j + h] = add_mod(u, v, p);
+            }
+        }
+    }
+}
+
+/**
+    Private function.
+
+    Returns number of 32-bit chunks in number with length [len] digits
+*/
+static size_t chunks_cnt(size_t len)
+{
+    return (len * BIG_INT_WORD_BITS_CNT + NTT_CHUNK_BITS_CNT - 1) / NTT_CHUNK_BITS_CNT;
+}
+
+/**
+    Private function.
+
+    Splits [a] into 32-bit chunks modulo [p], and saves them to [f].
+    The rest of [f] up to [n] is filled by zeros.
+*/
+static void to_chunks(const big_int_word *a, size_t a_len, ntt_word *f, size_t n, ntt_word p)
+{
+    size_t i, j, cnt, n_bits, pos;
+    ntt_word chunk;
+
+    cnt = chunks_cnt(a_len);
+    assert(cnt <= n);
+    for (i = 0; i < cnt; i++) {
+        /*
+            a chunk contains 32 / BIG_INT_WORD_BITS_CNT digits
+            or a half of 64-bit digit
+        */
+        chunk = 0;
+        for (n_bits = 0; n_bits < NTT_CHUNK_BITS_CNT; n_bits += BIG_INT_WORD_BITS_CNT) {
+            pos = i * NTT_CHUNK_BITS_CNT + n_bits;
+            j = pos / BIG_INT_WORD_BITS_CNT;
+            if (j >= a_len) {
+                break;
+            }
+            chunk |= (ntt_word) (a[j] >> (pos % BIG_INT_WORD_BITS_CNT)) << n_bits;
+        }
+        f[i] = chunk % p;
+    }
+    memset(f + cnt, 0, sizeof(ntt_word) * (n - cnt));
+}
+
+/**
+    Private function.
+
+    Returns length of transform for multiplication of numbers
+    with lengths [a_len] and [b_len] digits. It is the smallest power of 2,
+    which is not less than number of coefficients of the product.
+*/
+static size_t transform_len(size_t a_len, size_t b_len)
+{
+    size_t n, cnt;
+
+    cnt = chunks_cnt(a_len) + chunks_cnt(b_len) - 1;
+    n = 2;
+    while (n < cnt) {
+        n *= 2;
+    }
+    return n;
+}
+
+/**
+    Private function.
+
+    Recovers coefficients of convolution from residues r[i][j] modulo
+    three primes by Garner's algorithm, and saves their sum
+        c = sum(coeff[i] * 2^(32 * i))
+    to [c] with length [c_len] digits.
+*/
+static void garner(ntt_word *const *r, const ntt_prime *pr, big_int_word *c, size_t c_len, size_t n)
+{
+    size_t i, j, cnt, n_bits, pos;
+    ntt_word p1, p2, p3, c12, c123, v2, v3, p12_lo, p12_hi;
+    ntt_dword x12, t, u, s0, s1, s2, acc0, acc1, acc2;
+
+    p1 = pr[0].p;
+    p2 = pr[1].p;
+    p3 = pr[2].p;
+    /* c12 = 1 / p1 mod p2, c123 = 1 / (p1 * p2) mod p3 */
+    c12 = mod_pow(p1 % p2, p2 - 2, p2);
+    c123 = mod_pow(mod_mul(p1 % p3, p2 % p3, p3), p3 - 2, p3);
+    p12_lo = (ntt_word) ((ntt_dword) p1 * p2);
+    p12_hi = (ntt_word) (((ntt_dword) p1 * p2) >> NTT_CHUNK_BITS_CNT);
+
+    memset(c, 0, BIG_INT_WORD_BYTES_CNT * c_len);
+    cnt = chunks_cnt(c_len);
+    acc0 = acc1 = acc2 = 0;
+    for (i = 0; i < cnt; i++) {
+        if (i < n) {
+            /* coeff = x12 + v3 * p1 * p2, where x12 = r1 + v2 * p1 */
+            v2 = mod_mul(sub_mod(r[1][i], r[0][i] % p2, p2), c12, p2);
+            x12 = r[0][i] + (ntt_dword) v2 * p1;
+            v3 = mod_mul(sub_mod(r[2][i], (ntt_word) (x12 % p3), p3), c123, p3);
+            t = (ntt_dword) v3 * p12_lo;
+            u = (ntt_dword) v3 * p12_hi;
+        } else {
+            x12 = t = u = 0;
+        }
+
+        /* acc = acc + coeff. Save lower 32 bits of [acc] to [c] */
+        s0 = acc0 + (ntt_word) x12 + (ntt_word) t;
+        s1 = acc1 + (x12 >> NTT_CHUNK_BITS_CNT) + (t >> NTT_CHUNK_BITS_CNT) + (ntt_word) u
+            + (s0 >> NTT_CHUNK_BITS_CNT);
+        s2 = acc2 + (u >> NTT_CHUNK_BITS_CNT) + (s1 >> NTT_CHUNK_BITS_CNT);
+        acc0 = (ntt_word) s1;
+        acc1 = (ntt_word) s2;
+        acc2 = s2 >> NTT_CHUNK_BITS_CNT;
+
+        for (n_bits = 0; n_bits < NTT_CHUNK_BITS_CNT; n_bits += BIG_INT_WORD_BITS_CNT) {
+            pos = i * NTT_CHUNK_BITS_CNT + n_bits;
+            j = pos / BIG_INT_WORD_BITS_CNT;
+            if (j >= c_len) {
+                assert(!(ntt_word) (s0 >> n_bits));
+                break;
+            }
+            c[j] |= (big_int_word) ((big_int_word) (ntt_word) (s0 >> n_bits) << (pos % BIG_INT_WORD_BITS_CNT));
+        }
+    }
+    assert(!(acc0 | acc1 | acc2));
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a * b
+    by number-theoretic transform modulo three primes.
+    If [b] is NULL, then calculates
+        c = a * a
+    In this case the transform of [a] is calculated only once for every prime.
+
+    [tmp] must points to array of size, returned by
+    ntt_mul_tmp_len(a_len, b_len, b == NULL)
+*/
+static void ntt_mul(const big_int_word *a, size_t a_len, const big_int_word *b, size_t b_len,
+                    big_int_word *c, big_int_word *tmp)
+{
+    static const ntt_word primes[NTT_PRIMES_CNT][2] = {
+        /* prime, generator */
+        {2013265921, 31}, /* 15 * 2^27 + 1 */
+        {469762049, 3}, /* 7 * 2^26 + 1 */
+        {754974721, 11}, /* 45 * 2^24 + 1 */
+    };
+    ntt_prime pr[NTT_PRIMES_CNT];
+    ntt_word *r[NTT_PRIMES_CNT], *fb, *roots, *f;
+    ntt_word scale;
+    size_t n, i, j;
+
+    n = transform_len(a_len, b_len);
+    assert(n <= ((size_t) 1 << NTT_MAX_LOG2_LEN));
+
+    /*
+        layout of [tmp] (aligned to ntt_word):
+            r[i] - residues of the product modulo primes[i] - [n] chunks
+            roots - roots of unity - [n] chunks
+            fb - transform of [b] - [n] chunks. Not used for squaring
+    */
+    while ((size_t) tmp % sizeof(ntt_word)) {
+        tmp++;
+    }
+    f = (ntt_word *) tmp;
+    for (i = 0; i < NTT_PRIMES_CNT; i++) {
+        r[i] = f;
+        f += n;
+    }
+    roots = f;
+
+    for (i = 0; i < NTT_PRIMES_CNT; i++) {
+        prime_init(&pr[i], primes[i][0], primes[i][1]);
+        make_roots(roots, n, &pr[i]);
+
+        to_chunks(a, a_len, r[i], n, pr[i].p);
+        ntt_forward(r[i], n, roots, &pr[i]);
+        if (b == NULL) {
+            fb = r[i];
+        } else {
+            fb = roots + n;
+            to_chunks(b, b_len, fb, n, pr[i].p);
+            ntt_forward(fb, n, roots, &pr[i]);
+        }
+
+        /*
+            r[i] = r[i] * fb / n. Montgomery multiplication divides
+            every product by 2^32, so [scale] = 2^64 / n mod p
+        */
+        scale = mod_mul(pr[i].r2, mod_pow((ntt_word) (n % pr[i].p), pr[i].p - 2, pr[i].p), pr[i].p);
+        for (j = 0; j < n; j++) {
+            r[i][j] = mont_mul(mont_mul(r[i][j], fb[j], &pr[i]), scale, &pr[i]);
+        }
+        ntt_inverse(r[i], n, roots, &pr[i]);
+    }
+
+    garner(r, pr, c, a_len + b_len, n);
+}
+
+/**
+    Private function.
+
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    ntt_mul() to multiply numbers with lengths [a_len] and [b_len].
+    If [is_sqr] is 1, then the size for squaring is returned.
+*/
+static size_t ntt_mul_tmp_len(size_t a_len, size_t b_len, int is_sqr)
+{
+    size_t n;
+
+    /* see layout of [tmp] in ntt_mul(). Reserve one chunk for alignment */
+    n = transform_len(a_len, b_len);
+    n = (NTT_PRIMES_CNT + (is_sqr ? 1 : 2)) * n + 1;
+    return (n * sizeof(ntt_word) + BIG_INT_WORD_BYTES_CNT - 1) / BIG_INT_WORD_BYTES_CNT;
+}
+
+/**
+    Calculates
+        c = a * b
+    by number-theoretic transform modulo three primes.
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+        2) length(a) + length(b) <= BIG_INT_NTT_MAX_LEN
+        3) [c] must points to array of size length(a) + length(b)
+        4) address [c] cannot be equal to [a] or [b]
+        5) [tmp] must points to array of size, returned by
+           low_level_mul_ntt_tmp_len(length(a), length(b))
+*/
+void low_level_mul_ntt(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(a_len + b_len <= BIG_INT_NTT_MAX_LEN);
+    assert(a != c);
+    assert(b != c);
+
+    ntt_mul(a, a_len, b, b_len, c, tmp);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_ntt() to multiply numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) a_len >= b_len > 0
+        2) a_len + b_len <= BIG_INT_NTT_MAX_LEN
+*/
+size_t low_level_mul_ntt_tmp_len(size_t a_len, size_t b_len)
+{
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(a_len + b_len <= BIG_INT_NTT_MAX_LEN);
+
+    return ntt_mul_tmp_len(a_len, b_len, 0);
+}
+
+/**
+    Calculates
+        c = a * a
+    by number-theoretic transform modulo three primes.
+    Only one forward transform is calculated for every prime.
+
+    Restrictions:
+        1) length(a) > 0
+        2) 2 * length(a) <= BIG_INT_NTT_MAX_LEN
+        3) [c] must points to array of size 2 * length(a)
+        4) address [c] cannot be equal to [a]
+        5) [tmp] must points to array of size, returned by
+           low_level_sqr_ntt_tmp_len(length(a))
+*/
+void low_level_sqr_ntt(const big_int_word *a, const big_int_word *a_end,
+                       big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len;
+
+    a_len = a_end - a;
+
+    assert(a_len > 0);
+    assert(2 * a_len <= BIG_INT_NTT_MAX_LEN);
+    assert(a != c);
+
+    ntt_mul(a, a_len, NULL, a_len, c, tmp);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_sqr_ntt() to square number with length [a_len].
+
+    Restrictions:
+        1) a_len > 0
+        2) 2 * a_len <= BIG_INT_NTT_MAX_LEN
+*/
+size_t low_level_sqr_ntt_tmp_len(size_t a_len)
+{
+    assert(a_len > 0);
+    assert(2 * a_len <= BIG_INT_NTT_MAX_LEN);
+
+    return ntt_mul_tmp_len(a_len, a_len, 1);
+}
@@ -0,0 +1,100 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Helpers for sliding-window exponentiation. Exponent is scanned from
+    the highest bit to the lowest one by windows of at most [window_bits]
+    bits. Every window either is a single zero bit or starts and ends
+    with bit 1, so only odd powers of the base must be precomputed:
+        a, a^3, a^5, ..., a^(2^window_bits - 1)
+*/
+
+/**
+    Returns width of the window for exponent with length [n_bits] bits,
+    which minimizes the number of multiplications:
+        2^(w - 1) for the table of odd powers plus n_bits / (w + 1)
+        for windows.
+    The width is limited by 7 bits, so the table contains at most
+    64 numbers.
+*/
+size_t low_level_pow_window_bits(size_t n_bits)
+{
+    if (n_bits <= 6) {
+        return 1;
+    }
+    if (n_bits <= 24) {
+        return 2;
+    }
+    if (n_bits <= 80) {
+        return 3;
+    }
+    if (n_bits <= 240) {
+        return 4;
+    }
+    if (n_bits <= 672) {
+        return 5;
+    }
+    if (n_bits <= 1792) {
+        return 6;
+    }
+    return 7;
+}
+
+/**
+    Returns value of the next window of exponent [b], which starts
+    from bit number [n_bits - 1]. Length of the window is stored to [window_len].
+    If bit [n_bits - 1] is zero, then returns 0 and [window_len] is 1.
+    Else returned value is odd and [window_len] is not greater than
+    [window_bits].
+
+    Restrictions:
+        1) n_bits > 0 and [b] must contain at least [n_bits] bits
+        2) 0 < window_bits < BIG_INT_WORD_BITS_CNT
+*/
+big_int_word low_level_pow_window(const big_int_word *b, size_t n_bits,
+                                  size_t window_bits, size_t *window_len)
+{
+    big_int_word value;
+    size_t i, len;
+
+    assert(n_bits > 0);
+    assert(window_bits > 0 && window_bits < BIG_INT_WORD_BITS_CNT);
+
+    /* [value] collects bits from [n_bits - 1] down to [n_bits - window_bits] */
+    value = 0;
+    len = 0;
+    i = n_bits;
+    while (i > 0 && len < window_bits) {
+        i--;
+        value <<= 1;
+        value |= (b[i / BIG_INT_WORD_BITS_CNT] >> (i % BIG_INT_WORD_BITS_CNT)) & 1;
+        len++;
+        if (len == 1 && !value) {
+            break;
+        }
+    }
+
+    /* the window must end with bit 1 */
+    while (value && !(value & 1)) {
+        value >>= 1;
+        len--;
+    }
+    *window_len = len;
+
+    return value;
+}
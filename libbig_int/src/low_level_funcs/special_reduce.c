@@ -0,0 +1,244 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Reduction modulo number of special form
+        m = 2^k - c_plus + c_minus,
+    where c_plus and c_minus are short (pseudo-Mersenne numbers
+    2^k - c, Solinas numbers 2^k - 2^t + 1 and so on).
+    Since 2^k = c_plus - c_minus (mod m), number
+        x = hi * 2^k + lo
+    is folded to
+        lo + hi * c_plus - hi * c_minus,
+    which is shorter than [x] by about k - length(c) bits.
+    Only nonzero digits of c_plus and c_minus are multiplied,
+    so sparse c costs a few passes of low_level_addmul_1().
+*/
+
+/**
+    Calculates
+        r = x (mod m),
+    where m = 2^k - c_plus + c_minus.
+
+    Restrictions:
+        1) m_len > 0 and m[m_len - 1] != 0
+        2) 0 < k <= m_len * BIG_INT_WORD_BITS_CNT
+        3) [c_plus] and [c_minus] must points to arrays of size c_len > 0,
+           abs(c_plus - c_minus) < 2^(k - 1). Number of foldings is about
+           length(x) / (k - length(c_plus - c_minus))
+        4) [x] must points to array of size x_len > 0
+        5) [r] must points to array of size m_len.
+           Address [r] can be equal to [x]
+        6) [tmp] must points to array of size, returned by
+           low_level_special_reduce_tmp_len(x_len, m_len, c_len)
+*/
+void low_level_special_reduce(const big_int_word *x, size_t x_len,
+                              const big_int_word *m, size_t m_len, size_t k,
+                              const big_int_word *c_plus, const big_int_word *c_minus,
+                              size_t c_len, big_int_word *r, big_int_word *tmp)
+{
+    const big_int_word *src;
+    big_int_word *y, *hi;
+    big_int_word carry;
+    size_t y_len, len, hi_len, lo_len, k_words, k_bits, i, j;
+    int is_negative;
+
+    assert(m_len > 0);
+    assert(m[m_len - 1] != 0);
+    assert(k > 0 && k <= m_len * BIG_INT_WORD_BITS_CNT);
+    assert(c_len > 0);
+    assert(x_len > 0);
+
+    /*
+        layout of [tmp]:
+            y - [max(x_len, m_len) + c_len + 2] digits. Sums
+                lo + hi * c_plus - hi * c_minus are kept in two's complement
+                form, so two spare digits are needed for carry and sign
+            hi - [max(x_len, m_len)] digits
+    */
+    y = tmp;
+    hi = y + ((x_len > m_len) ? x_len : m_len) + c_len + 2;
+
+    k_words = k / BIG_INT_WORD_BITS_CNT;
+    k_bits = k % BIG_INT_WORD_BITS_CNT;
+    lo_len = k_words + (k_bits ? 1 : 0);
+    is_negative = 0;
+
+    /* the first folding reads [x], the next ones fold [y] in place */
+    src = x;
+    len = x_len;
+    for (;;) {
+        while (len > 1 && src[len - 1] == 0) {
+            len--;
+        }
+        if (len <= k_words || (len == k_words + 1 && (src[k_words] >> k_bits) == 0)) {
+            /* src < 2^k */
+            break;
+        }
+
+        /* hi = floor(src / 2^k) */
+        hi_len = len - k_words;
+        if (k_bits) {
+            for (i = 0; i < hi_len - 1; i++) {
+                hi[i] = (big_int_word) ((src[k_words + i] >> k_bits) |
+                    (src[k_words + i + 1] << (BIG_INT_WORD_BITS_CNT - k_bits)));
+            }
+            hi[hi_len - 1] = (big_int_word) (src[len - 1] >> k_bits);
+            if (hi[hi_len - 1] == 0) {
+                hi_len--;
+            }
+        } else {
+            memcpy(hi, src + k_words, BIG_INT_WORD_BYTES_CNT * hi_len);
+        }
+
+        /* y = src (mod 2^k), higher digits of [y] are zeros */
+        y_len = ((lo_len > hi_len + c_len) ? lo_len : hi_len + c_len) + 2;
+        if (src != y) {
+            memcpy(y, src, BIG_INT_WORD_BYTES_CNT * lo_len);
+        }
+        if (k_bits) {
+            y[k_words] &= (big_int_word) (((big_int_word) 1 << k_bits) - 1);
+        }
+        memset(y + lo_len, 0, BIG_INT_WORD_BYTES_CNT *
+            (((src == y && len > y_len) ? len : y_len) - lo_len));
+
+        /* y = y + hi * c_plus - hi * c_minus (mod B^y_len) */
+        for (j = 0; j < c_len; j++) {
+            if (c_plus[j]) {
+                carry = low_level_addmul_1(hi, hi + hi_len, c_plus[j], y + j);
+                low_level_addto(y + j + hi_len, y + y_len, &carry, &carry + 1);
+            }
+        }
+        for (j = 0; j < c_len; j++) {
+            if (c_minus[j]) {
+                carry = low_level_submul_1(hi, hi + hi_len, c_minus[j], y + j);
+                low_level_subfrom(y + j + hi_len, y + y_len, &carry, &carry + 1);
+            }
+        }
+
+        /* y = -y, if y is negative */
+        if (y[y_len - 1] >> (BIG_INT_WORD_BITS_CNT - 1)) {
+            carry = 1;
+            for (i = 0; i < y_len; i++) {
+                y[i] = (big_int_word) (~y[i] + carry);
+                if (y[i]) {
+                    carry = 0;
+                }
+            }
+            is_negative ^= 1;
+        }
+        src = y;
+        len = y_len;
+    }
+
+    /* y = src, now 0 <= y < 2^k, so y < 2 * m */
+    if (src != y) {
+        memcpy(y, src, BIG_INT_WORD_BYTES_CNT * len);
+    }
+    if (len < m_len) {
+        memset(y + len, 0, BIG_INT_WORD_BYTES_CNT * (m_len - len));
+    }
+    while (low_level_cmp(y, m, m_len) >= 0) {
+        low_level_subfrom(y, y + m_len, m, m + m_len);
+    }
+
+    /* x = m - y, if x is negative and y != 0 */
+    if (is_negative) {
+        memset(hi, 0, BIG_INT_WORD_BYTES_CNT * m_len);
+        if (low_level_cmp(y, hi, m_len) != 0) {
+            memcpy(hi, m, BIG_INT_WORD_BYTES_CNT * m_len);
+            low_level_subfrom(hi, hi + m_len, y, y + m_len);
+            memcpy(y, hi, BIG_INT_WORD_BYTES_CNT * m_len);
+        }
+    }
+    memcpy(r, y, BIG_INT_WORD_BYTES_CNT * m_len);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_special_reduce()
+
+    Restrictions:
+        1) x_len > 0, m_len > 0, c_len > 0
+*/
+size_t low_level_special_reduce_tmp_len(size_t x_len, size_t m_len, size_t c_len)
+{
+    size_t len;
+
+    assert(x_len > 0);
+    assert(m_len > 0);
+    assert(c_len > 0);
+
+    len = (x_len > m_len) ? x_len : m_len;
+    return 2 * len + c_len + 2;
+}
+
+/**
+    Calculates
+        c = a * b (mod m),
+    where m = 2^k - c_plus + c_minus.
+    If [a] equals to [b], then squaring is used.
+
+    Restrictions:
+        1) 0 <= a, b < m
+        2) [a], [b] and [c] must points to arrays of size m_len.
+           Address [c] can be equal to [a] or [b]
+        3) [tmp] must points to array of size, returned by
+           low_level_special_mul_tmp_len(m_len, c_len)
+        4) other restrictions are the same as for low_level_special_reduce()
+*/
+void low_level_special_mul(const big_int_word *a, const big_int_word *b,
+                           const big_int_word *m, size_t m_len, size_t k,
+                           const big_int_word *c_plus, const big_int_word *c_minus,
+                           size_t c_len, big_int_word *c, big_int_word *tmp)
+{
+    big_int_word *x;
+
+    x = tmp;
+    tmp += 2 * m_len;
+    if (a == b) {
+        low_level_fast_sqr(a, a + m_len, x, tmp);
+    } else {
+        low_level_fast_mul(a, a + m_len, b, b + m_len, x, tmp);
+    }
+    low_level_special_reduce(x, 2 * m_len, m, m_len, k, c_plus, c_minus, c_len, c, tmp);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_special_mul()
+
+    Restrictions:
+        1) m_len > 0, c_len > 0
+*/
+size_t low_level_special_mul_tmp_len(size_t m_len, size_t c_len)
+{
+    size_t len, len1;
+
+    len = low_level_fast_mul_tmp_len(m_len, m_len);
+    len1 = low_level_fast_sqr_tmp_len(m_len);
+    if (len1 > len) {
+        len = len1;
+    }
+    len1 = low_level_special_reduce_tmp_len(2 * m_len, m_len, c_len);
+    if (len1 > len) {
+        len = len1;
+    }
+    return 2 * m_len + len;
+}
@@ -35,6 +35,13 @@ void low_level_sqr(const big_int_word *a, const big_int_word *a_end, big_int_wor
     assert(a_end - a > 0);
     assert(a != c);
 
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        low_level_sqr_adx(a, a_end, c);
+        return;
+    }
+#endif
+
     c_end = c + 2 * (a_end - a);
     /* calculate squares */
     cc = c;
@@ -36,6 +36,13 @@ void low_level_sub(big_int_word *a, big_int_word *a_end,
     assert(a_end - a >= b_end - b);
     assert(b != c);
 
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        low_level_sub_adx(a, a_end, b, b_end, c);
+        return;
+    }
+#endif
+
     flag_c = 0;
     do {
         if (flag_c) {
@@ -55,3 +62,49 @@ void low_level_sub(big_int_word *a, big_int_word *a_end,
         *c++ = *a++;
     }
 }
+
+/**
+    Calculates
+        a = a - b
+
+    Returns borrow (0 or 1) from the highest digit of [a].
+    If borrow is 1, then [a] contains a - b + base^length(a).
+
+    Restrictions:
+        1) length(a) >= length(b) > 0
+*/
+big_int_word low_level_subfrom(big_int_word *a, big_int_word *a_end,
+                               const big_int_word *b, const big_int_word *b_end)
+{
+    big_int_word flag_c, tmp;
+
+    assert(b_end - b > 0);
+    assert(a_end - a >= b_end - b);
+
+#if defined(BIG_INT_X86_64_ASM)
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) {
+        return low_level_subfrom_adx(a, a_end, b, b_end);
+    }
+#endif
+
+    flag_c = 0;
+    do {
+        tmp = *a;
+        if (flag_c) {
+            flag_c = (tmp <= *b) ? 1 : 0;
+            *a++ = tmp + ~(*b++);
+        } else {
+            flag_c = (tmp < *b) ? 1 : 0;
+            *a++ = tmp - *b++;
+        }
+    } while (b < b_end);
+
+    /* move borrow up to the higher digits of [a] */
+    while (flag_c && a < a_end) {
+        if ((*a++)--) {
+            flag_c = 0;
+        }
+    }
+
+    return flag_c;
+}
@@ -0,0 +1,898 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+#define NEG_SIGN(sign) ((sign) == PLUS ? MINUS : PLUS)
+
+/*
+    Private functions for signed arithmetic on fixed-length numbers.
+    Each signed number is stored as array of [n] digits with separate sign.
+*/
+static int cmp_ext(const big_int_word *a, size_t n, const big_int_word *b, size_t b_len);
+static void s_add(big_int_word *a, sign_type *a_sign, size_t n,
+                  const big_int_word *b, size_t b_len, sign_type b_sign);
+static void s_lshift(big_int_word *a, size_t n, size_t n_bits);
+static void s_rshift(big_int_word *a, size_t n, size_t n_bits);
+static void s_div_small(big_int_word *a, size_t n, big_int_word d);
+static void s_mul_small(big_int_word *a, size_t n, big_int_word d);
+static void copy_lshift(big_int_word *dst, size_t n, const big_int_word *src, size_t src_len,
+                        size_t n_bits);
+static void eval_poly(big_int_word *dst, sign_type *sign, size_t n,
+                      const big_int_word *a, size_t a_len, size_t k, size_t parts,
+                      int x, int is_reversed);
+static void add_coeffs(big_int_word *c, size_t c_len, size_t k,
+                       big_int_word **r, const sign_type *r_sign, size_t r_cnt, size_t n);
+static void toom3_interpolate(big_int_word *c, size_t c_len, size_t k,
+                              big_int_word *v1, big_int_word *vm1, sign_type vm1_sign,
+                              big_int_word *v2, big_int_word *t);
+static void toom4_interpolate(big_int_word *c, size_t c_len, size_t k,
+                              big_int_word *v1, big_int_word *vm1, sign_type vm1_sign,
+                              big_int_word *v2, big_int_word *vm2, sign_type vm2_sign,
+                              big_int_word *vh, big_int_word *t);
+
+/**
+    Private function.
+
+    Compares [a] with length [n] and [b] with length [b_len].
+
+    Returns:
+        1, if [a] > [b]
+        0, if [a] = [b]
+        -1, if [a] < [b]
+
+    Restrictions:
+        1) n >= b_len > 0
+*/
+static int cmp_ext(const big_int_word *a, size_t n, const big_int_word *b, size_t b_len)
+{
+    const big_int_word *aa;
+
+    assert(b_len > 0);
+    assert(n >= b_len);
+
+    aa = a + n;
+    while (aa > a + b_len) {
+        if (*(--aa)) {
+            return 1;
+        }
+    }
+    return low_level_cmp(a, b, b_len);
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a + b
+    for signed numbers [a] and [b].
+
+    Restrictions:
+        1) n >= b_len > 0
+        2) result must fit into [n] digits
+*/
+static void s_add(big_int_word *a, sign_type *a_sign, size_t n,
+                  const big_int_word *b, size_t b_len, sign_type b_sign)
+{
+    big_int_word *a_end;
+    const big_int_word *b_end;
+    big_int_dword tmp;
+    big_int_word flag_c, digit;
+    int cmp_flag;
+
+    a_end = a + n;
+    if (*a_sign == b_sign) {
+        flag_c = low_level_addto(a, a_end, b, b + b_len);
+        assert(flag_c == 0);
+        (void) flag_c;
+        return;
+    }
+
+    cmp_flag = cmp_ext(a, n, b, b_len);
+    if (cmp_flag >= 0) {
+        /* abs(a) >= abs(b), so a = sign(a) * (abs(a) - abs(b)) */
+        low_level_subfrom(a, a_end, b, b + b_len);
+        if (cmp_flag == 0) {
+            *a_sign = PLUS;
+        }
+        return;
+    }
+
+    /* abs(a) < abs(b), so a = sign(b) * (abs(b) - abs(a)) */
+    b_end = b + b_len;
+    flag_c = 0;
+    do {
+        digit = (b < b_end) ? *b++ : 0;
+        tmp = digit;
+        tmp -= *a;
+        tmp -= flag_c;
+        *a++ = BIG_INT_LO_WORD(tmp);
+        flag_c = BIG_INT_HI_WORD(tmp) ? 1 : 0;
+    } while (a < a_end);
+    *a_sign = b_sign;
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a * 2^n_bits
+
+    Restrictions:
+        1) 0 < n_bits < BIG_INT_WORD_BITS_CNT
+        2) result must fit into [n] digits
+*/
+static void s_lshift(big_int_word *a, size_t n, size_t n_bits)
+{
+    big_int_word *a_end;
+    big_int_word flag_c, tmp;
+
+    assert(n_bits > 0 && n_bits < BIG_INT_WORD_BITS_CNT);
+
+    a_end = a + n;
+    flag_c = 0;
+    do {
+        tmp = *a;
+        *a++ = (tmp << n_bits) | flag_c;
+        flag_c = tmp >> (BIG_INT_WORD_BITS_CNT - n_bits);
+    } while (a < a_end);
+    assert(flag_c == 0);
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a / 2^n_bits
+
+    Restrictions:
+        1) 0 < n_bits < BIG_INT_WORD_BITS_CNT
+        2) [a] must be divisible by 2^n_bits
+*/
+static void s_rshift(big_int_word *a, size_t n, size_t n_bits)
+{
+    big_int_word *aa;
+    big_int_word flag_c, tmp;
+
+    assert(n_bits > 0 && n_bits < BIG_INT_WORD_BITS_CNT);
+    assert(!(*a & (((big_int_word) 1 << n_bits) - 1)));
+
+    aa = a + n;
+    flag_c = 0;
+    do {
+        tmp = *(--aa);
+        *aa = (tmp >> n_bits) | flag_c;
+        flag_c = tmp << (BIG_INT_WORD_BITS_CNT - n_bits);
+    } while (aa > a);
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a / d
+
+    Restrictions:
+        1) [a] must be divisible by [d]
+*/
+static void s_div_small(big_int_word *a, size_t n, big_int_word d)
+{
+    big_int_word *aa;
+    big_int_dword tmp;
+
+    assert(d > 0);
+
+    aa = a + n;
+    tmp = 0;
+    do {
+        tmp <<= BIG_INT_WORD_BITS_CNT;
+        tmp |= *(--aa);
+        *aa = BIG_INT_LO_WORD(tmp / d);
+        tmp %= d;
+    } while (aa > a);
+    assert(tmp == 0);
+}
+
+/**
+    Private function.
+
+    Calculates
+        a = a * d
+
+    Restrictions:
+        1) result must fit into [n] digits
+*/
+static void s_mul_small(big_int_word *a, size_t n, big_int_word d)
+{
+    big_int_word *a_end;
+    big_int_dword tmp;
+
+    a_end = a + n;
+    tmp = 0;
+    do {
+        tmp += (big_int_dword) d * (*a);
+        *a++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    } while (a < a_end);
+    assert(tmp == 0);
+}
+
+/**
+    Private function.
+
+    Copies [src] with length [src_len] to [dst] with length [n],
+    then shifts [dst] by [n_bits] to the left.
+
+    Restrictions:
+        1) n >= src_len > 0
+        2) 0 <= n_bits < BIG_INT_WORD_BITS_CNT
+*/
+static void copy_lshift(big_int_word *dst, size_t n, const big_int_word *src, size_t src_len,
+                        size_t n_bits)
+{
+    assert(n >= src_len);
+
+    memcpy(dst, src, BIG_INT_WORD_BYTES_CNT * src_len);
+    memset(dst + src_len, 0, BIG_INT_WORD_BYTES_CNT * (n - src_len));
+    if (n_bits) {
+        s_lshift(dst, n, n_bits);
+    }
+}
+
+/**
+    Private function.
+
+    [a] is splitted into [parts] pieces a[i] with length [k] digits
+    (the highest piece can be shorter). Calculates
+        dst = sum(a[i] * x^i), if [is_reversed] is 0
+        dst = sum(a[i] * x^(parts - 1 - i)), if [is_reversed] is 1
+    by Horner's rule.
+
+    Restrictions:
+        1) [x] can be 1, -1, 2 or -2
+        2) [dst] must points to array of size [n], where n > k
+*/
+static void eval_poly(big_int_word *dst, sign_type *sign, size_t n,
+                      const big_int_word *a, size_t a_len, size_t k, size_t parts,
+                      int x, int is_reversed)
+{
+    size_t i, j, len;
+
+    assert(x == 1 || x == -1 || x == 2 || x == -2);
+    assert(n > k);
+    assert(a_len > (parts - 1) * k);
+
+    *sign = PLUS;
+    for (i = 0; i < parts; i++) {
+        j = is_reversed ? i : parts - 1 - i;
+        len = (j == parts - 1) ? a_len - j * k : k;
+        if (i == 0) {
+            copy_lshift(dst, n, a + j * k, len, 0);
+            continue;
+        }
+        if (x == 2 || x == -2) {
+            s_lshift(dst, n, 1);
+        }
+        if (x < 0 && *sign == PLUS) {
+            *sign = MINUS;
+        } else if (x < 0) {
+            *sign = PLUS;
+        }
+        s_add(dst, sign, n, a + j * k, len, PLUS);
+    }
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = c + sum(r[i] * B^((i + 1) * k)),
+    where B = 2^BIG_INT_WORD_BITS_CNT.
+    Every r[i] is non-negative number with length [n] digits.
+    Higher digits of r[i], which are out of [c], must be zeros.
+*/
+static void add_coeffs(big_int_word *c, size_t c_len, size_t k,
+                       big_int_word **r, const sign_type *r_sign, size_t r_cnt, size_t n)
+{
+    size_t i, len, offset;
+    big_int_word flag_c;
+
+    for (i = 0; i < r_cnt; i++) {
+        offset = (i + 1) * k;
+        len = n;
+        while (len > c_len - offset) {
+            --len;
+            assert(r[i][len] == 0);
+        }
+        while (len > 0 && r[i][len - 1] == 0) {
+            --len;
+        }
+        if (len == 0) {
+            continue;
+        }
+        assert(r_sign[i] == PLUS);
+        flag_c = low_level_addto(c + offset, c + c_len, r[i], r[i] + len);
+        assert(flag_c == 0);
+        (void) flag_c;
+    }
+    (void) r_sign;
+}
+
+/**
+    Private function.
+
+    Interpolation step of Toom-Cook 3-way algorithm. Calculates
+        c = r0 + r1 * B^k + r2 * B^2k + r3 * B^3k + r4 * B^4k
+    from values of the polynomial r(x) = r4 * x^4 + ... + r1 * x + r0
+    at points 0, 1, -1, 2, inf.
+
+    On entry:
+        c[0 .. 2k) = r(0) = r0
+        c[2k .. 4k) = 0
+        c[4k .. c_len) = r(inf) = r4
+        v1 = r(1), vm1 = r(-1) with sign [vm1_sign], v2 = r(2)
+    [v1], [vm1], [v2] and [t] have length 2k + 2 digits. They are destroyed.
+*/
+static void toom3_interpolate(big_int_word *c, size_t c_len, size_t k,
+                              big_int_word *v1, big_int_word *vm1, sign_type vm1_sign,
+                              big_int_word *v2, big_int_word *t)
+{
+    size_t l, r4_len;
+    big_int_word *r[3];
+    sign_type v1_sign, v2_sign, r_sign[3];
+
+    l = 2 * k + 2;
+    r4_len = c_len - 4 * k;
+    v1_sign = PLUS;
+    v2_sign = PLUS;
+
+    /*
+        vm1 = (v1 - vm1) / 2 = r1 + r3
+        v1 = v1 - vm1 - r0 - r4 = r2
+        v2 = ((v2 - r0 - 4 * r2 - 16 * r4) / 2 - vm1) / 3 = r3
+        vm1 = vm1 - v2 = r1
+    */
+    s_add(vm1, &vm1_sign, l, v1, l, MINUS);
+    vm1_sign = NEG_SIGN(vm1_sign);
+    s_rshift(vm1, l, 1);
+    s_add(v1, &v1_sign, l, vm1, l, NEG_SIGN(vm1_sign));
+    s_add(v1, &v1_sign, l, c, 2 * k, MINUS);
+    s_add(v1, &v1_sign, l, c + 4 * k, r4_len, MINUS);
+
+    s_add(v2, &v2_sign, l, c, 2 * k, MINUS);
+    copy_lshift(t, l, v1, l, 2);
+    s_add(v2, &v2_sign, l, t, l, NEG_SIGN(v1_sign));
+    copy_lshift(t, l, c + 4 * k, r4_len, 4);
+    s_add(v2, &v2_sign, l, t, l, MINUS);
+    s_rshift(v2, l, 1);
+    s_add(v2, &v2_sign, l, vm1, l, NEG_SIGN(vm1_sign));
+    s_div_small(v2, l, 3);
+    s_add(vm1, &vm1_sign, l, v2, l, NEG_SIGN(v2_sign));
+
+    /* c = c + r1 * B^k + r2 * B^2k + r3 * B^3k */
+    r[0] = vm1;
+    r[1] = v1;
+    r[2] = v2;
+    r_sign[0] = vm1_sign;
+    r_sign[1] = v1_sign;
+    r_sign[2] = v2_sign;
+    add_coeffs(c, c_len, k, r, r_sign, 3, l);
+}
+
+/**
+    Private function.
+
+    Interpolation step of Toom-Cook 4-way algorithm. Calculates
+        c = r0 + r1 * B^k + ... + r6 * B^6k
+    from values of the polynomial r(x) = r6 * x^6 + ... + r1 * x + r0
+    at points 0, 1, -1, 2, -2, 1/2, inf.
+
+    On entry:
+        c[0 .. 2k) = r(0) = r0
+        c[2k .. 6k) = 0
+        c[6k .. c_len) = r(inf) = r6
+        v1 = r(1), vm1 = r(-1) with sign [vm1_sign], v2 = r(2),
+        vm2 = r(-2) with sign [vm2_sign], vh = 64 * r(1/2)
+    [v1], [vm1], [v2], [vm2], [vh] and [t] have length 2k + 2 digits.
+    They are destroyed.
+*/
+static void toom4_interpolate(big_int_word *c, size_t c_len, size_t k,
+                              big_int_word *v1, big_int_word *vm1, sign_type vm1_sign,
+                              big_int_word *v2, big_int_word *vm2, sign_type vm2_sign,
+                              big_int_word *vh, big_int_word *t)
+{
+    size_t l, r6_len;
+    big_int_word *r[5];
+    sign_type v1_sign, v2_sign, vh_sign, r_sign[5];
+
+    l = 2 * k + 2;
+    r6_len = c_len - 6 * k;
+    v1_sign = PLUS;
+    v2_sign = PLUS;
+    vh_sign = PLUS;
+
+    /*
+        vm1 = (v1 - vm1) / 2 = r1 + r3 + r5
+        v1 = v1 - vm1 - r0 - r6 = r2 + r4
+        vm2 = (v2 - vm2) / 4 = r1 + 4 * r3 + 16 * r5
+        v2 = (v2 - 2 * vm2 - r0 - 64 * r6) / 4 = r2 + 4 * r4
+        v2 = (v2 - v1) / 3 = r4
+        v1 = v1 - v2 = r2
+        vh = (vh - 64 * r0 - 16 * r2 - 4 * r4 - r6) / 2 = 16 * r1 + 4 * r3 + r5
+        vm2 = (vm2 - vm1) / 3 = r3 + 5 * r5
+        vh = ((vh - vm1) / 3 - vm2) / 5 = r1 - r5
+        vm1 = (vh + vm2 - vm1) / 3 = r5
+        vh = vh + vm1 = r1
+        vm2 = vm2 - 5 * vm1 = r3
+    */
+    s_add(vm1, &vm1_sign, l, v1, l, MINUS);
+    vm1_sign = NEG_SIGN(vm1_sign);
+    s_rshift(vm1, l, 1);
+    s_add(v1, &v1_sign, l, vm1, l, NEG_SIGN(vm1_sign));
+    s_add(v1, &v1_sign, l, c, 2 * k, MINUS);
+    s_add(v1, &v1_sign, l, c + 6 * k, r6_len, MINUS);
+
+    s_add(vm2, &vm2_sign, l, v2, l, MINUS);
+    vm2_sign = NEG_SIGN(vm2_sign);
+    s_rshift(vm2, l, 2);
+    copy_lshift(t, l, vm2, l, 1);
+    s_add(v2, &v2_sign, l, t, l, NEG_SIGN(vm2_sign));
+    s_add(v2, &v2_sign, l, c, 2 * k, MINUS);
+    copy_lshift(t, l, c + 6 * k, r6_len, 6);
+    s_add(v2, &v2_sign, l, t, l, MINUS);
+    s_rshift(v2, l, 2);
+    s_add(v2, &v2_sign, l, v1, l, NEG_SIGN(v1_sign));
+    s_div_small(v2, l, 3);
+    s_add(v1, &v1_sign, l, v2, l, NEG_SIGN(v2_sign));
+
+    copy_lshift(t, l, c, 2 * k, 6);
+    s_add(vh, &vh_sign, l, t, l, MINUS);
+    copy_lshift(t, l, v1, l, 4);
+    s_add(vh, &vh_sign, l, t, l, NEG_SIGN(v1_sign));
+    copy_lshift(t, l, v2, l, 2);
+    s_add(vh, &vh_sign, l, t, l, NEG_SIGN(v2_sign));
+    s_add(vh, &vh_sign, l, c + 6 * k, r6_len, MINUS);
+    s_rshift(vh, l, 1);
+
+    s_add(vm2, &vm2_sign, l, vm1, l, NEG_SIGN(vm1_sign));
+    s_div_small(vm2, l, 3);
+    s_add(vh, &vh_sign, l, vm1, l, NEG_SIGN(vm1_sign));
+    s_div_small(vh, l, 3);
+    s_add(vh, &vh_sign, l, vm2, l, NEG_SIGN(vm2_sign));
+    s_div_small(vh, l, 5);
+
+    s_add(vm1, &vm1_sign, l, vh, l, NEG_SIGN(vh_sign));
+    s_add(vm1, &vm1_sign, l, vm2, l, NEG_SIGN(vm2_sign));
+    vm1_sign = NEG_SIGN(vm1_sign);
+    s_div_small(vm1, l, 3);
+    s_add(vh, &vh_sign, l, vm1, l, vm1_sign);
+    copy_lshift(t, l, vm1, l, 0);
+    s_mul_small(t, l, 5);
+    s_add(vm2, &vm2_sign, l, t, l, NEG_SIGN(vm1_sign));
+
+    /* c = c + r1 * B^k + r2 * B^2k + r3 * B^3k + r4 * B^4k + r5 * B^5k */
+    r[0] = vh;
+    r[1] = v1;
+    r[2] = vm2;
+    r[3] = v2;
+    r[4] = vm1;
+    r_sign[0] = vh_sign;
+    r_sign[1] = v1_sign;
+    r_sign[2] = vm2_sign;
+    r_sign[3] = v2_sign;
+    r_sign[4] = vm1_sign;
+    add_coeffs(c, c_len, k, r, r_sign, 5, l);
+}
+
+/**
+    Calculates
+        c = a * b
+    by Toom-Cook 3-way algorithm.
+
+    [a] and [b] are splitted into 3 pieces with length k = ceil(length(a) / 3)
+    digits, so a = a(B^k) and b = b(B^k) for polynomials
+        a(x) = a2 * x^2 + a1 * x + a0
+        b(x) = b2 * x^2 + b1 * x + b0
+    Product of these polynomials is evaluated at points 0, 1, -1, 2, inf,
+    then interpolated. Products at points are calculated by low_level_fast_mul().
+
+    Restrictions:
+        1) length(a) >= length(b) > 2 * ceil(length(a) / 3)
+        2) [c] must points to array of size length(a) + length(b)
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_mul_toom3_tmp_len(length(a), length(b))
+*/
+void low_level_mul_toom3(const big_int_word *a, const big_int_word *a_end,
+                         const big_int_word *b, const big_int_word *b_end,
+                         big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len, k, n, l;
+    big_int_word *ea, *eb, *v1, *vm1, *v2, *t;
+    sign_type ea_sign, eb_sign, vm1_sign;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+    k = (a_len + 2) / 3;
+
+    assert(b_len > 2 * k);
+    assert(a_len >= b_len);
+    assert(a != c);
+    assert(b != c);
+
+    /*
+        layout of [tmp]:
+            ea, eb - values of a(x) and b(x) - [k + 1] digits
+            v1, vm1, v2, t - [2k + 2] digits
+            the rest is used by recursive calls
+    */
+    n = k + 1;
+    l = 2 * n;
+    ea = tmp;
+    eb = ea + n;
+    v1 = eb + n;
+    vm1 = v1 + l;
+    v2 = vm1 + l;
+    t = v2 + l;
+    tmp = t + l;
+
+    /* v1 = a(1) * b(1) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, 1, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 3, 1, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, v1, tmp);
+
+    /* vm1 = a(-1) * b(-1) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, -1, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 3, -1, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, vm1, tmp);
+    vm1_sign = (ea_sign == eb_sign) ? PLUS : MINUS;
+
+    /* v2 = a(2) * b(2) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, 2, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 3, 2, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, v2, tmp);
+
+    /* r0 = a0 * b0, r4 = a2 * b2. Save them directly to [c] */
+    memset(c + 2 * k, 0, BIG_INT_WORD_BYTES_CNT * 2 * k);
+    low_level_fast_mul(a, a + k, b, b + k, c, tmp);
+    low_level_fast_mul(a + 2 * k, a_end, b + 2 * k, b_end, c + 4 * k, tmp);
+
+    toom3_interpolate(c, a_len + b_len, k, v1, vm1, vm1_sign, v2, t);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_toom3() to multiply numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) a_len >= b_len > 2 * ceil(a_len / 3)
+*/
+size_t low_level_mul_toom3_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t k, n, len, len1;
+
+    k = (a_len + 2) / 3;
+    assert(b_len > 2 * k);
+    assert(a_len >= b_len);
+
+    /* see layout of [tmp] in low_level_mul_toom3() */
+    n = k + 1;
+    len = low_level_fast_mul_tmp_len(n, n);
+    len1 = low_level_fast_mul_tmp_len(a_len - 2 * k, b_len - 2 * k);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_mul_tmp_len(k, k);
+    len = (len > len1) ? len : len1;
+
+    return 2 * n + 8 * n + len;
+}
+
+/**
+    Calculates
+        c = a * a
+    by Toom-Cook 3-way algorithm. See low_level_mul_toom3() for details.
+    Squares at points are calculated by low_level_fast_sqr().
+
+    Restrictions:
+        1) length(a) > 4
+        2) [c] must points to array of size 2 * length(a)
+        3) address [c] cannot be equal to [a]
+        4) [tmp] must points to array of size, returned by
+           low_level_sqr_toom3_tmp_len(length(a))
+*/
+void low_level_sqr_toom3(const big_int_word *a, const big_int_word *a_end,
+                         big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, k, n, l;
+    big_int_word *ea, *v1, *vm1, *v2, *t;
+    sign_type ea_sign;
+
+    a_len = a_end - a;
+    k = (a_len + 2) / 3;
+
+    assert(a_len > 4);
+    assert(a != c);
+
+    /*
+        layout of [tmp]:
+            ea - values of a(x) - [k + 1] digits
+            v1, vm1, v2, t - [2k + 2] digits
+            the rest is used by recursive calls
+    */
+    n = k + 1;
+    l = 2 * n;
+    ea = tmp;
+    v1 = ea + n;
+    vm1 = v1 + l;
+    v2 = vm1 + l;
+    t = v2 + l;
+    tmp = t + l;
+
+    /* v1 = a(1)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, 1, 0);
+    low_level_fast_sqr(ea, ea + n, v1, tmp);
+
+    /* vm1 = a(-1)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, -1, 0);
+    low_level_fast_sqr(ea, ea + n, vm1, tmp);
+
+    /* v2 = a(2)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 3, 2, 0);
+    low_level_fast_sqr(ea, ea + n, v2, tmp);
+
+    /* r0 = a0^2, r4 = a2^2. Save them directly to [c] */
+    memset(c + 2 * k, 0, BIG_INT_WORD_BYTES_CNT * 2 * k);
+    low_level_fast_sqr(a, a + k, c, tmp);
+    low_level_fast_sqr(a + 2 * k, a_end, c + 4 * k, tmp);
+
+    toom3_interpolate(c, 2 * a_len, k, v1, vm1, PLUS, v2, t);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_sqr_toom3() to square number with length [a_len].
+
+    Restrictions:
+        1) a_len > 4
+*/
+size_t low_level_sqr_toom3_tmp_len(size_t a_len)
+{
+    size_t k, n, len, len1;
+
+    assert(a_len > 4);
+
+    /* see layout of [tmp] in low_level_sqr_toom3() */
+    k = (a_len + 2) / 3;
+    n = k + 1;
+    len = low_level_fast_sqr_tmp_len(n);
+    len1 = low_level_fast_sqr_tmp_len(a_len - 2 * k);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_sqr_tmp_len(k);
+    len = (len > len1) ? len : len1;
+
+    return n + 8 * n + len;
+}
+
+/**
+    Calculates
+        c = a * b
+    by Toom-Cook 4-way algorithm.
+
+    [a] and [b] are splitted into 4 pieces with length k = ceil(length(a) / 4)
+    digits, so a = a(B^k) and b = b(B^k) for polynomials
+        a(x) = a3 * x^3 + a2 * x^2 + a1 * x + a0
+        b(x) = b3 * x^3 + b2 * x^2 + b1 * x + b0
+    Product of these polynomials is evaluated at points 0, 1, -1, 2, -2, 1/2, inf,
+    then interpolated. Products at points are calculated by low_level_fast_mul().
+
+    Restrictions:
+        1) length(a) >= length(b) > 3 * ceil(length(a) / 4)
+        2) [c] must points to array of size length(a) + length(b)
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_mul_toom4_tmp_len(length(a), length(b))
+*/
+void low_level_mul_toom4(const big_int_word *a, const big_int_word *a_end,
+                         const big_int_word *b, const big_int_word *b_end,
+                         big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len, k, n, l;
+    big_int_word *ea, *eb, *v1, *vm1, *v2, *vm2, *vh, *t;
+    sign_type ea_sign, eb_sign, vm1_sign, vm2_sign;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+    k = (a_len + 3) / 4;
+
+    assert(b_len > 3 * k);
+    assert(a_len >= b_len);
+    assert(a != c);
+    assert(b != c);
+
+    /*
+        layout of [tmp]:
+            ea, eb - values of a(x) and b(x) - [k + 1] digits
+            v1, vm1, v2, vm2, vh, t - [2k + 2] digits
+            the rest is used by recursive calls
+    */
+    n = k + 1;
+    l = 2 * n;
+    ea = tmp;
+    eb = ea + n;
+    v1 = eb + n;
+    vm1 = v1 + l;
+    v2 = vm1 + l;
+    vm2 = v2 + l;
+    vh = vm2 + l;
+    t = vh + l;
+    tmp = t + l;
+
+    /* v1 = a(1) * b(1) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 1, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 4, 1, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, v1, tmp);
+
+    /* vm1 = a(-1) * b(-1) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, -1, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 4, -1, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, vm1, tmp);
+    vm1_sign = (ea_sign == eb_sign) ? PLUS : MINUS;
+
+    /* v2 = a(2) * b(2) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 2, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 4, 2, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, v2, tmp);
+
+    /* vm2 = a(-2) * b(-2) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, -2, 0);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 4, -2, 0);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, vm2, tmp);
+    vm2_sign = (ea_sign == eb_sign) ? PLUS : MINUS;
+
+    /* vh = 64 * a(1/2) * b(1/2) */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 2, 1);
+    eval_poly(eb, &eb_sign, n, b, b_len, k, 4, 2, 1);
+    low_level_fast_mul(ea, ea + n, eb, eb + n, vh, tmp);
+
+    /* r0 = a0 * b0, r6 = a3 * b3. Save them directly to [c] */
+    memset(c + 2 * k, 0, BIG_INT_WORD_BYTES_CNT * 4 * k);
+    low_level_fast_mul(a, a + k, b, b + k, c, tmp);
+    low_level_fast_mul(a + 3 * k, a_end, b + 3 * k, b_end, c + 6 * k, tmp);
+
+    toom4_interpolate(c, a_len + b_len, k, v1, vm1, vm1_sign, v2, vm2, vm2_sign, vh, t);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_toom4() to multiply numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) a_len >= b_len > 3 * ceil(a_len / 4)
+*/
+size_t low_level_mul_toom4_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t k, n, len, len1;
+
+    k = (a_len + 3) / 4;
+    assert(b_len > 3 * k);
+    assert(a_len >= b_len);
+
+    /* see layout of [tmp] in low_level_mul_toom4() */
+    n = k + 1;
+    len = low_level_fast_mul_tmp_len(n, n);
+    len1 = low_level_fast_mul_tmp_len(a_len - 3 * k, b_len - 3 * k);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_mul_tmp_len(k, k);
+    len = (len > len1) ? len : len1;
+
+    return 2 * n + 12 * n + len;
+}
+
+/**
+    Calculates
+        c = a * a
+    by Toom-Cook 4-way algorithm. See low_level_mul_toom4() for details.
+    Squares at points are calculated by low_level_fast_sqr().
+
+    Restrictions:
+        1) length(a) > 9
+        2) [c] must points to array of size 2 * length(a)
+        3) address [c] cannot be equal to [a]
+        4) [tmp] must points to array of size, returned by
+           low_level_sqr_toom4_tmp_len(length(a))
+*/
+void low_level_sqr_toom4(const big_int_word *a, const big_int_word *a_end,
+                         big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, k, n, l;
+    big_int_word *ea, *v1, *vm1, *v2, *vm2, *vh, *t;
+    sign_type ea_sign;
+
+    a_len = a_end - a;
+    k = (a_len + 3) / 4;
+
+    assert(a_len > 9);
+    assert(a != c);
+
+    /*
+        layout of [tmp]:
+            ea - values of a(x) - [k + 1] digits
+            v1, vm1, v2, vm2, vh, t - [2k + 2] digits
+            the rest is used by recursive calls
+    */
+    n = k + 1;
+    l = 2 * n;
+    ea = tmp;
+    v1 = ea + n;
+    vm1 = v1 + l;
+    v2 = vm1 + l;
+    vm2 = v2 + l;
+    vh = vm2 + l;
+    t = vh + l;
+    tmp = t + l;
+
+    /* v1 = a(1)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 1, 0);
+    low_level_fast_sqr(ea, ea + n, v1, tmp);
+
+    /* vm1 = a(-1)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, -1, 0);
+    low_level_fast_sqr(ea, ea + n, vm1, tmp);
+
+    /* v2 = a(2)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 2, 0);
+    low_level_fast_sqr(ea, ea + n, v2, tmp);
+
+    /* vm2 = a(-2)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, -2, 0);
+    low_level_fast_sqr(ea, ea + n, vm2, tmp);
+
+    /* vh = 64 * a(1/2)^2 */
+    eval_poly(ea, &ea_sign, n, a, a_len, k, 4, 2, 1);
+    low_level_fast_sqr(ea, ea + n, vh, tmp);
+
+    /* r0 = a0^2, r6 = a3^2. Save them directly to [c] */
+    memset(c + 2 * k, 0, BIG_INT_WORD_BYTES_CNT * 4 * k);
+    low_level_fast_sqr(a, a + k, c, tmp);
+    low_level_fast_sqr(a + 3 * k, a_end, c + 6 * k, tmp);
+
+    toom4_interpolate(c, 2 * a_len, k, v1, vm1, PLUS, v2, vm2, PLUS, vh, t);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_sqr_toom4() to square number with length [a_len].
+
+    Restrictions:
+        1) a_len > 9
+*/
+size_t low_level_sqr_toom4_tmp_len(size_t a_len)
+{
+    size_t k, n, len, len1;
+
+    assert(a_len > 9);
+
+    /* see layout of [tmp] in low_level_sqr_toom4() */
+    k = (a_len + 3) / 4;
+    n = k + 1;
+    len = low_level_fast_sqr_tmp_len(n);
+    len1 = low_level_fast_sqr_tmp_len(a_len - 3 * k);
+    len = (len > len1) ? len : len1;
+    len1 = low_level_fast_sqr_tmp_len(k);
+    len = (len > len1) ? len : len1;
+
+    return n + 12 * n + len;
+}
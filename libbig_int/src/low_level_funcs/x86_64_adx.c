@@ -0,0 +1,503 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memcpy */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Kernels for x86-64 processors with BMI2 and ADX extensions.
+    MULX does not change flags, so products can be accumulated by
+    two independent carry chains: ADCX uses only CF and ADOX uses
+    only OF.
+    Low-level functions call these kernels instead of portable C code,
+    if (low_level_cpu_features & LOW_LEVEL_CPU_ADX) is not zero.
+*/
+#if defined(BIG_INT_X86_64_ASM)
+
+static big_int_word add_n(const big_int_word *a, const big_int_word *b,
+                          big_int_word *c, size_t n);
+static big_int_word sub_n(const big_int_word *a, const big_int_word *b,
+                          big_int_word *c, size_t n);
+
+/**
+    Private function.
+
+    Calculates
+        c = a + b,
+    where length(a) = length(b) = n.
+
+    Returns carry (0 or 1).
+
+    Restrictions:
+        1) n > 0
+        2) address [c] cannot be equal to [b]
+*/
+static big_int_word add_n(const big_int_word *a, const big_int_word *b,
+                          big_int_word *c, size_t n)
+{
+    big_int_word flag_c, tmp, t0, t1;
+    size_t blocks_cnt;
+
+    /* add lower digits, which are out of 4-digit blocks */
+    flag_c = 0;
+    blocks_cnt = n / 4;
+    n %= 4;
+    while (n--) {
+        tmp = *a++ + flag_c;
+        flag_c = (tmp < flag_c) ? 1 : 0;
+        tmp += *b;
+        if (tmp < *b++) flag_c = 1;
+        *c++ = tmp;
+    }
+    if (blocks_cnt == 0) {
+        return flag_c;
+    }
+
+    /* DEC does not change CF, so carry goes through the loop */
+    __asm__ __volatile__ (
+        "neg %[flag_c]\n\t"
+        "1:\n\t"
+        "mov (%[a]), %[t0]\n\t"
+        "mov 8(%[a]), %[t1]\n\t"
+        "adc (%[b]), %[t0]\n\t"
+        "adc 8(%[b]), %[t1]\n\t"
+        "mov %[t0], (%[c])\n\t"
+        "mov %[t1], 8(%[c])\n\t"
+        "mov 16(%[a]), %[t0]\n\t"
+        "mov 24(%[a]), %[t1]\n\t"
+        "adc 16(%[b]), %[t0]\n\t"
+        "adc 24(%[b]), %[t1]\n\t"
+        "mov %[t0], 16(%[c])\n\t"
+        "mov %[t1], 24(%[c])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[b]), %[b]\n\t"
+        "lea 32(%[c]), %[c]\n\t"
+        "dec %[n]\n\t"
+        "jnz 1b\n\t"
+        "sbb %[flag_c], %[flag_c]\n\t"
+        "neg %[flag_c]\n\t"
+        : [a] "+r" (a), [b] "+r" (b), [c] "+r" (c), [n] "+r" (blocks_cnt),
+          [flag_c] "+r" (flag_c), [t0] "=&r" (t0), [t1] "=&r" (t1)
+        :
+        : "cc", "memory");
+
+    return flag_c;
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = a - b,
+    where length(a) = length(b) = n.
+
+    Returns borrow (0 or 1).
+
+    Restrictions:
+        1) n > 0
+        2) address [c] cannot be equal to [b]
+*/
+static big_int_word sub_n(const big_int_word *a, const big_int_word *b,
+                          big_int_word *c, size_t n)
+{
+    big_int_word flag_c, tmp, t0, t1;
+    size_t blocks_cnt;
+
+    /* subtract lower digits, which are out of 4-digit blocks */
+    flag_c = 0;
+    blocks_cnt = n / 4;
+    n %= 4;
+    while (n--) {
+        tmp = *a++;
+        if (flag_c) {
+            flag_c = (tmp <= *b) ? 1 : 0;
+            *c++ = tmp + ~(*b++);
+        } else {
+            flag_c = (tmp < *b) ? 1 : 0;
+            *c++ = tmp - *b++;
+        }
+    }
+    if (blocks_cnt == 0) {
+        return flag_c;
+    }
+
+    /* DEC does not change CF, so borrow goes through the loop */
+    __asm__ __volatile__ (
+        "neg %[flag_c]\n\t"
+        "1:\n\t"
+        "mov (%[a]), %[t0]\n\t"
+        "mov 8(%[a]), %[t1]\n\t"
+        "sbb (%[b]), %[t0]\n\t"
+        "sbb 8(%[b]), %[t1]\n\t"
+        "mov %[t0], (%[c])\n\t"
+        "mov %[t1], 8(%[c])\n\t"
+        "mov 16(%[a]), %[t0]\n\t"
+        "mov 24(%[a]), %[t1]\n\t"
+        "sbb 16(%[b]), %[t0]\n\t"
+        "sbb 24(%[b]), %[t1]\n\t"
+        "mov %[t0], 16(%[c])\n\t"
+        "mov %[t1], 24(%[c])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[b]), %[b]\n\t"
+        "lea 32(%[c]), %[c]\n\t"
+        "dec %[n]\n\t"
+        "jnz 1b\n\t"
+        "sbb %[flag_c], %[flag_c]\n\t"
+        "neg %[flag_c]\n\t"
+        : [a] "+r" (a), [b] "+r" (b), [c] "+r" (c), [n] "+r" (blocks_cnt),
+          [flag_c] "+r" (flag_c), [t0] "=&r" (t0), [t1] "=&r" (t1)
+        :
+        : "cc", "memory");
+
+    return flag_c;
+}
+
+/**
+    The same as low_level_add(), but uses ADC instruction chain.
+*/
+void low_level_add_adx(big_int_word *a, big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c)
+{
+    size_t b_len;
+    big_int_word flag_c;
+
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) >= b_len);
+    assert(b != c);
+
+    flag_c = add_n(a, b, c, b_len);
+
+    /* move carry up to the higher digits */
+    a += b_len;
+    c += b_len;
+    while (flag_c && a < a_end) {
+        *c = *a++ + 1;
+        flag_c = *c++ ? 0 : 1;
+    }
+    if (a != c && a < a_end) {
+        memcpy(c, a, BIG_INT_WORD_BYTES_CNT * (a_end - a));
+    }
+    c += a_end - a;
+    *c = flag_c;
+}
+
+/**
+    The same as low_level_sub(), but uses SBB instruction chain.
+*/
+void low_level_sub_adx(big_int_word *a, big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c)
+{
+    size_t b_len;
+    big_int_word flag_c;
+
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) >= b_len);
+    assert(b != c);
+
+    flag_c = sub_n(a, b, c, b_len);
+
+    /* move borrow up to the higher digits */
+    a += b_len;
+    c += b_len;
+    while (flag_c && a < a_end) {
+        flag_c = *a ? 0 : 1;
+        *c++ = *a++ - 1;
+    }
+    if (a != c && a < a_end) {
+        memcpy(c, a, BIG_INT_WORD_BYTES_CNT * (a_end - a));
+    }
+}
+
+/**
+    The same as low_level_addto(), but uses ADC instruction chain.
+*/
+big_int_word low_level_addto_adx(big_int_word *a, big_int_word *a_end,
+                                 const big_int_word *b, const big_int_word *b_end)
+{
+    size_t b_len;
+    big_int_word flag_c;
+
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) >= b_len);
+
+    flag_c = add_n(a, b, a, b_len);
+
+    /* move carry up to the higher digits of [a] */
+    a += b_len;
+    while (flag_c && a < a_end) {
+        if (++(*a++)) {
+            flag_c = 0;
+        }
+    }
+
+    return flag_c;
+}
+
+/**
+    The same as low_level_subfrom(), but uses SBB instruction chain.
+*/
+big_int_word low_level_subfrom_adx(big_int_word *a, big_int_word *a_end,
+                                   const big_int_word *b, const big_int_word *b_end)
+{
+    size_t b_len;
+    big_int_word flag_c;
+
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert((size_t) (a_end - a) >= b_len);
+
+    flag_c = sub_n(a, b, a, b_len);
+
+    /* move borrow up to the higher digits of [a] */
+    a += b_len;
+    while (flag_c && a < a_end) {
+        if ((*a++)--) {
+            flag_c = 0;
+        }
+    }
+
+    return flag_c;
+}
+
+/**
+    Calculates
+        c = a * b,
+    where [b] is a digit.
+
+    Returns the highest digit of product. Other digits are stored
+    into [c].
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size length(a)
+*/
+big_int_word low_level_mul_1_adx(const big_int_word *a, const big_int_word *a_end,
+                                 big_int_word b, big_int_word *c)
+{
+    big_int_dword tmp;
+    big_int_word flag_c, lo0, lo1, hi0, hi1;
+    size_t blocks_cnt, n;
+
+    assert(a_end - a > 0);
+
+    /* multiply lower digits, which are out of 4-digit blocks */
+    n = a_end - a;
+    blocks_cnt = n / 4;
+    n %= 4;
+    tmp = 0;
+    while (n--) {
+        tmp += (big_int_dword) b * (*a++);
+        *c++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    }
+    flag_c = BIG_INT_LO_WORD(tmp);
+    if (blocks_cnt == 0) {
+        return flag_c;
+    }
+
+    /*
+        [flag_c] holds the high half of previous product.
+        DEC does not change CF used by ADCX.
+    */
+    __asm__ __volatile__ (
+        "clc\n\t"
+        "1:\n\t"
+        "mulx (%[a]), %[lo0], %[hi0]\n\t"
+        "mulx 8(%[a]), %[lo1], %[hi1]\n\t"
+        "adcx %[flag_c], %[lo0]\n\t"
+        "adcx %[hi0], %[lo1]\n\t"
+        "mov %[lo0], (%[c])\n\t"
+        "mov %[lo1], 8(%[c])\n\t"
+        "mulx 16(%[a]), %[lo0], %[hi0]\n\t"
+        "mulx 24(%[a]), %[lo1], %[flag_c]\n\t"
+        "adcx %[hi1], %[lo0]\n\t"
+        "adcx %[hi0], %[lo1]\n\t"
+        "mov %[lo0], 16(%[c])\n\t"
+        "mov %[lo1], 24(%[c])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[c]), %[c]\n\t"
+        "dec %[n]\n\t"
+        "jnz 1b\n\t"
+        "adc $0, %[flag_c]\n\t"
+        : [a] "+r" (a), [c] "+r" (c), [n] "+r" (blocks_cnt), [flag_c] "+r" (flag_c),
+          [lo0] "=&r" (lo0), [lo1] "=&r" (lo1), [hi0] "=&r" (hi0), [hi1] "=&r" (hi1)
+        : "d" (b)
+        : "cc", "memory");
+
+    return flag_c;
+}
+
+/**
+    Calculates
+        c = c + a * b,
+    where [b] is a digit.
+
+    Returns carry digit from the highest digit of [c].
+
+    Restrictions:
+        1) length(a) > 0
+        2) [c] must points to array of size length(a)
+*/
+big_int_word low_level_addmul_1_adx(const big_int_word *a, const big_int_word *a_end,
+                                    big_int_word b, big_int_word *c)
+{
+    big_int_dword tmp;
+    big_int_word flag_c, lo0, lo1, hi0, hi1;
+    size_t blocks_cnt, n;
+
+    assert(a_end - a > 0);
+
+    /* multiply lower digits, which are out of 4-digit blocks */
+    n = a_end - a;
+    blocks_cnt = n / 4;
+    n %= 4;
+    tmp = 0;
+    while (n--) {
+        tmp += (big_int_dword) b * (*a++);
+        tmp += *c;
+        *c++ = BIG_INT_LO_WORD(tmp);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+    }
+    flag_c = BIG_INT_LO_WORD(tmp);
+    if (blocks_cnt == 0) {
+        return flag_c;
+    }
+
+    /*
+        [flag_c] holds the high half of previous product.
+        High halves of products are added by ADOX, digits of [c] are
+        added by ADCX. DEC changes OF, so loop counter is kept in RCX
+        and checked by JRCXZ, which does not change flags.
+    */
+    __asm__ __volatile__ (
+        "xor %k[lo0], %k[lo0]\n\t"
+        "1:\n\t"
+        "mulx (%[a]), %[lo0], %[hi0]\n\t"
+        "adox %[flag_c], %[lo0]\n\t"
+        "adcx (%[c]), %[lo0]\n\t"
+        "mov %[lo0], (%[c])\n\t"
+        "mulx 8(%[a]), %[lo1], %[hi1]\n\t"
+        "adox %[hi0], %[lo1]\n\t"
+        "adcx 8(%[c]), %[lo1]\n\t"
+        "mov %[lo1], 8(%[c])\n\t"
+        "mulx 16(%[a]), %[lo0], %[hi0]\n\t"
+        "adox %[hi1], %[lo0]\n\t"
+        "adcx 16(%[c]), %[lo0]\n\t"
+        "mov %[lo0], 16(%[c])\n\t"
+        "mulx 24(%[a]), %[lo1], %[flag_c]\n\t"
+        "adox %[hi0], %[lo1]\n\t"
+        "adcx 24(%[c]), %[lo1]\n\t"
+        "mov %[lo1], 24(%[c])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[c]), %[c]\n\t"
+        "lea -1(%[n]), %[n]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %k[lo0]\n\t"
+        "adox %[lo0], %[flag_c]\n\t"
+        "adcx %[lo0], %[flag_c]\n\t"
+        : [a] "+r" (a), [c] "+r" (c), [n] "+c" (blocks_cnt), [flag_c] "+r" (flag_c),
+          [lo0] "=&r" (lo0), [lo1] "=&r" (lo1), [hi0] "=&r" (hi0), [hi1] "=&r" (hi1)
+        : "d" (b)
+        : "cc", "memory");
+
+    return flag_c;
+}
+
+/**
+    The same as low_level_mul(), but uses MULX/ADCX/ADOX kernels.
+*/
+void low_level_mul_adx(const big_int_word *a, const big_int_word *a_end,
+                       const big_int_word *b, const big_int_word *b_end,
+                       big_int_word *c)
+{
+    size_t a_len;
+
+    assert(b_end - b > 0);
+    assert(a_end - a >= b_end - b);
+    assert(a != c);
+    assert(b != c);
+
+    a_len = a_end - a;
+    c[a_len] = low_level_mul_1_adx(a, a_end, *b++, c);
+    while (b < b_end) {
+        c++;
+        c[a_len] = low_level_addmul_1_adx(a, a_end, *b++, c);
+    }
+}
+
+/**
+    The same as low_level_sqr(), but uses MULX/ADCX/ADOX kernels.
+*/
+void low_level_sqr_adx(const big_int_word *a, const big_int_word *a_end, big_int_word *c)
+{
+    big_int_dword tmp;
+    big_int_word *cc, *c_end;
+    big_int_word lo, hi, flag_c, flag_shift;
+    size_t a_len, i;
+
+    assert(a_end - a > 0);
+    assert(a != c);
+
+    a_len = a_end - a;
+    c_end = c + 2 * a_len;
+    if (a_len == 1) {
+        tmp = (big_int_dword) (*a) * (*a);
+        c[0] = BIG_INT_LO_WORD(tmp);
+        c[1] = BIG_INT_HI_WORD(tmp);
+        return;
+    }
+
+    /* calculate off-diagonal products a[i] * a[j], i < j */
+    c[0] = 0;
+    c[a_len] = low_level_mul_1_adx(a + 1, a_end, a[0], c + 1);
+    for (i = 1; i < a_len - 1; i++) {
+        c[a_len + i] = low_level_addmul_1_adx(a + i + 1, a_end, a[i], c + 2 * i + 1);
+    }
+    c[2 * a_len - 1] = 0;
+
+    /* c = 2 * c + squares of digits */
+    cc = c;
+    flag_c = 0;
+    flag_shift = 0;
+    do {
+        lo = cc[0];
+        hi = cc[1];
+        tmp = *a++;
+        tmp *= tmp;
+        tmp += (lo << 1) | flag_shift;
+        tmp += flag_c;
+        *cc++ = BIG_INT_LO_WORD(tmp);
+        flag_shift = hi >> (BIG_INT_WORD_BITS_CNT - 1);
+        tmp >>= BIG_INT_WORD_BITS_CNT;
+        tmp += (hi << 1) | (lo >> (BIG_INT_WORD_BITS_CNT - 1));
+        *cc++ = BIG_INT_LO_WORD(tmp);
+        flag_c = BIG_INT_HI_WORD(tmp);
+    } while (cc < c_end);
+    assert(flag_c == 0 && flag_shift == 0);
+}
+
+#endif /* end of if defined(BIG_INT_X86_64_ASM) */
@@ -0,0 +1,393 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h>
+#include <string.h> /* for memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+
+/*
+    Multiplication kernel for x86-64 processors with AVX-512 IFMA extension.
+    Numbers are converted to 52-bit radix (every limb is stored in 64-bit
+    digit), then VPMADD52LUQ and VPMADD52HUQ instructions accumulate
+    lower and higher 52-bit halves of products of 8 limbs at once.
+    Sums of columns are collected in registers without carry propagation
+    (they cannot overflow 64 bits for numbers up to 512 digits)
+    and are normalized into 64-bit digits at the end.
+*/
+#if defined(BIG_INT_X86_64_IFMA)
+
+#include <immintrin.h>
+
+#define IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+
+/* number of zero limbs, added before and after limbs of [a] */
+#define IFMA_PAD_LEN 8
+
+#define IFMA_LIMB_BITS_CNT 52
+#define IFMA_LIMB_MASK (((big_int_word) 1 << IFMA_LIMB_BITS_CNT) - 1)
+
+/* number of 52-bit limbs in number with [len] digits */
+#define IFMA_LIMBS_CNT(len) ((BIG_INT_WORD_BITS_CNT * (len) + IFMA_LIMB_BITS_CNT - 1) / IFMA_LIMB_BITS_CNT)
+
+/*
+    minimal number of limbs, for which sqr_limbs() is faster than mul_limbs().
+    For shorter numbers masked products at diagonal take too much time.
+*/
+#define IFMA_SQR_MIN_CNT 64
+
+/* rounds [len] up to the multiple of 8 */
+#define IFMA_ROUND8(len) (((len) + 7) & ~(size_t) 7)
+
+static void to_limbs(const big_int_word *a, size_t a_len, big_int_word *limbs, size_t limbs_cnt);
+static void from_limbs(big_int_word *cols, size_t cols_cnt, big_int_word *c, big_int_word *c_end);
+static void mul_limbs(const big_int_word *a, size_t a_cnt,
+                      const big_int_word *b, size_t b_cnt, big_int_word *cols) IFMA_TARGET;
+static __mmask8 lanes_mask(size_t j2, size_t k);
+static void sqr_limbs(const big_int_word *a, size_t a_cnt, big_int_word *cols) IFMA_TARGET;
+
+/**
+    Private function.
+
+    Splits number [a] with length [a_len] into [limbs_cnt] 52-bit limbs.
+*/
+static void to_limbs(const big_int_word *a, size_t a_len, big_int_word *limbs, size_t limbs_cnt)
+{
+    size_t i, pos, j, n_bits;
+    big_int_word tmp;
+
+    for (i = 0; i < limbs_cnt; i++) {
+        pos = i * IFMA_LIMB_BITS_CNT;
+        j = pos / BIG_INT_WORD_BITS_CNT;
+        n_bits = pos % BIG_INT_WORD_BITS_CNT;
+        tmp = a[j] >> n_bits;
+        if (n_bits > BIG_INT_WORD_BITS_CNT - IFMA_LIMB_BITS_CNT && j + 1 < a_len) {
+            tmp |= a[j + 1] << (BIG_INT_WORD_BITS_CNT - n_bits);
+        }
+        limbs[i] = tmp & IFMA_LIMB_MASK;
+    }
+}
+
+/**
+    Private function.
+
+    Calculates
+        c = sum(cols[i] * 2^(52 * i))
+    Contents of [cols] is destroyed.
+
+    Restrictions:
+        1) the sum must fit into [c]
+*/
+static void from_limbs(big_int_word *cols, size_t cols_cnt, big_int_word *c, big_int_word *c_end)
+{
+    size_t i, pos, n_bits;
+    big_int_word flag_c, tmp;
+
+    /* propagate carries, so every column becomes 52-bit limb */
+    flag_c = 0;
+    for (i = 0; i < cols_cnt; i++) {
+        /* columns are less than 2^63, so [flag_c] cannot overflow */
+        flag_c += cols[i];
+        cols[i] = flag_c & IFMA_LIMB_MASK;
+        flag_c >>= IFMA_LIMB_BITS_CNT;
+    }
+    assert(flag_c == 0);
+
+    /* join limbs into digits */
+    pos = 0;
+    while (c < c_end) {
+        i = pos / IFMA_LIMB_BITS_CNT;
+        n_bits = pos % IFMA_LIMB_BITS_CNT;
+        tmp = (i < cols_cnt) ? cols[i] >> n_bits : 0;
+        if (i + 1 < cols_cnt) {
+            tmp |= cols[i + 1] << (IFMA_LIMB_BITS_CNT - n_bits);
+        }
+        if (n_bits > 2 * IFMA_LIMB_BITS_CNT - BIG_INT_WORD_BITS_CNT && i + 2 < cols_cnt) {
+            tmp |= cols[i + 2] << (2 * IFMA_LIMB_BITS_CNT - n_bits);
+        }
+        *c++ = tmp;
+        pos += BIG_INT_WORD_BITS_CNT;
+    }
+}
+
+/**
+    Private function.
+
+    Calculates columns of product of numbers [a] and [b], represented
+    by 52-bit limbs:
+        cols[k] = sum(lo(a[i] * b[j]), i + j = k) + sum(hi(a[i] * b[j]), i + j + 1 = k),
+    where lo() and hi() are lower and higher 52 bits of 104-bit product.
+
+    Restrictions:
+        1) [a] must be surrounded by IFMA_PAD_LEN zero limbs
+           from both sides
+        2) [cols] must points to array of size IFMA_ROUND8(a_cnt + b_cnt)
+*/
+static void mul_limbs(const big_int_word *a, size_t a_cnt,
+                      const big_int_word *b, size_t b_cnt, big_int_word *cols)
+{
+    __m512i lo0, hi0, lo1, hi1, bj;
+    size_t k, j, j_min, j_max, cols_cnt;
+
+    cols_cnt = a_cnt + b_cnt;
+    for (k = 0; k < cols_cnt; k += 8) {
+        /* products a[i] * b[j], which get into columns k ... k + 7 */
+        j_min = (k > a_cnt) ? k - a_cnt : 0;
+        j_max = (k + 7 < b_cnt - 1) ? k + 7 : b_cnt - 1;
+
+        lo0 = _mm512_setzero_si512();
+        hi0 = _mm512_setzero_si512();
+        lo1 = _mm512_setzero_si512();
+        hi1 = _mm512_setzero_si512();
+        for (j = j_min; j < j_max; j += 2) {
+            bj = _mm512_set1_epi64((long long) b[j]);
+            lo0 = _mm512_madd52lo_epu64(lo0, _mm512_loadu_si512(a + k - j), bj);
+            hi0 = _mm512_madd52hi_epu64(hi0, _mm512_loadu_si512(a + k - j - 1), bj);
+            bj = _mm512_set1_epi64((long long) b[j + 1]);
+            lo1 = _mm512_madd52lo_epu64(lo1, _mm512_loadu_si512(a + k - j - 1), bj);
+            hi1 = _mm512_madd52hi_epu64(hi1, _mm512_loadu_si512(a + k - j - 2), bj);
+        }
+        if (j == j_max) {
+            bj = _mm512_set1_epi64((long long) b[j]);
+            lo0 = _mm512_madd52lo_epu64(lo0, _mm512_loadu_si512(a + k - j), bj);
+            hi0 = _mm512_madd52hi_epu64(hi0, _mm512_loadu_si512(a + k - j - 1), bj);
+        }
+        lo0 = _mm512_add_epi64(lo0, hi0);
+        lo1 = _mm512_add_epi64(lo1, hi1);
+        _mm512_storeu_si512(cols + k, _mm512_add_epi64(lo0, lo1));
+    }
+}
+
+/**
+    Private function.
+
+    Returns mask of lanes t = 0 ... 7, for which j2 < k + t.
+*/
+static __mmask8 lanes_mask(size_t j2, size_t k)
+{
+    if (j2 < k) {
+        return 0xff;
+    }
+    if (j2 - k >= 7) {
+        return 0;
+    }
+    return (__mmask8) (0xff << (j2 - k + 1));
+}
+
+/**
+    Private function.
+
+    The same as mul_limbs(a, a_cnt, a, a_cnt, cols), but calculates
+    only products a[i] * a[j] with j < i, then doubles them and adds
+    squares of limbs.
+
+    Restrictions:
+        1) [a] must be surrounded by IFMA_PAD_LEN zero limbs
+           from both sides
+        2) [cols] must points to array of size IFMA_ROUND8(2 * a_cnt)
+*/
+static void sqr_limbs(const big_int_word *a, size_t a_cnt, big_int_word *cols)
+{
+    __m512i lo0, hi0, lo1, hi1, bj;
+    big_int_dword tmp;
+    size_t k, j, j_min, j_max, j_full, cols_cnt;
+
+    cols_cnt = 2 * a_cnt;
+    for (k = 0; k < cols_cnt; k += 8) {
+        /*
+            products a[i] * a[j], j < i, which get into columns k ... k + 7.
+            Lower half of product gets into column i + j, so it is added
+            into lanes with 2 * j < k + t. Higher half gets into column
+            i + j + 1, so it is added into lanes with 2 * j + 1 < k + t.
+        */
+        j_min = (k > a_cnt) ? k - a_cnt : 0;
+        j_max = (k + 6) / 2;
+        if (j_max > a_cnt - 1) {
+            j_max = a_cnt - 1;
+        }
+        /* products a[i] * a[j], j < j_full, get into all lanes */
+        j_full = (k > 2) ? (k - 1) / 2 : 0;
+        if (j_full > j_max + 1) {
+            j_full = j_max + 1;
+        }
+
+        lo0 = _mm512_setzero_si512();
+        hi0 = _mm512_setzero_si512();
+        lo1 = _mm512_setzero_si512();
+        hi1 = _mm512_setzero_si512();
+        for (j = j_min; j + 1 < j_full; j += 2) {
+            bj = _mm512_set1_epi64((long long) a[j]);
+            lo0 = _mm512_madd52lo_epu64(lo0, _mm512_loadu_si512(a + k - j), bj);
+            hi0 = _mm512_madd52hi_epu64(hi0, _mm512_loadu_si512(a + k - j - 1), bj);
+            bj = _mm512_set1_epi64((long long) a[j + 1]);
+            lo1 = _mm512_madd52lo_epu64(lo1, _mm512_loadu_si512(a + k - j - 1), bj);
+            hi1 = _mm512_madd52hi_epu64(hi1, _mm512_loadu_si512(a + k - j - 2), bj);
+        }
+        for (; j <= j_max; j++) {
+            bj = _mm512_set1_epi64((long long) a[j]);
+            lo0 = _mm512_mask_madd52lo_epu64(lo0, lanes_mask(2 * j, k), _mm512_loadu_si512(a + k - j), bj);
+            hi0 = _mm512_mask_madd52hi_epu64(hi0, lanes_mask(2 * j + 1, k), _mm512_loadu_si512(a + k - j - 1), bj);
+        }
+        lo0 = _mm512_add_epi64(lo0, hi0);
+        lo1 = _mm512_add_epi64(lo1, hi1);
+        _mm512_storeu_si512(cols + k, _mm512_slli_epi64(_mm512_add_epi64(lo0, lo1), 1));
+    }
+
+    /* add squares of limbs */
+    for (j = 0; j < a_cnt; j++) {
+        tmp = (big_int_dword) a[j] * a[j];
+        cols[2 * j] += (big_int_word) tmp & IFMA_LIMB_MASK;
+        cols[2 * j + 1] += (big_int_word) (tmp >> IFMA_LIMB_BITS_CNT);
+    }
+}
+
+/**
+    Calculates
+        c = a * b
+    using AVX-512 IFMA instructions.
+
+    Restrictions:
+        1) BIG_INT_IFMA_MAX_LEN >= length(a) >= length(b) > 0
+        2) [c] must points to array of size length(a) + length(b)
+        3) address [c] cannot be equal to [a] or [b]
+        4) [tmp] must points to array of size, returned by
+           low_level_mul_ifma_tmp_len(length(a), length(b))
+        5) (low_level_cpu_features & LOW_LEVEL_CPU_IFMA) must be non-zero
+*/
+void low_level_mul_ifma(const big_int_word *a, const big_int_word *a_end,
+                        const big_int_word *b, const big_int_word *b_end,
+                        big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, b_len, a_cnt, b_cnt;
+    big_int_word *aa, *bb, *cols;
+
+    a_len = a_end - a;
+    b_len = b_end - b;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(a_len <= BIG_INT_IFMA_MAX_LEN);
+    assert(a != c);
+    assert(b != c);
+    assert(low_level_cpu_features & LOW_LEVEL_CPU_IFMA);
+
+    /*
+        layout of [tmp]:
+            aa - limbs of [a], surrounded by IFMA_PAD_LEN zeros
+            bb - limbs of [b]
+            cols - columns of product
+    */
+    a_cnt = IFMA_LIMBS_CNT(a_len);
+    b_cnt = IFMA_LIMBS_CNT(b_len);
+    aa = tmp + IFMA_PAD_LEN;
+    bb = aa + a_cnt + IFMA_PAD_LEN;
+    cols = bb + b_cnt;
+
+    memset(tmp, 0, BIG_INT_WORD_BYTES_CNT * IFMA_PAD_LEN);
+    to_limbs(a, a_len, aa, a_cnt);
+    memset(aa + a_cnt, 0, BIG_INT_WORD_BYTES_CNT * IFMA_PAD_LEN);
+    to_limbs(b, b_len, bb, b_cnt);
+
+    mul_limbs(aa, a_cnt, bb, b_cnt, cols);
+    from_limbs(cols, a_cnt + b_cnt, c, c + a_len + b_len);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_mul_ifma() to multiply numbers with lengths [a_len] and [b_len].
+
+    Restrictions:
+        1) BIG_INT_IFMA_MAX_LEN >= a_len >= b_len > 0
+*/
+size_t low_level_mul_ifma_tmp_len(size_t a_len, size_t b_len)
+{
+    size_t a_cnt, b_cnt;
+
+    assert(b_len > 0);
+    assert(a_len >= b_len);
+    assert(a_len <= BIG_INT_IFMA_MAX_LEN);
+
+    /* see layout of [tmp] in low_level_mul_ifma() */
+    a_cnt = IFMA_LIMBS_CNT(a_len);
+    b_cnt = IFMA_LIMBS_CNT(b_len);
+    return a_cnt + 2 * IFMA_PAD_LEN + b_cnt + IFMA_ROUND8(a_cnt + b_cnt);
+}
+
+/**
+    Calculates
+        c = a * a
+    using AVX-512 IFMA instructions.
+
+    Restrictions:
+        1) BIG_INT_IFMA_MAX_LEN >= length(a) > 0
+        2) [c] must points to array of size 2 * length(a)
+        3) address [c] cannot be equal to [a]
+        4) [tmp] must points to array of size, returned by
+           low_level_sqr_ifma_tmp_len(length(a))
+        5) (low_level_cpu_features & LOW_LEVEL_CPU_IFMA) must be non-zero
+*/
+void low_level_sqr_ifma(const big_int_word *a, const big_int_word *a_end,
+                        big_int_word *c, big_int_word *tmp)
+{
+    size_t a_len, a_cnt;
+    big_int_word *aa, *cols;
+
+    a_len = a_end - a;
+
+    assert(a_len > 0);
+    assert(a_len <= BIG_INT_IFMA_MAX_LEN);
+    assert(a != c);
+    assert(low_level_cpu_features & LOW_LEVEL_CPU_IFMA);
+
+    /*
+        layout of [tmp]:
+            aa - limbs of [a], surrounded by IFMA_PAD_LEN zeros
+            cols - columns of product
+    */
+    a_cnt = IFMA_LIMBS_CNT(a_len);
+    aa = tmp + IFMA_PAD_LEN;
+    cols = aa + a_cnt + IFMA_PAD_LEN;
+
+    memset(tmp, 0, BIG_INT_WORD_BYTES_CNT * IFMA_PAD_LEN);
+    to_limbs(a, a_len, aa, a_cnt);
+    memset(aa + a_cnt, 0, BIG_INT_WORD_BYTES_CNT * IFMA_PAD_LEN);
+
+    if (a_cnt < IFMA_SQR_MIN_CNT) {
+        mul_limbs(aa, a_cnt, aa, a_cnt, cols);
+    } else {
+        sqr_limbs(aa, a_cnt, cols);
+    }
+    from_limbs(cols, 2 * a_cnt, c, c + 2 * a_len);
+}
+
+/**
+    Returns size (in digits) of temporary buffer [tmp], needed for
+    low_level_sqr_ifma() to square number with length [a_len].
+
+    Restrictions:
+        1) BIG_INT_IFMA_MAX_LEN >= a_len > 0
+*/
+size_t low_level_sqr_ifma_tmp_len(size_t a_len)
+{
+    size_t a_cnt;
+
+    assert(a_len > 0);
+    assert(a_len <= BIG_INT_IFMA_MAX_LEN);
+
+    /* see layout of [tmp] in low_level_sqr_ifma() */
+    a_cnt = IFMA_LIMBS_CNT(a_len);
+    return a_cnt + 2 * IFMA_PAD_LEN + IFMA_ROUND8(2 * a_cnt);
+}
+
+#endif /* end of if defined(BIG_INT_X86_64_IFMA) */
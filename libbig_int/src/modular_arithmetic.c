@@ -14,19 +14,28 @@
 *************************************************************************/
 #include <assert.h> /* for assert() */
 #include "big_int.h"
+#include "low_level_funcs.h"
 #include "basic_funcs.h" /* for basic big_int functions */
 #include "number_theory.h" /* for GCD function */
 #include "bitset_funcs.h"
 #include "modular_arithmetic.h"
+#include "montgomery.h" /* for Montgomery multiplication */
+#include "barrett.h" /* for Barrett reduction */
+#include "special_mod.h" /* for reduction by moduli 2^k - c */
 
 static int bin_op_mod(const big_int *a, const big_int *b,
                       const big_int *modulus, bin_op_type op, big_int *answer);
+static int batch_mul(const big_int_mont *ctx, const big_int_barrett *barrett_ctx,
+                     const big_int *a, const big_int *b, big_int *answer);
+static int find_nonresidue(const big_int *p, big_int *z);
 
 /**
     Private function.
 
     Calculates answer = a (op) b (mod modulus), where op - one
     of the operators: ADD, SUB, MUL, DIV
+    Product is reduced by foldings instead of division, if [modulus]
+    has special form 2^k - c (see special_mod.h)
 
     Returns number of error:
         0 - no errors
@@ -37,6 +46,7 @@ static int bin_op_mod(const big_int *a, const big_int *b,
                       const big_int *modulus, bin_op_type op, big_int *answer)
 {
     big_int *answer_copy = NULL;
+    big_int_special_mod *special_ctx = NULL;
     int result = 0;
 
     assert(a != NULL);
@@ -99,16 +109,27 @@ static int bin_op_mod(const big_int *a, const big_int *b,
         goto end;
     }
 
-    result = big_int_absmod(answer_copy, modulus, answer);
-    if (result) {
-        result = (result == 1) ? 1 : 5;
-        goto end;
+    if (op == MUL || op == DIV) {
+        special_ctx = big_int_special_mod_create(modulus);
+    }
+    if (special_ctx != NULL) {
+        if (big_int_special_mod_reduce(special_ctx, answer_copy, answer)) {
+            result = 5;
+            goto end;
+        }
+    } else {
+        result = big_int_absmod(answer_copy, modulus, answer);
+        if (result) {
+            result = (result == 1) ? 1 : 5;
+            goto end;
+        }
     }
 
     /*
         free allocated memory
     */
 end:
+    big_int_special_mod_destroy(special_ctx);
     if (answer_copy != answer) {
         big_int_destroy(answer_copy);
     }
@@ -116,10 +137,37 @@ end:
     return result;
 }
 
+/**
+    Private function.
+
+    Calculates
+        answer = a * b / R (mod modulus),
+    if Montgomery context [ctx] isn't NULL, else
+        answer = a * b (mod modulus)
+    by Barrett context [barrett_ctx].
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int batch_mul(const big_int_mont *ctx, const big_int_barrett *barrett_ctx,
+                     const big_int *a, const big_int *b, big_int *answer)
+{
+    if (ctx != NULL) {
+        return big_int_mont_mul(ctx, a, b, answer);
+    }
+    return big_int_barrett_mul(barrett_ctx, a, b, answer);
+}
+
 /**
     Calculate:
         answer = pow(a, b) (mod modulus)
 
+    Sliding-window exponentiation is used. Long moduli of special
+    form 2^k - c are handled by foldings (see special_mod.h), other
+    odd moduli - by Montgomery multiplication (see montgomery.h),
+    even moduli - by Barrett reduction (see barrett.h).
+
     Returns error number:
         0 - no errors
         1 - division by zero. (modulus cannot be zero)
@@ -127,11 +175,11 @@ end:
 */
 int big_int_powmod(const big_int *a, const big_int *b, const big_int *modulus, big_int *answer)
 {
-    big_int_word *bb, *bb_start;
-    size_t n_bits;
-    big_int_word tmp;
     big_int *tmp1 = NULL, *tmp2 = NULL, *a_copy = NULL;
     big_int *tmp3; /* specialliy is not assigned to NULL :) */
+    big_int_mont *ctx = NULL;
+    big_int_barrett *barrett_ctx = NULL;
+    big_int_special_mod *special_ctx = NULL;
     int result = 0;
 
     assert(a != NULL);
@@ -173,47 +221,44 @@ int big_int_powmod(const big_int *a, const big_int *b, const big_int *modulus, b
         goto end;
     }
 
-    /* main loop */
-    if (big_int_from_int(1, tmp1)) {
-        result = 7;
-        goto end;
+    if (modulus->len >= BIG_INT_SPECIAL_POW_THRESHOLD) {
+        special_ctx = big_int_special_mod_create(modulus);
     }
-    bb_start = b->num;
-    bb = bb_start + b->len;
-    tmp = *(--bb);
-    n_bits = BIG_INT_WORD_BITS_CNT;
-    while (n_bits && !(tmp >> (BIG_INT_WORD_BITS_CNT - 1))) {
-        tmp <<= 1;
-        n_bits--;
-    }
-    while (1) {
-        while (n_bits--) {
-            /* calculate tmp2 = tmp1 ^ 2 */
-            if (big_int_sqrmod(tmp1, modulus, tmp2)) {
-                result = 8;
-                goto end;
-            }
-            if (tmp >> (BIG_INT_WORD_BITS_CNT - 1)) {
-                /* calculate tmp1 = tmp2 * a_copy */
-                if (big_int_mulmod(tmp2, a_copy, modulus, tmp1)) {
-                    result = 9;
-                    goto end;
-                }
-            } else {
-                /* exchange [tmp1] <=> [tmp2] */
-                tmp3 = tmp1;
-                tmp1 = tmp2;
-                tmp2 = tmp3;
-            }
-            tmp <<= 1;
+
+    if (b->len == 1 && b->num[0] == 0) {
+        /* pow(a, 0) = 1 */
+        if (big_int_from_int(1, tmp1)) {
+            result = 7;
+            goto end;
         }
-        if (bb <= bb_start) {
-            /* stop calculation */
-            break;
+    } else if (special_ctx != NULL) {
+        /* modulus 2^k - c: use foldings instead of multiplications by modulus */
+        if (big_int_special_mod_pow(special_ctx, a_copy, b, tmp1)) {
+            result = 8;
+            goto end;
+        }
+    } else if (modulus->num[0] & 1) {
+        /* odd modulus: use Montgomery multiplication, which needs no divisions */
+        ctx = big_int_mont_create(modulus);
+        if (ctx == NULL) {
+            result = 6;
+            goto end;
+        }
+        if (big_int_mont_pow(ctx, a_copy, b, tmp1)) {
+            result = 8;
+            goto end;
+        }
+    } else {
+        /* even modulus: use Barrett reduction instead of division on every step */
+        barrett_ctx = big_int_barrett_create(modulus);
+        if (barrett_ctx == NULL) {
+            result = 6;
+            goto end;
+        }
+        if (big_int_barrett_pow(barrett_ctx, a_copy, b, tmp1)) {
+            result = 8;
+            goto end;
         }
-        /* go to the next digit of [b] */
-        n_bits = BIG_INT_WORD_BITS_CNT;
-        tmp = *(--bb);
     }
 
     /*
@@ -251,6 +296,9 @@ int big_int_powmod(const big_int *a, const big_int *b, const big_int *modulus, b
 
 end:
     /* free allocated memory */
+    big_int_special_mod_destroy(special_ctx);
+    big_int_barrett_destroy(barrett_ctx);
+    big_int_mont_destroy(ctx);
     big_int_destroy(tmp2);
     big_int_destroy(tmp1);
     big_int_destroy(a_copy);
@@ -258,6 +306,310 @@ end:
     return result;
 }
 
+/**
+    Calculate:
+        answer = pow(a[0], b[0]) * ... * pow(a[n - 1], b[n - 1]) (mod modulus)
+
+    All powers share the same chain of squarings (see big_int_mont_multi_pow()),
+    so it is much faster than [n] calls of big_int_powmod().
+    Odd moduli are handled by Montgomery multiplication (see montgomery.h),
+    even moduli - by Barrett reduction (see barrett.h).
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero. (modulus cannot be zero)
+        2 - GCD(a[i], modulus) != 1, when b[i] is negative
+        other - internal error
+*/
+int big_int_multi_powmod(const big_int **a, const big_int **b, size_t n,
+                         const big_int *modulus, big_int *answer)
+{
+    big_int **a_copy = NULL;
+    big_int_mont *ctx = NULL;
+    big_int_barrett *barrett_ctx = NULL;
+    size_t i;
+    int is_zero = 0;
+    int result = 0;
+
+    assert(a != NULL || n == 0);
+    assert(b != NULL || n == 0);
+    assert(modulus != NULL);
+    assert(answer != NULL);
+
+    /* division by zero check */
+    if (modulus->len == 1 && modulus->num[0] == 0) {
+        result = 1;
+        goto end;
+    }
+
+    if (n > 0) {
+        a_copy = (big_int **) bi_malloc(sizeof(*a_copy) * n);
+        if (a_copy == NULL) {
+            result = 3;
+            goto end;
+        }
+        for (i = 0; i < n; i++) {
+            a_copy[i] = NULL;
+        }
+    }
+
+    /*
+        normalize a[i] by mod [modulus] and store it to a_copy[i].
+        If b[i] is negative, then pow(a[i], b[i]) = pow(inv(a[i]), abs(b[i]))
+    */
+    for (i = 0; i < n; i++) {
+        a_copy[i] = big_int_create(modulus->len);
+        if (a_copy[i] == NULL) {
+            result = 4;
+            goto end;
+        }
+        if (big_int_absmod(a[i], modulus, a_copy[i])) {
+            result = 5;
+            goto end;
+        }
+        if (a_copy[i]->len == 1 && a_copy[i]->num[0] == 0) {
+            is_zero = 1;
+            continue;
+        }
+        if (b[i]->sign == MINUS) {
+            result = big_int_invmod(a_copy[i], modulus, a_copy[i]);
+            if (result) {
+                result = (result == 2) ? 2 : 6;
+                goto end;
+            }
+        }
+    }
+
+    /* pow(0, b[i]) = 0 for any b[i], as in big_int_powmod() */
+    if (is_zero) {
+        if (big_int_from_int(0, answer)) {
+            result = 7;
+        }
+        goto end;
+    }
+
+    if ((modulus->num[0] & 1) && (modulus->len > 1 || modulus->num[0] > 1)) {
+        /* odd modulus: use Montgomery multiplication, which needs no divisions */
+        ctx = big_int_mont_create(modulus);
+        if (ctx == NULL) {
+            result = 8;
+            goto end;
+        }
+        if (big_int_mont_multi_pow(ctx, (const big_int **) a_copy, b, n, answer)) {
+            result = 9;
+            goto end;
+        }
+    } else {
+        /* even modulus: use Barrett reduction instead of division on every step */
+        barrett_ctx = big_int_barrett_create(modulus);
+        if (barrett_ctx == NULL) {
+            result = 8;
+            goto end;
+        }
+        if (big_int_barrett_multi_pow(barrett_ctx, (const big_int **) a_copy, b, n, answer)) {
+            result = 9;
+            goto end;
+        }
+    }
+
+end:
+    /* free allocated memory */
+    big_int_barrett_destroy(barrett_ctx);
+    big_int_mont_destroy(ctx);
+    if (a_copy != NULL) {
+        for (i = 0; i < n; i++) {
+            big_int_destroy(a_copy[i]);
+        }
+        bi_free(a_copy);
+    }
+
+    return result;
+}
+
+/**
+    Calculate:
+        answer = pow(a1, b1) * pow(a2, b2) (mod modulus)
+
+    It is faster than two calls of big_int_powmod() and big_int_mulmod(),
+    because both powers share the same chain of squarings.
+    See big_int_multi_powmod() for details.
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero. (modulus cannot be zero)
+        2 - GCD(a1, modulus) != 1, when [b1] is negative,
+            or GCD(a2, modulus) != 1, when [b2] is negative
+        other - internal error
+*/
+int big_int_powmod2(const big_int *a1, const big_int *b1, const big_int *a2, const big_int *b2,
+                    const big_int *modulus, big_int *answer)
+{
+    const big_int *a[2], *b[2];
+
+    assert(a1 != NULL);
+    assert(b1 != NULL);
+    assert(a2 != NULL);
+    assert(b2 != NULL);
+    assert(modulus != NULL);
+    assert(answer != NULL);
+
+    a[0] = a1;
+    a[1] = a2;
+    b[0] = b1;
+    b[1] = b2;
+
+    return big_int_multi_powmod(a, b, 2, modulus, answer);
+}
+
+/**
+    Calculates RSA private operation by Chinese remainder theorem:
+        answer = pow(c, d) (mod p * q),
+    where
+        dp = d (mod p - 1),
+        dq = d (mod q - 1),
+        qinv * q = 1 (mod p).
+
+    Two exponentiations by half-size moduli [p] and [q] are made
+    instead of one exponentiation by modulus p * q. Their results are
+    combined by Garner's formula:
+        m1 = pow(c, dp) (mod p)
+        m2 = pow(c, dq) (mod q)
+        h = qinv * (m1 - m2) (mod p)
+        answer = m2 + h * q
+
+    Restrictions:
+        1) [p] and [q] must be positive and coprime
+        2) [dp] and [dq] must be non-negative
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero. ([p] or [q] is zero)
+        other - internal error
+*/
+int big_int_powmod_crt(const big_int *c, const big_int *p, const big_int *q,
+                       const big_int *dp, const big_int *dq, const big_int *qinv,
+                       big_int *answer)
+{
+    big_int *m1 = NULL, *m2 = NULL;
+    int result = 0;
+
+    assert(c != NULL);
+    assert(p != NULL);
+    assert(q != NULL);
+    assert(dp != NULL);
+    assert(dq != NULL);
+    assert(qinv != NULL);
+    assert(answer != NULL);
+
+    /* division by zero check */
+    if ((p->len == 1 && p->num[0] == 0) || (q->len == 1 && q->num[0] == 0)) {
+        result = 1;
+        goto end;
+    }
+
+    m1 = big_int_create(p->len);
+    m2 = big_int_create(q->len);
+    if (m1 == NULL || m2 == NULL) {
+        result = 2;
+        goto end;
+    }
+
+    /* m1 = pow(c, dp) (mod p), m2 = pow(c, dq) (mod q) */
+    if (big_int_powmod(c, dp, p, m1) || big_int_powmod(c, dq, q, m2)) {
+        result = 3;
+        goto end;
+    }
+
+    /* m1 = qinv * (m1 - m2) (mod p) */
+    if (big_int_submod(m1, m2, p, m1) || big_int_mulmod(m1, qinv, p, m1)) {
+        result = 4;
+        goto end;
+    }
+
+    /* answer = m2 + m1 * q */
+    if (big_int_mul(m1, q, m1) || big_int_add(m1, m2, answer)) {
+        result = 5;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    big_int_destroy(m2);
+    big_int_destroy(m1);
+
+    return result;
+}
+
+/**
+    Calculate:
+        answer = pow(a, b) (mod modulus)
+    in constant time.
+
+    Unlike big_int_powmod(), running time and memory access pattern
+    do not depend on values of [a] and [b]. There are no shortcuts
+    for special values of [a] and [b], fixed-window exponentiation
+    is used and all intermediate values have length(modulus) digits.
+    See big_int_mont_pow_ct() for details. Only lengths of numbers
+    and precomputation of Montgomery context, which depends only
+    on [modulus], can be observed.
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero. (modulus cannot be zero)
+        2 - [modulus] is even. Only odd moduli are supported
+        3 - [b] is negative
+        other - internal error
+*/
+int big_int_powmod_ct(const big_int *a, const big_int *b, const big_int *modulus, big_int *answer)
+{
+    big_int_mont *ctx = NULL;
+    int result = 0;
+
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(modulus != NULL);
+    assert(answer != NULL);
+
+    /* division by zero check */
+    if (modulus->len == 1 && modulus->num[0] == 0) {
+        result = 1;
+        goto end;
+    }
+    if (!(modulus->num[0] & 1)) {
+        result = 2;
+        goto end;
+    }
+    if (b->sign == MINUS && (b->len > 1 || b->num[0])) {
+        result = 3;
+        goto end;
+    }
+
+    /* any number by modulus 1 is 0 */
+    if (modulus->len == 1 && modulus->num[0] == 1) {
+        if (big_int_from_int(0, answer)) {
+            result = 4;
+            goto end;
+        }
+        goto end;
+    }
+
+    ctx = big_int_mont_create(modulus);
+    if (ctx == NULL) {
+        result = 5;
+        goto end;
+    }
+    if (big_int_mont_pow_ct(ctx, a, b, answer)) {
+        result = 6;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    big_int_mont_destroy(ctx);
+
+    return result;
+}
+
 /**
     Tries to find [answer]:
         a * answer = 1 (mod modulus)
@@ -339,6 +691,154 @@ end:
     return result;
 }
 
+/**
+    Calculates inverse numbers of [n] numbers in[0] - in[n - 1] by mod [modulus]:
+        in[i] * out[i] = 1 (mod modulus)
+
+    Uses Montgomery's trick: only one big_int_invmod() call and 3 * (n - 1)
+    modular multiplications. Multiplications are made by Montgomery
+    context (see montgomery.h) for odd [modulus], or by Barrett context
+    (see barrett.h) for even [modulus]. Products of Montgomery multiplications
+    aren't converted from Montgomery form: extra factors 1/R
+    in prefix products are compensated by extra factors R in their inverses.
+
+    Restrictions:
+        1) out[i] can be equal to in[i], but cannot be equal to in[j],
+           where i != j
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero. ([modulus] cannot be zero)
+        2 - GCD(in[i], modulus) != 1 for some [i]
+        other - internal error
+*/
+int big_int_invmod_batch(const big_int **in, size_t n, const big_int *modulus, big_int **out)
+{
+    big_int **prod = NULL;
+    big_int *inv = NULL, *a = NULL, *tmp = NULL;
+    big_int *tmp2; /* specialliy is not assigned to NULL :) */
+    big_int_mont *ctx = NULL;
+    big_int_barrett *barrett_ctx = NULL;
+    size_t i;
+    int result = 0;
+
+    assert(in != NULL || n == 0);
+    assert(out != NULL || n == 0);
+    assert(modulus != NULL);
+
+    if (modulus->len == 1 && modulus->num[0] == 0) {
+        /* division by zero */
+        result = 1;
+        goto end;
+    }
+    if (n == 0) {
+        goto end;
+    }
+
+    /* prod[i] = in[0] * ... * in[i] (mod modulus) */
+    prod = (big_int **) bi_malloc(sizeof(*prod) * n);
+    if (prod == NULL) {
+        result = 3;
+        goto end;
+    }
+    for (i = 0; i < n; i++) {
+        prod[i] = NULL;
+    }
+    for (i = 0; i < n; i++) {
+        prod[i] = big_int_create(modulus->len);
+        if (prod[i] == NULL) {
+            result = 4;
+            goto end;
+        }
+    }
+    inv = big_int_create(modulus->len);
+    a = big_int_create(modulus->len);
+    tmp = big_int_create(modulus->len);
+    if (inv == NULL || a == NULL || tmp == NULL) {
+        result = 5;
+        goto end;
+    }
+
+    if ((modulus->num[0] & 1) && (modulus->len > 1 || modulus->num[0] > 1)) {
+        ctx = big_int_mont_create(modulus);
+        if (ctx == NULL) {
+            result = 6;
+            goto end;
+        }
+    } else {
+        barrett_ctx = big_int_barrett_create(modulus);
+        if (barrett_ctx == NULL) {
+            result = 7;
+            goto end;
+        }
+    }
+
+    /* calculate prefix products */
+    if (big_int_absmod(in[0], modulus, prod[0])) {
+        result = 8;
+        goto end;
+    }
+    for (i = 1; i < n; i++) {
+        if (big_int_absmod(in[i], modulus, a)) {
+            result = 9;
+            goto end;
+        }
+        if (batch_mul(ctx, barrett_ctx, prod[i - 1], a, prod[i])) {
+            result = 10;
+            goto end;
+        }
+    }
+
+    /* the only inversion */
+    result = big_int_invmod(prod[n - 1], modulus, inv);
+    if (result) {
+        result = (result == 2) ? 2 : 11;
+        goto end;
+    }
+
+    /*
+        Now [inv] is inverse of prod[n - 1]. For i = n - 1 .. 1,
+        if [inv] is inverse of prod[i], then
+            out[i] = inv * prod[i - 1],
+            inverse of prod[i - 1] = inv * in[i]
+    */
+    for (i = n - 1; i > 0; i--) {
+        if (big_int_absmod(in[i], modulus, a)) {
+            result = 12;
+            goto end;
+        }
+        if (batch_mul(ctx, barrett_ctx, inv, a, tmp) ||
+            batch_mul(ctx, barrett_ctx, inv, prod[i - 1], out[i])) {
+            result = 13;
+            goto end;
+        }
+        /* exchange [inv] <=> [tmp] */
+        tmp2 = inv;
+        inv = tmp;
+        tmp = tmp2;
+    }
+    if (big_int_copy(inv, out[0])) {
+        result = 14;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    big_int_barrett_destroy(barrett_ctx);
+    big_int_mont_destroy(ctx);
+    big_int_destroy(tmp);
+    big_int_destroy(a);
+    big_int_destroy(inv);
+    if (prod != NULL) {
+        for (i = 0; i < n; i++) {
+            big_int_destroy(prod[i]);
+        }
+        bi_free(prod);
+    }
+
+    return result;
+}
+
 /**
     Calculates:
         answer = a + b (mod modulus)
@@ -380,6 +880,7 @@ int big_int_submod(const big_int *a, const big_int *b, const big_int *modulus, b
 /**
     Calculates:
         answer = a * b (mod modulus)
+    Moduli of special form 2^k - c need no division (see special_mod.h).
 
     Returns error number:
         0 - no errors
@@ -419,6 +920,7 @@ int big_int_divmod(const big_int *a, const big_int *b, const big_int *modulus, b
 /**
     Calculates:
         answer = a * a (mod modulus)
+    Moduli of special form 2^k - c need no division (see special_mod.h).
 
     Returns error number:
         0 - no errors
@@ -434,6 +936,357 @@ int big_int_sqrmod(const big_int *a, const big_int *modulus, big_int *answer)
     return bin_op_mod(a, a, modulus, MUL, answer);
 }
 
+/**
+    Private function.
+
+    Finds quadratic non-residue [z] modulo odd [p]:
+        jacobi(z, p) = -1
+    Tries z = 2, 3, 4, ... Under GRH the least non-residue of prime [p]
+    is less than 2 * ln(p)^2 < length(p)^2, so the search is bounded.
+
+    Returns error number:
+        0 - no errors
+        1 - [p] is not prime (there are no non-residues or GCD(z, p) != 1)
+        other - internal error
+*/
+static int find_nonresidue(const big_int *p, big_int *z)
+{
+    big_int *tmp = NULL;
+    unsigned int bits_cnt;
+    int n, n_max, jacobi;
+    int result = 0;
+
+    assert(p != NULL);
+    assert(z != NULL);
+
+    /* perfect squares have no non-residues */
+    tmp = big_int_create(1);
+    if (tmp == NULL) {
+        result = 2;
+        goto end;
+    }
+    if (big_int_sqrt_rem(p, tmp)) {
+        result = 3;
+        goto end;
+    }
+    if (tmp->len == 1 && tmp->num[0] == 0) {
+        result = 1;
+        goto end;
+    }
+
+    big_int_bit_length(p, &bits_cnt);
+    n_max = (bits_cnt < 0x8000) ? (int) (bits_cnt * bits_cnt) : 0x40000000;
+    for (n = 2; n < n_max; n++) {
+        if (big_int_from_int(n, z)) {
+            result = 4;
+            goto end;
+        }
+        if (big_int_jacobi(z, p, &jacobi)) {
+            result = 5;
+            goto end;
+        }
+        if (jacobi == -1) {
+            goto end;
+        }
+        if (jacobi == 0) {
+            /*
+                prime [p] has non-residue less than [p],
+                so [z] is a proper divisor of [p]
+            */
+            result = 1;
+            goto end;
+        }
+    }
+    result = 1;
+
+end:
+    /* free allocated memory */
+    big_int_destroy(tmp);
+
+    return result;
+}
+
+/**
+    Calculates square root of [a] modulo prime [p]:
+        answer * answer = a (mod p)
+
+    The least of two roots [answer] and p - answer is returned.
+    Existence of the root is checked by big_int_jacobi(), then:
+        - if p = 3 (mod 4), answer = pow(a, (p + 1) / 4)
+        - if p = 5 (mod 8), Atkin's formula is used:
+            v = pow(2 * a, (p - 5) / 8), i = 2 * a * v * v,
+            answer = a * v * (i - 1)
+        - else Tonelli-Shanks algorithm is used. Non-residue z is found
+          only once and its powers pow(z, Q * 2^j), where p - 1 = Q * 2^S,
+          are cached, so every step of the algorithm costs two
+          multiplications instead of a chain of squarings.
+    Only one exponentiation is made in every case. All multiplications
+    are made in Montgomery form (see montgomery.h).
+
+    Restrictions:
+        1) [p] must be prime. Sign of [p] is ignored
+
+    Returns error number:
+        0 - no errors
+        1 - division by zero ([p] cannot be zero)
+        2 - [a] is not a quadratic residue modulo [p]
+        3 - [p] is not prime. Composite [p] is not always detected,
+            but [answer] is always checked: answer * answer = a (mod p)
+        other - internal error
+*/
+int big_int_sqrtmod(const big_int *a, const big_int *p, big_int *answer)
+{
+    big_int *p_abs = NULL, *a_copy = NULL, *e = NULL, *x = NULL, *t = NULL;
+    big_int *w = NULL, *am = NULL, *one = NULL;
+    big_int **g = NULL;
+    big_int_mont *ctx = NULL;
+    size_t s = 0, m, i, j;
+    int jacobi, cmp_flag;
+    int result = 0;
+
+    assert(a != NULL);
+    assert(p != NULL);
+    assert(answer != NULL);
+
+    /* division by zero check */
+    if (p->len == 1 && p->num[0] == 0) {
+        result = 1;
+        goto end;
+    }
+
+    p_abs = big_int_create(p->len);
+    a_copy = big_int_create(p->len);
+    e = big_int_create(p->len);
+    x = big_int_create(p->len);
+    t = big_int_create(p->len);
+    w = big_int_create(p->len);
+    am = big_int_create(p->len);
+    one = big_int_create(p->len);
+    if (p_abs == NULL || a_copy == NULL || e == NULL || x == NULL ||
+        t == NULL || w == NULL || am == NULL || one == NULL) {
+        result = 4;
+        goto end;
+    }
+    if (big_int_abs(p, p_abs) || big_int_absmod(a, p_abs, a_copy)) {
+        result = 5;
+        goto end;
+    }
+
+    /* sqrt(0) = 0, sqrt(1) = 1. It covers p = 2 too */
+    if (a_copy->len == 1 && (a_copy->num[0] == 0 || a_copy->num[0] == 1)) {
+        if (big_int_copy(a_copy, answer)) {
+            result = 6;
+            goto end;
+        }
+        goto end;
+    }
+    if (!(p_abs->num[0] & 1)) {
+        /* even [p] > 2 is not prime */
+        result = 3;
+        goto end;
+    }
+
+    if (big_int_jacobi(a_copy, p_abs, &jacobi)) {
+        result = 7;
+        goto end;
+    }
+    if (jacobi == -1) {
+        result = 2;
+        goto end;
+    }
+    if (jacobi == 0) {
+        /* GCD(a, p) != 1 */
+        result = 3;
+        goto end;
+    }
+
+    ctx = big_int_mont_create(p_abs);
+    if (ctx == NULL) {
+        result = 8;
+        goto end;
+    }
+    /* [am] = a and [one] = 1 in Montgomery form */
+    if (big_int_from_int(1, one) || big_int_mont_to(ctx, one, one) ||
+        big_int_mont_to(ctx, a_copy, am)) {
+        result = 9;
+        goto end;
+    }
+
+    if ((p_abs->num[0] & 3) == 3) {
+        /* x = pow(a, (p + 1) / 4) */
+        if (big_int_rshift(p_abs, 2, e) || big_int_inc(e, e) ||
+            big_int_mont_pow(ctx, a_copy, e, x) || big_int_mont_to(ctx, x, x)) {
+            result = 10;
+            goto end;
+        }
+    } else if ((p_abs->num[0] & 7) == 5) {
+        /* w = 2 * a */
+        if (big_int_add(a_copy, a_copy, w)) {
+            result = 11;
+            goto end;
+        }
+        big_int_cmp(w, p_abs, &cmp_flag);
+        if (cmp_flag >= 0 && big_int_sub(w, p_abs, w)) {
+            result = 11;
+            goto end;
+        }
+        /* x = v = pow(2 * a, (p - 5) / 8), t = i = 2 * a * v * v */
+        if (big_int_rshift(p_abs, 3, e) || big_int_mont_pow(ctx, w, e, x) ||
+            big_int_mont_to(ctx, x, x) || big_int_mont_to(ctx, w, w) ||
+            big_int_mont_mul(ctx, w, x, t) || big_int_mont_mul(ctx, t, x, t)) {
+            result = 12;
+            goto end;
+        }
+        /* t = i - 1 */
+        if (big_int_sub(t, one, t)) {
+            result = 13;
+            goto end;
+        }
+        if (t->sign == MINUS && big_int_add(t, p_abs, t)) {
+            result = 13;
+            goto end;
+        }
+        /* x = a * v * (i - 1) */
+        if (big_int_mont_mul(ctx, am, x, x) || big_int_mont_mul(ctx, x, t, x)) {
+            result = 14;
+            goto end;
+        }
+    } else {
+        /* p - 1 = Q * 2^s. Since [p] is odd, Q = p >> s */
+        if (big_int_scan1_bit(p_abs, 1, &s)) {
+            result = 15;
+            goto end;
+        }
+
+        /*
+            w = pow(a, (Q - 1) / 2), x = a * w = pow(a, (Q + 1) / 2),
+            t = x * w = pow(a, Q). Invariant of the loop below:
+            x * x = a * t (mod p)
+        */
+        if (big_int_rshift(p_abs, (int) s + 1, e) || big_int_mont_pow(ctx, a_copy, e, w) ||
+            big_int_mont_to(ctx, w, w) || big_int_mont_mul(ctx, am, w, x) ||
+            big_int_mont_mul(ctx, x, w, t)) {
+            result = 16;
+            goto end;
+        }
+
+        /* g[j] = pow(z, Q * 2^j), where z is a non-residue */
+        g = (big_int **) bi_malloc(sizeof(*g) * s);
+        if (g == NULL) {
+            result = 17;
+            goto end;
+        }
+        for (j = 0; j < s; j++) {
+            g[j] = NULL;
+        }
+        for (j = 0; j < s; j++) {
+            g[j] = big_int_create(p->len);
+            if (g[j] == NULL) {
+                result = 17;
+                goto end;
+            }
+        }
+        switch (find_nonresidue(p_abs, w)) {
+            case 0: /* there is no errors */
+                break;
+            case 1: /* [p] is not prime */
+                result = 3;
+                goto end;
+            default: /* internal error */
+                result = 18;
+                goto end;
+        }
+        if (big_int_rshift(p_abs, (int) s, e) || big_int_mont_pow(ctx, w, e, g[0]) ||
+            big_int_mont_to(ctx, g[0], g[0])) {
+            result = 19;
+            goto end;
+        }
+        for (j = 1; j < s; j++) {
+            if (big_int_mont_sqr(ctx, g[j - 1], g[j])) {
+                result = 19;
+                goto end;
+            }
+        }
+
+        m = s;
+        for (;;) {
+            big_int_cmp(t, one, &cmp_flag);
+            if (cmp_flag == 0) {
+                break;
+            }
+            /* find the least i: pow(t, 2^i) = 1 */
+            if (big_int_copy(t, w)) {
+                result = 20;
+                goto end;
+            }
+            for (i = 1; i < m; i++) {
+                if (big_int_mont_sqr(ctx, w, w)) {
+                    result = 20;
+                    goto end;
+                }
+                big_int_cmp(w, one, &cmp_flag);
+                if (cmp_flag == 0) {
+                    break;
+                }
+            }
+            if (i >= m) {
+                /* pow(t, 2^(m - 1)) != 1, it is possible only for composite [p] */
+                result = 3;
+                goto end;
+            }
+            /* x = x * pow(z, Q * 2^(s - i - 1)), t = t * pow(z, Q * 2^(s - i)) */
+            if (big_int_mont_mul(ctx, x, g[s - i - 1], x) ||
+                big_int_mont_mul(ctx, t, g[s - i], t)) {
+                result = 21;
+                goto end;
+            }
+            m = i;
+        }
+    }
+
+    /* check the root. It can be wrong only for composite [p] */
+    if (big_int_mont_sqr(ctx, x, t)) {
+        result = 22;
+        goto end;
+    }
+    big_int_cmp(t, am, &cmp_flag);
+    if (cmp_flag != 0) {
+        result = 3;
+        goto end;
+    }
+
+    /* convert [x] from Montgomery form and choose the least root */
+    if (big_int_mont_from(ctx, x, x) || big_int_sub(p_abs, x, t)) {
+        result = 23;
+        goto end;
+    }
+    big_int_cmp(t, x, &cmp_flag);
+    if (big_int_copy((cmp_flag < 0) ? t : x, answer)) {
+        result = 24;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    if (g != NULL) {
+        for (j = 0; j < s; j++) {
+            big_int_destroy(g[j]);
+        }
+        bi_free(g);
+    }
+    big_int_mont_destroy(ctx);
+    big_int_destroy(one);
+    big_int_destroy(am);
+    big_int_destroy(w);
+    big_int_destroy(t);
+    big_int_destroy(x);
+    big_int_destroy(e);
+    big_int_destroy(a_copy);
+    big_int_destroy(p_abs);
+
+    return result;
+}
+
 /**
     Compares [a] with [b] (mod modulus).
     
@@ -0,0 +1,644 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h> /* for assert() */
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+#include "memory_manager.h"
+#include "service_funcs.h"
+#include "num_buffer.h"
+#include "basic_funcs.h"
+#include "bitset_funcs.h"
+#include "montgomery.h"
+
+/**
+    Creates Montgomery context for [modulus].
+    Sign of [modulus] is ignored.
+
+    Returns pointer to created context.
+    On error returns NULL pointer.
+
+    Restrictions:
+        1) [modulus] must be odd and abs(modulus) > 1
+*/
+big_int_mont * big_int_mont_create(const big_int *modulus)
+{
+    big_int_mont *ctx;
+    big_int *n = NULL, *r2 = NULL;
+    size_t n_bits;
+
+    assert(modulus != NULL);
+
+    if (!(modulus->num[0] & 1) || (modulus->len == 1 && modulus->num[0] == 1)) {
+        return NULL;
+    }
+
+    /* R^2 = 2^(2 * BIG_INT_WORD_BITS_CNT * length(modulus)) */
+    n_bits = 2 * BIG_INT_WORD_BITS_CNT * modulus->len;
+    if (n_bits > (size_t) (~0u >> 1)) {
+        return NULL;
+    }
+
+    ctx = (big_int_mont *) bi_malloc(sizeof(big_int_mont));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    n = big_int_dup(modulus);
+    r2 = big_int_create(modulus->len * 2 + 1);
+    if (n == NULL || r2 == NULL) {
+        goto error;
+    }
+    n->sign = PLUS;
+    if (big_int_from_int(1, r2)) {
+        goto error;
+    }
+    if (big_int_lshift(r2, (int) n_bits, r2)) {
+        goto error;
+    }
+    if (big_int_mod(r2, n, r2)) {
+        goto error;
+    }
+    ctx->modulus = n;
+    ctx->r2 = r2;
+    ctx->n0_inv = low_level_mont_inverse(n->num[0]);
+
+    return ctx;
+
+error:
+    big_int_destroy(r2);
+    big_int_destroy(n);
+    bi_free(ctx);
+    return NULL;
+}
+
+/**
+    Frees memory, allocated for Montgomery context [ctx]
+*/
+void big_int_mont_destroy(big_int_mont *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    big_int_destroy(ctx->r2);
+    big_int_destroy(ctx->modulus);
+    bi_free(ctx);
+}
+
+/**
+    Converts [a] to Montgomery form:
+        answer = a * R (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+int big_int_mont_to(const big_int_mont *ctx, const big_int *a, big_int *answer)
+{
+    big_int *a_copy = NULL;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    if (big_int_is_reduced(a, ctx->modulus)) {
+        return big_int_mont_mul(ctx, a, ctx->r2, answer) ? 3 : 0;
+    }
+
+    a_copy = big_int_create(ctx->modulus->len);
+    if (a_copy == NULL) {
+        result = 1;
+        goto end;
+    }
+    if (big_int_mod(a, ctx->modulus, a_copy)) {
+        result = 2;
+        goto end;
+    }
+    if (a_copy->sign == MINUS) {
+        if (big_int_add(a_copy, ctx->modulus, a_copy)) {
+            result = 2;
+            goto end;
+        }
+    }
+    if (big_int_mont_mul(ctx, a_copy, ctx->r2, answer)) {
+        result = 3;
+        goto end;
+    }
+
+end:
+    big_int_destroy(a_copy);
+
+    return result;
+}
+
+/**
+    Converts [a] from Montgomery form:
+        answer = a / R (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_mont_from(const big_int_mont *ctx, const big_int *a, big_int *answer)
+{
+    big_int_word *t;
+    size_t n_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus)) {
+        return 1;
+    }
+
+    n_len = ctx->modulus->len;
+    t = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * (2 * n_len + 1));
+    if (t == NULL) {
+        return 2;
+    }
+    big_int_copy_to_buffer(a, t, 2 * n_len + 1);
+    low_level_mont_redc(t, ctx->modulus->num, n_len, ctx->n0_inv, t);
+    if (big_int_set_from_buffer(t, n_len, answer)) {
+        result = 2;
+    }
+    bi_free(t);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * b / R (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] or [b] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_mont_mul(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    big_int_word *aa, *bb, *tmp;
+    size_t n_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus) || !big_int_is_reduced(b, ctx->modulus)) {
+        return 1;
+    }
+
+    n_len = ctx->modulus->len;
+    aa = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (2 * n_len + low_level_mont_mul_tmp_len(n_len)));
+    if (aa == NULL) {
+        return 2;
+    }
+    bb = aa + n_len;
+    tmp = bb + n_len;
+    big_int_copy_to_buffer(a, aa, n_len);
+    if (a == b) {
+        bb = aa;
+    } else {
+        big_int_copy_to_buffer(b, bb, n_len);
+    }
+    low_level_mont_mul(aa, bb, ctx->modulus->num, n_len, ctx->n0_inv, aa, tmp);
+    if (big_int_set_from_buffer(aa, n_len, answer)) {
+        result = 2;
+    }
+    bi_free(aa);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * a / R (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_mont_sqr(const big_int_mont *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return big_int_mont_mul(ctx, a, a, answer);
+}
+
+/**
+    Calculates
+        answer = pow(a, abs(b)) (mod modulus)
+    [a] and [answer] are in the ordinary form, not in Montgomery form.
+    All intermediate values are kept in Montgomery form.
+    Sliding-window exponentiation is used, see low_level_pow_window().
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_mont_pow(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    const big_int_word *n;
+    big_int_word *x, *table, *tmp;
+    big_int_word window;
+    unsigned int n_bits;
+    size_t n_len, window_bits, window_len, table_cnt, i;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus)) {
+        return 1;
+    }
+
+    /* pow(a, 0) = 1 */
+    if (b->len == 1 && b->num[0] == 0) {
+        return big_int_from_int(1, answer) ? 2 : 0;
+    }
+
+    n = ctx->modulus->num;
+    n_len = ctx->modulus->len;
+    big_int_bit_length(b, &n_bits);
+    window_bits = low_level_pow_window_bits(n_bits);
+    table_cnt = (size_t) 1 << (window_bits - 1);
+
+    /*
+        layout of buffer:
+            x - [n_len] digits
+            table = {a, a^3, ..., a^(2 * table_cnt - 1)} - [table_cnt * n_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        ((table_cnt + 1) * n_len + low_level_mont_mul_tmp_len(n_len)));
+    if (x == NULL) {
+        return 2;
+    }
+    table = x + n_len;
+    tmp = table + table_cnt * n_len;
+
+    /* table[0] = a * R (mod n) */
+    big_int_copy_to_buffer(a, table, n_len);
+    big_int_copy_to_buffer(ctx->r2, x, n_len);
+    low_level_mont_mul(table, x, n, n_len, ctx->n0_inv, table, tmp);
+
+    /* table[i] = table[i - 1] * a^2 */
+    if (table_cnt > 1) {
+        low_level_mont_sqr(table, n, n_len, ctx->n0_inv, x, tmp);
+        for (i = 1; i < table_cnt; i++) {
+            low_level_mont_mul(table + (i - 1) * n_len, x, n, n_len, ctx->n0_inv,
+                table + i * n_len, tmp);
+        }
+    }
+
+    /* the first window always starts with bit 1 */
+    window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+    memcpy(x, table + (window >> 1) * n_len, BIG_INT_WORD_BYTES_CNT * n_len);
+    n_bits -= window_len;
+    while (n_bits) {
+        window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+        n_bits -= window_len;
+        while (window_len--) {
+            low_level_mont_sqr(x, n, n_len, ctx->n0_inv, x, tmp);
+        }
+        if (window) {
+            low_level_mont_mul(x, table + (window >> 1) * n_len, n, n_len, ctx->n0_inv, x, tmp);
+        }
+    }
+
+    /* convert [x] from Montgomery form */
+    memcpy(tmp, x, BIG_INT_WORD_BYTES_CNT * n_len);
+    memset(tmp + n_len, 0, BIG_INT_WORD_BYTES_CNT * (n_len + 1));
+    low_level_mont_redc(tmp, n, n_len, ctx->n0_inv, x);
+    if (big_int_set_from_buffer(x, n_len, answer)) {
+        result = 2;
+    }
+    bi_free(x);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = pow(a[0], abs(b[0])) * ... * pow(a[n - 1], abs(b[n - 1])) (mod modulus)
+    [a[i]] and [answer] are in the ordinary form, not in Montgomery form.
+
+    Interleaved sliding-window exponentiation is used: every exponent
+    is split into windows by low_level_pow_window() and has its own table
+    of odd powers, but all exponents share the same chain of squarings.
+    So only max(length(b[i])) squarings are made instead of
+    length(b[0]) + ... + length(b[n - 1]).
+
+    Returns error number:
+        0 - no errors
+        1 - [a[i]] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_mont_multi_pow(const big_int_mont *ctx, const big_int **a, const big_int **b,
+    size_t n, big_int *answer)
+{
+    const big_int_word *m;
+    big_int_word *x, *windows, *tables, *table, *tmp;
+    size_t *n_bits, *window_bits, *table_pos;
+    unsigned int bits;
+    size_t m_len, tables_len, max_bits, window_len, table_cnt, i, j;
+    int is_one, result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL || n == 0);
+    assert(b != NULL || n == 0);
+    assert(answer != NULL);
+
+    for (i = 0; i < n; i++) {
+        if (!big_int_is_reduced(a[i], ctx->modulus)) {
+            return 1;
+        }
+    }
+
+    /* product of zero powers is 1 */
+    if (n == 0) {
+        return big_int_from_int(1, answer) ? 2 : 0;
+    }
+
+    m = ctx->modulus->num;
+    m_len = ctx->modulus->len;
+
+    /*
+        n_bits[i] - number of bits of b[i], which are not processed yet
+        window_bits[i] - window size for b[i]
+        table_pos[i] - position of table for a[i] in [tables]
+    */
+    n_bits = (size_t *) bi_malloc(sizeof(*n_bits) * 3 * n);
+    if (n_bits == NULL) {
+        return 2;
+    }
+    window_bits = n_bits + n;
+    table_pos = window_bits + n;
+
+    tables_len = 0;
+    max_bits = 0;
+    for (i = 0; i < n; i++) {
+        big_int_bit_length(b[i], &bits);
+        n_bits[i] = bits;
+        window_bits[i] = low_level_pow_window_bits(bits);
+        table_pos[i] = tables_len;
+        if (bits) {
+            tables_len += ((size_t) 1 << (window_bits[i] - 1)) * m_len;
+        }
+        if (max_bits < n_bits[i]) {
+            max_bits = n_bits[i];
+        }
+    }
+
+    /*
+        layout of buffer:
+            x - [m_len] digits
+            windows - current window for every exponent, [n] digits
+            tables = {a[i], a[i]^3, ..., a[i]^(2 * table_cnt - 1)} for every
+                nonzero b[i] - [tables_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (m_len + n + tables_len + low_level_mont_mul_tmp_len(m_len)));
+    if (x == NULL) {
+        result = 2;
+        goto end;
+    }
+    windows = x + m_len;
+    tables = windows + n;
+    tmp = tables + tables_len;
+
+    for (i = 0; i < n; i++) {
+        windows[i] = 0;
+        if (n_bits[i] == 0) {
+            continue;
+        }
+        table = tables + table_pos[i];
+        table_cnt = (size_t) 1 << (window_bits[i] - 1);
+
+        /* table[0] = a[i] * R (mod modulus) */
+        big_int_copy_to_buffer(a[i], table, m_len);
+        big_int_copy_to_buffer(ctx->r2, x, m_len);
+        low_level_mont_mul(table, x, m, m_len, ctx->n0_inv, table, tmp);
+
+        /* table[j] = table[j - 1] * a[i]^2 */
+        if (table_cnt > 1) {
+            low_level_mont_sqr(table, m, m_len, ctx->n0_inv, x, tmp);
+            for (j = 1; j < table_cnt; j++) {
+                low_level_mont_mul(table + (j - 1) * m_len, x, m, m_len, ctx->n0_inv,
+                    table + j * m_len, tmp);
+            }
+        }
+
+        /*
+            the first window always starts with bit 1. It must be multiplied
+            into [x], when bit number n_bits[i] of exponent is reached
+        */
+        windows[i] = low_level_pow_window(b[i]->num, n_bits[i], window_bits[i], &window_len);
+        n_bits[i] -= window_len;
+    }
+
+    /*
+        [x] stays equal to 1 until the first multiplication,
+        so squarings of 1 are skipped
+    */
+    is_one = 1;
+    j = max_bits;
+    while (j--) {
+        if (!is_one) {
+            low_level_mont_sqr(x, m, m_len, ctx->n0_inv, x, tmp);
+        }
+        for (i = 0; i < n; i++) {
+            if (windows[i] == 0 || n_bits[i] != j) {
+                continue;
+            }
+            table = tables + table_pos[i] + (windows[i] >> 1) * m_len;
+            if (is_one) {
+                memcpy(x, table, BIG_INT_WORD_BYTES_CNT * m_len);
+                is_one = 0;
+            } else {
+                low_level_mont_mul(x, table, m, m_len, ctx->n0_inv, x, tmp);
+            }
+
+            /* find the next nonzero window of b[i] */
+            windows[i] = 0;
+            while (n_bits[i] && windows[i] == 0) {
+                windows[i] = low_level_pow_window(b[i]->num, n_bits[i], window_bits[i],
+                    &window_len);
+                n_bits[i] -= window_len;
+            }
+        }
+    }
+
+    if (is_one) {
+        /* all exponents are zero */
+        if (big_int_from_int(1, answer)) {
+            result = 2;
+        }
+        goto end;
+    }
+
+    /* convert [x] from Montgomery form */
+    memcpy(tmp, x, BIG_INT_WORD_BYTES_CNT * m_len);
+    memset(tmp + m_len, 0, BIG_INT_WORD_BYTES_CNT * (m_len + 1));
+    low_level_mont_redc(tmp, m, m_len, ctx->n0_inv, x);
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+
+end:
+    bi_free(x);
+    bi_free(n_bits);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = pow(a, abs(b)) (mod modulus)
+    in constant time. [a] and [answer] are in the ordinary form.
+
+    Running time and memory access pattern depend only on lengths
+    of [a], [b] and modulus, but not on their values:
+        - [a] is reduced by modulus with Montgomery multiplications
+          instead of division
+        - exponent is processed by fixed windows of 4 or 5 bits,
+          including leading zero bits up to length(modulus) digits
+        - every table lookup reads the whole table
+        - all numbers are kept in buffers with length(modulus) digits
+
+    Returns error number:
+        0 - no errors
+        1 - memory allocation error
+*/
+int big_int_mont_pow_ct(const big_int_mont *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    const big_int_word *n;
+    big_int_word *x, *r2, *one, *chunk, *e, *tmp;
+    big_int_word is_zero, mask;
+    size_t n_len, e_len, window_bits, len, pos, i;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    n = ctx->modulus->num;
+    n_len = ctx->modulus->len;
+    e_len = (b->len > n_len) ? b->len : n_len;
+    window_bits = (e_len * BIG_INT_WORD_BITS_CNT < 320) ? 4 : 5;
+
+    /*
+        layout of buffer:
+            x, r2, one, chunk - [n_len] digits each
+            e - exponent, [e_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (4 * n_len + e_len + low_level_mont_pow_ct_tmp_len(n_len, window_bits)));
+    if (x == NULL) {
+        return 1;
+    }
+    r2 = x + n_len;
+    one = r2 + n_len;
+    chunk = one + n_len;
+    e = chunk + n_len;
+    tmp = e + e_len;
+
+    big_int_copy_to_buffer(ctx->r2, r2, n_len);
+    big_int_copy_to_buffer(b, e, e_len);
+
+    /* one = R (mod n) */
+    memset(chunk, 0, BIG_INT_WORD_BYTES_CNT * n_len);
+    chunk[0] = 1;
+    low_level_mont_mul_ct(r2, chunk, n, n_len, ctx->n0_inv, one, tmp);
+
+    /*
+        convert abs(a) to Montgomery form by Horner's scheme:
+            a = sum(A[j] * R^j), where 0 <= A[j] < R
+            x = x * R + A[j] * R (mod n)
+        Multiplication by r2 = R^2 (mod n) gives the required factor R.
+    */
+    memset(x, 0, BIG_INT_WORD_BYTES_CNT * n_len);
+    pos = (a->len - 1) / n_len * n_len;
+    while (1) {
+        len = a->len - pos;
+        if (len > n_len) {
+            len = n_len;
+        }
+        memcpy(chunk, a->num + pos, BIG_INT_WORD_BYTES_CNT * len);
+        memset(chunk + len, 0, BIG_INT_WORD_BYTES_CNT * (n_len - len));
+        low_level_mont_mul_ct(chunk, r2, n, n_len, ctx->n0_inv, chunk, tmp);
+        low_level_mont_mul_ct(x, r2, n, n_len, ctx->n0_inv, x, tmp);
+        low_level_addmod_ct(x, chunk, n, n_len, x, tmp);
+        if (pos == 0) {
+            break;
+        }
+        pos -= n_len;
+    }
+    if (a->sign == MINUS) {
+        memset(chunk, 0, BIG_INT_WORD_BYTES_CNT * n_len);
+        low_level_submod_ct(chunk, x, n, n_len, x, tmp);
+    }
+
+    /* is_zero = 0, if both [x] and [e] are zeros */
+    is_zero = 0;
+    for (i = 0; i < n_len; i++) {
+        is_zero |= x[i];
+    }
+    for (i = 0; i < e_len; i++) {
+        is_zero |= e[i];
+    }
+
+    low_level_mont_pow_ct(x, e, e_len, n, n_len, ctx->n0_inv, one, window_bits, x, tmp);
+
+    /* convert [x] from Montgomery form: x = x * 1 / R (mod n) */
+    memset(chunk, 0, BIG_INT_WORD_BYTES_CNT * n_len);
+    chunk[0] = 1;
+    low_level_mont_mul_ct(x, chunk, n, n_len, ctx->n0_inv, x, tmp);
+
+    /*
+        pow(0, 0) = 0, as in big_int_powmod().
+        mask = (is_zero == 0) ? ~0 : 0
+    */
+    is_zero |= (big_int_word) (0 - is_zero);
+    mask = (big_int_word) ((is_zero >> (BIG_INT_WORD_BITS_CNT - 1)) - 1);
+    for (i = 0; i < n_len; i++) {
+        x[i] &= ~mask;
+    }
+    if (big_int_set_from_buffer(x, n_len, answer)) {
+        result = 1;
+    }
+    bi_free(x);
+
+    return result;
+}
@@ -13,15 +13,37 @@
        e-mail:  valyala@gmail.com
 *************************************************************************/
 #include <assert.h> /* for assert() */
+#include <string.h> /* for memcpy() */
 #include "big_int.h"
 #include "basic_funcs.h" /* for basic big_int functions */
 #include "low_level_funcs.h" /* for low level add, sub, etc. funcs */
 #include "bitset_funcs.h" /* for big_int_scan1_bit() */
+#include "get_bit_length.h" /* for get_bit_length() function */
 #include "number_theory.h"
 
 static unsigned int *get_primes_up_to(unsigned int base, unsigned int *primes_cnt);
 static int primality_test(const big_int *a, unsigned int *dividers, unsigned int dividers_cnt,
                           int level, int *is_prime);
+static int range_product(int lo, int hi, big_int *answer);
+static int cofactors_matrix_mul(const big_int_word *m, size_t n_steps,
+                                big_int *x1, big_int *x2, big_int *t1, big_int *t2, big_int *t3);
+static size_t bit_length(const big_int *a);
+static size_t words_bit_length(const big_int_word *a, size_t len);
+static void swap_numbers(big_int **a, big_int **b);
+static int matrix_create(big_int **m);
+static void matrix_destroy(big_int **m);
+static int matrix_set_identity(big_int **m);
+static int matrix_mul(big_int **m, big_int **m1, big_int **t);
+static int matrix_mul_lehmer(big_int **m, const big_int_word *w, big_int **t);
+static int matrix_mul_quotient(big_int **m, const big_int *q, big_int **t);
+static int matrix_apply_inverse(big_int **m, int is_odd, const big_int *u, const big_int *v,
+                                big_int **t);
+static int hgcd_apply(big_int **u, big_int **v, size_t s, big_int **m, int *is_odd,
+                      int *is_reduced, big_int **m1, int is_odd1,
+                      big_int *u1, big_int *v1, size_t p, big_int **t);
+static int hgcd_lehmer(big_int **u, big_int **v, size_t s, size_t n_stop, big_int **m,
+                       int *is_odd, int *is_reduced, big_int **t);
+static int hgcd(big_int **u, big_int **v, big_int **m, int *is_odd, int *is_reduced);
 
 /**
     Private function.
@@ -111,6 +133,7 @@ static int primality_test(const big_int *a, unsigned int *dividers, unsigned int
     static const size_t prime_limits_len[] = {4, 7, 8, 10, 13, 13, 15};
     big_int *tmp = NULL;
     big_int_str *str = NULL;
+    big_int_word rem;
     unsigned int i;
     int cmp_flag;
     int result = 0;
@@ -144,15 +167,24 @@ static int primality_test(const big_int *a, unsigned int *dividers, unsigned int
 
     /* try to find small dividers of [a] using trial division */
     for (i = 0; i < dividers_cnt; i++) {
-        if (big_int_from_int(dividers[i], tmp)) {
-            result = 5;
-            goto end;
-        }
-        if (big_int_mod(a, tmp, tmp)) {
-            result = 6;
-            goto end;
+        if ((big_int_word) dividers[i] == dividers[i]) {
+            /* divider fits into one digit */
+            if (big_int_mod_word(a, (big_int_word) dividers[i], &rem)) {
+                result = 6;
+                goto end;
+            }
+        } else {
+            if (big_int_from_int(dividers[i], tmp)) {
+                result = 5;
+                goto end;
+            }
+            if (big_int_mod(a, tmp, tmp)) {
+                result = 6;
+                goto end;
+            }
+            rem = (tmp->len == 1 && tmp->num[0] == 0) ? 0 : 1;
         }
-        if (tmp->len == 1 && tmp->num[0] == 0) {
+        if (rem == 0) {
             /* found divider dividers[i]. So, [a] is composite */
             *is_prime = 0;
             goto end;
@@ -257,14 +289,613 @@ end:
     return result;
 }
 
+/**
+    Private function.
+
+    Applies matrix m[4], returned by low_level_gcd_lehmer(), to cofactors
+    [x1] and [x2] of Euclid's algorithm:
+        x1' = A * x1 + B * x2
+        x2' = C * x1 + D * x2
+    [t1], [t2], [t3] are temporary numbers.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int cofactors_matrix_mul(const big_int_word *m, size_t n_steps,
+                                big_int *x1, big_int *x2, big_int *t1, big_int *t2, big_int *t3)
+{
+    if (big_int_mul_word(x1, m[0], t1) || big_int_mul_word(x2, m[1], t2) ||
+        big_int_mul_word(x1, m[2], t3) || big_int_mul_word(x2, m[3], x2)) {
+        return 1;
+    }
+    if (n_steps & 1) {
+        /* x1' = |B| * x2 - |A| * x1, x2' = |C| * x1 - |D| * x2 */
+        if (big_int_sub(t2, t1, x1) || big_int_sub(t3, x2, x2)) {
+            return 2;
+        }
+    } else {
+        /* x1' = |A| * x1 - |B| * x2, x2' = |D| * x2 - |C| * x1 */
+        if (big_int_sub(t1, t2, x1) || big_int_sub(x2, t3, x2)) {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Returns bit length of [a]
+*/
+static size_t bit_length(const big_int *a)
+{
+    return (a->len - 1) * BIG_INT_WORD_BITS_CNT + get_bit_length(a->num[a->len - 1]);
+}
+
+/**
+    Private function.
+
+    Returns bit length of number, which is stored in array [a]
+    of size [len]. The array can contain leading zeros.
+*/
+static size_t words_bit_length(const big_int_word *a, size_t len)
+{
+    while (len > 0 && a[len - 1] == 0) {
+        len--;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    return (len - 1) * BIG_INT_WORD_BITS_CNT + get_bit_length(a[len - 1]);
+}
+
+/**
+    Private function.
+
+    Exchanges pointers [a] and [b]
+*/
+static void swap_numbers(big_int **a, big_int **b)
+{
+    big_int *tmp;
+
+    tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/**
+    Private function.
+
+    Creates four numbers m[0] - m[3], which are elements of 2x2 matrix
+        | m[0] m[1] |
+        | m[2] m[3] |
+    and sets the matrix to identity.
+    The matrix must be destroyed by matrix_destroy() even on error.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_create(big_int **m)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        m[i] = big_int_create(1);
+        if (m[i] == NULL) {
+            return 1;
+        }
+    }
+    return matrix_set_identity(m);
+}
+
+/**
+    Private function.
+
+    Destroys matrix, created by matrix_create()
+*/
+static void matrix_destroy(big_int **m)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        big_int_destroy(m[i]);
+        m[i] = NULL;
+    }
+}
+
+/**
+    Private function.
+
+    Sets matrix [m] to identity
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_set_identity(big_int **m)
+{
+    if (big_int_from_int(1, m[0]) || big_int_from_int(0, m[1]) ||
+        big_int_from_int(0, m[2]) || big_int_from_int(1, m[3])) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Calculates
+        m = m * m1
+    [t] points to array of 3 temporary numbers. Numbers in [m] and [t]
+    are exchanged, so only pointers to them remain valid.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_mul(big_int **m, big_int **m1, big_int **t)
+{
+    int i;
+
+    for (i = 0; i < 4; i += 2) {
+        /* (a, b) = (a * m1[0] + b * m1[2], a * m1[1] + b * m1[3]) */
+        if (big_int_mul(m[i], m1[0], t[0]) || big_int_mul(m[i + 1], m1[2], t[1]) ||
+            big_int_add(t[0], t[1], t[0])) {
+            return 1;
+        }
+        if (big_int_mul(m[i], m1[1], t[1]) || big_int_mul(m[i + 1], m1[3], t[2]) ||
+            big_int_add(t[1], t[2], t[1])) {
+            return 2;
+        }
+        swap_numbers(&m[i], &t[0]);
+        swap_numbers(&m[i + 1], &t[1]);
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Multiplies matrix [m] by matrix of Euclid's steps, found
+    by low_level_gcd_lehmer(). w[4] are absolute values of elements
+    of the inverse matrix. Since (u', v') = W * (u, v), then
+        (u, v) = W^(-1) * (u', v'),
+    where all elements of
+        W^(-1) = | w[3] w[1] |
+                 | w[2] w[0] |
+    are non-negative.
+    [t] points to array of 2 temporary numbers.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_mul_lehmer(big_int **m, const big_int_word *w, big_int **t)
+{
+    int i;
+
+    for (i = 0; i < 4; i += 2) {
+        /* (a, b) = (a * w[3] + b * w[2], a * w[1] + b * w[0]) */
+        if (big_int_mul_word(m[i], w[3], t[0]) || big_int_mul_word(m[i + 1], w[2], t[1]) ||
+            big_int_add(t[0], t[1], t[0])) {
+            return 1;
+        }
+        if (big_int_mul_word(m[i], w[1], t[1]) || big_int_mul_word(m[i + 1], w[0], m[i + 1]) ||
+            big_int_add(m[i + 1], t[1], m[i + 1])) {
+            return 2;
+        }
+        swap_numbers(&m[i], &t[0]);
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Multiplies matrix [m] by matrix of Euclid's step with quotient [q]:
+        m = m * | q 1 |
+                | 1 0 |
+    [t] points to array of 1 temporary number.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_mul_quotient(big_int **m, const big_int *q, big_int **t)
+{
+    int i;
+
+    for (i = 0; i < 4; i += 2) {
+        /* (a, b) = (a * q + b, a) */
+        if (big_int_mul(m[i], q, t[0]) || big_int_add(t[0], m[i + 1], t[0])) {
+            return 1;
+        }
+        swap_numbers(&m[i + 1], &t[0]);
+        swap_numbers(&m[i], &m[i + 1]);
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Calculates
+        (t[0], t[1]) = m^(-1) * (u, v),
+    where determinant of [m] is -1, if [is_odd] isn't zero, else 1.
+    [t] points to array of 3 temporary numbers, t[2] is used
+    as temporary number.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int matrix_apply_inverse(big_int **m, int is_odd, const big_int *u, const big_int *v,
+                                big_int **t)
+{
+    /* t[0] = m[3] * u - m[1] * v */
+    if (big_int_mul(m[3], u, t[0]) || big_int_mul(m[1], v, t[2]) ||
+        big_int_sub(t[0], t[2], t[0])) {
+        return 1;
+    }
+    /* t[1] = m[0] * v - m[2] * u */
+    if (big_int_mul(m[0], v, t[1]) || big_int_mul(m[2], u, t[2]) ||
+        big_int_sub(t[1], t[2], t[1])) {
+        return 2;
+    }
+    if (is_odd) {
+        if (big_int_neg(t[0], t[0]) || big_int_neg(t[1], t[1])) {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+/**
+    Private function.
+
+    Applies matrix [m1], found by hgcd() for higher parts of numbers
+        u1 = floor(u / 2^p), v1 = floor(v / 2^p),
+    to the full numbers:
+        (u', v') = m1^(-1) * (u, v)
+    [u1] and [v1] must contain higher parts, reduced by hgcd(), so
+    only lower parts of numbers are multiplied by the matrix:
+        (u', v') = (u1, v1) * 2^p + m1^(-1) * (u mod 2^p, v mod 2^p)
+    [u1] and [v1] are used as temporary numbers.
+
+    The matrix is accepted only if u' > v' >= 2^s. Then [u] and [v]
+    are replaced by [u'] and [v'], [m1] is appended to [m], and
+    [is_reduced] is set to 1. Else [u], [v] and [m] stay unchanged.
+
+    The check guarantees, that [m1] consists of leading steps of Euclid's
+    algorithm for [u] and [v]. Matrix with non-negative elements
+    and determinant +-1, which maps pair of numbers to u' > v' > 0,
+    is the product of unique sequence of Euclid's steps.
+
+    [t] points to array of 5 temporary numbers.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int hgcd_apply(big_int **u, big_int **v, size_t s, big_int **m, int *is_odd,
+                      int *is_reduced, big_int **m1, int is_odd1,
+                      big_int *u1, big_int *v1, size_t p, big_int **t)
+{
+    int cmp_flag;
+
+    if (big_int_subint(*u, 0, p, 0, t[3]) || big_int_subint(*v, 0, p, 0, t[4])) {
+        return 1;
+    }
+    if (matrix_apply_inverse(m1, is_odd1, t[3], t[4], t)) {
+        return 2;
+    }
+    if (big_int_lshift(u1, (int) p, u1) || big_int_add(t[0], u1, t[0]) ||
+        big_int_lshift(v1, (int) p, v1) || big_int_add(t[1], v1, t[1])) {
+        return 3;
+    }
+    if (t[1]->sign == MINUS || bit_length(t[1]) <= s) {
+        return 0;
+    }
+    big_int_cmp(t[0], t[1], &cmp_flag);
+    if (cmp_flag <= 0) {
+        return 0;
+    }
+
+    swap_numbers(u, &t[0]);
+    swap_numbers(v, &t[1]);
+    if (matrix_mul(m, m1, t)) {
+        return 4;
+    }
+    *is_odd ^= is_odd1;
+    *is_reduced = 1;
+
+    return 0;
+}
+
+/**
+    Private function.
+
+    Makes steps of Euclid's algorithm for [u] and [v] while
+    the smaller number remains not less than 2^s and bit length
+    of [u] is greater than [n_stop]. Steps are found
+    by low_level_gcd_lehmer(), if it is possible. Appends steps
+    to matrix [m]. [is_reduced] is set to 1, if at least one step
+    has been made.
+
+    [t] points to array of 3 temporary numbers.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int hgcd_lehmer(big_int **u, big_int **v, size_t s, size_t n_stop, big_int **m,
+                       int *is_odd, int *is_reduced, big_int **t)
+{
+    big_int_word w[4];
+    big_int_word *tmp_buf = NULL, *uu, *vv;
+    size_t len, n_steps, lo, hi, mid;
+    int is_last_step = 0;
+    int result = 0;
+
+    len = (*u)->len;
+    /* Layout of [tmp_buf]: uu[len], vv[len], tmp[2 * len] */
+    tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * 4 * len);
+    if (tmp_buf == NULL) {
+        result = 1;
+        goto end;
+    }
+    uu = tmp_buf;
+    vv = uu + len;
+
+    while (!is_last_step && bit_length(*v) > s && bit_length(*u) > n_stop) {
+        len = (*u)->len;
+        /* [v] is padded by zeros to length of [u] */
+        if (big_int_realloc(*v, len)) {
+            result = 2;
+            goto end;
+        }
+        while ((*v)->len < len) {
+            (*v)->num[(*v)->len++] = 0;
+        }
+
+        n_steps = low_level_gcd_lehmer((*u)->num, (*v)->num, len, (size_t) -1, w);
+        if (n_steps > 0) {
+            memcpy(uu, (*u)->num, BIG_INT_WORD_BYTES_CNT * len);
+            memcpy(vv, (*v)->num, BIG_INT_WORD_BYTES_CNT * len);
+            low_level_gcd_matrix_mul(w, n_steps, uu, vv, len, vv + len);
+            if (words_bit_length(vv, len) <= s) {
+                /*
+                    Steps make [v] too small. Remainders of Euclid's algorithm
+                    decrease, so find the maximum number of steps by
+                    binary search.
+                */
+                lo = 0;
+                hi = n_steps;
+                while (hi - lo > 1) {
+                    mid = lo + (hi - lo) / 2;
+                    n_steps = low_level_gcd_lehmer((*u)->num, (*v)->num, len, mid, w);
+                    assert(n_steps == mid);
+                    memcpy(uu, (*u)->num, BIG_INT_WORD_BYTES_CNT * len);
+                    memcpy(vv, (*v)->num, BIG_INT_WORD_BYTES_CNT * len);
+                    low_level_gcd_matrix_mul(w, n_steps, uu, vv, len, vv + len);
+                    if (words_bit_length(vv, len) <= s) {
+                        hi = mid;
+                    } else {
+                        lo = mid;
+                    }
+                }
+                n_steps = (lo > 0) ? low_level_gcd_lehmer((*u)->num, (*v)->num, len, lo, w) : 0;
+                is_last_step = 1;
+            }
+        }
+        if (n_steps > 0) {
+            low_level_gcd_matrix_mul(w, n_steps, (*u)->num, (*v)->num, len, vv + len);
+            big_int_clear_zeros(*u);
+            big_int_clear_zeros(*v);
+            if (matrix_mul_lehmer(m, w, t)) {
+                result = 3;
+                goto end;
+            }
+            *is_odd ^= (int) (n_steps & 1);
+            *is_reduced = 1;
+            continue;
+        }
+        big_int_clear_zeros(*v);
+        if (is_last_step) {
+            break;
+        }
+
+        /* quotient is too big for Lehmer's step, so make Euclid's step */
+        if (big_int_div_extended(*u, *v, t[1], t[2])) {
+            result = 4;
+            goto end;
+        }
+        if (bit_length(t[2]) <= s) {
+            break;
+        }
+        /* (u, v) = (v, u mod v) */
+        swap_numbers(u, &t[2]);
+        swap_numbers(u, v);
+        if (matrix_mul_quotient(m, t[1], t)) {
+            result = 5;
+            goto end;
+        }
+        *is_odd ^= 1;
+        *is_reduced = 1;
+    }
+
+end:
+    big_int_clear_zeros(*v);
+    bi_free(tmp_buf);
+
+    return result;
+}
+
+/**
+    Private function.
+
+    Half-GCD. Makes steps of Euclid's algorithm for [u] and [v],
+    while the smaller number remains not less than 2^s, where
+    s = floor(n / 2) + 1 and [n] is bit length of [u]. So the numbers
+    are reduced approximately twice. Product of these steps is stored
+    into matrix [m] with non-negative elements:
+        (u, v) = m * (u', v'),
+    determinant of [m] is -1, if [is_odd] isn't zero, else 1.
+    [is_reduced] is set to 1, if at least one step has been made.
+
+    Numbers, not shorter than BIG_INT_HGCD_THRESHOLD digits, are reduced
+    recursively by Schonhage's algorithm in Moller's formulation:
+    the first recursive call reduces the higher half of numbers,
+    found matrix is applied to the full numbers, then the second
+    recursive call reduces the higher half of remaining numbers.
+    Shorter numbers are reduced by Lehmer's steps.
+    So the complexity is O(M(n) * log(n)), where M(n) is the complexity
+    of multiplication.
+
+    Restrictions:
+        1) u >= v >= 0, u > 0
+        2) [m] must points to array of 4 numbers, created by matrix_create()
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int hgcd(big_int **u, big_int **v, big_int **m, int *is_odd, int *is_reduced)
+{
+    big_int *m1[4] = {NULL, NULL, NULL, NULL};
+    big_int *t[5] = {NULL, NULL, NULL, NULL, NULL};
+    big_int *u1 = NULL, *v1 = NULL;
+    size_t n, s, p;
+    int is_odd1, is_reduced1, i;
+    int result = 0;
+
+    *is_odd = 0;
+    *is_reduced = 0;
+    if (matrix_set_identity(m)) {
+        result = 1;
+        goto end;
+    }
+
+    n = bit_length(*u);
+    s = n / 2 + 1;
+    if (bit_length(*v) <= s) {
+        /* numbers cannot be reduced */
+        goto end;
+    }
+
+    for (i = 0; i < 5; i++) {
+        t[i] = big_int_create(1);
+        if (t[i] == NULL) {
+            result = 2;
+            goto end;
+        }
+    }
+
+    if ((*u)->len >= BIG_INT_HGCD_THRESHOLD) {
+        if (matrix_create(m1)) {
+            result = 3;
+            goto end;
+        }
+        u1 = big_int_create(1);
+        v1 = big_int_create(1);
+        if (u1 == NULL || v1 == NULL) {
+            result = 4;
+            goto end;
+        }
+
+        /*
+            The first recursive call reduces higher n - p bits of numbers
+            to about (n - p) / 2 bits, so the full numbers are reduced
+            to about 3n / 4 bits.
+        */
+        p = n / 2;
+        if (big_int_rshift(*u, (int) p, u1) || big_int_rshift(*v, (int) p, v1)) {
+            result = 5;
+            goto end;
+        }
+        if (hgcd(&u1, &v1, m1, &is_odd1, &is_reduced1)) {
+            result = 6;
+            goto end;
+        }
+        if (is_reduced1 &&
+            hgcd_apply(u, v, s, m, is_odd, is_reduced, m1, is_odd1, u1, v1, p, t)) {
+            result = 7;
+            goto end;
+        }
+
+        /*
+            If the first recursive call cannot reduce numbers enough
+            (for example, the first quotient is too big), then make
+            Euclid's steps until [u] becomes not longer than 3n / 4 bits.
+            If it is impossible, then the numbers cannot be reduced further.
+        */
+        p = 3 * (n / 4) + 1;
+        if (hgcd_lehmer(u, v, s, p, m, is_odd, is_reduced, t)) {
+            result = 8;
+            goto end;
+        }
+
+        /*
+            The second recursive call reduces higher 2 * (n - s) bits of numbers
+            to about n - s bits, so the full numbers are reduced to about s bits.
+        */
+        n = bit_length(*u);
+        if (n <= p && bit_length(*v) > s) {
+            p = 2 * s - n;
+            if (big_int_rshift(*u, (int) p, u1) || big_int_rshift(*v, (int) p, v1)) {
+                result = 9;
+                goto end;
+            }
+            if (hgcd(&u1, &v1, m1, &is_odd1, &is_reduced1)) {
+                result = 10;
+                goto end;
+            }
+            if (is_reduced1 &&
+                hgcd_apply(u, v, s, m, is_odd, is_reduced, m1, is_odd1, u1, v1, p, t)) {
+                result = 11;
+                goto end;
+            }
+        }
+    }
+
+    /* make the remaining steps */
+    if (hgcd_lehmer(u, v, s, 0, m, is_odd, is_reduced, t)) {
+        result = 12;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    big_int_destroy(v1);
+    big_int_destroy(u1);
+    for (i = 0; i < 5; i++) {
+        big_int_destroy(t[i]);
+    }
+    matrix_destroy(m1);
+
+    return result;
+}
+
 /**
     Founds Greatest Common Divider (GCD) of [a] and [b].
     Also this function can find two numbers [x] and [y], so
         abs(a)*x + abs(b)*y = gcd
     Note: gcd > 0
+    Note: sign of [y] is changed, if [b] is negative, i. e.
+        abs(a)*x + b*y = gcd
 
     [x] or [y] can be NULL, if we needn't to calculate them.
 
+    Uses Lehmer's algorithm, which finds quotients of Euclid's algorithm
+    by leading digits of numbers and applies many of them at once.
+    Numbers, not shorter than BIG_INT_GCD_HGCD_THRESHOLD digits, are reduced
+    by subquadratic half-GCD algorithm, which finds the same quotients
+    recursively using fast multiplication.
+    So [x] is the same, as calculated by Euclid's algorithm.
+    GCD of single-digit numbers is calculated by binary algorithm.
+
     Returns error number:
         0 - no errors
         1 - division by zero. [a] and [b] cannot be zero.
@@ -273,15 +904,27 @@ end:
 int big_int_gcd_extended(const big_int *a, const big_int *b, big_int *gcd, big_int *x, big_int *y)
 {
     big_int *r1 = NULL, *r2 = NULL, *q = NULL, *tmp;
+    big_int_word *tmp_buf = NULL;
+    big_int *hm[4] = {NULL, NULL, NULL, NULL};
+    big_int *t[3];
+    big_int_word m[4];
+    size_t len, n_steps;
+    int cmp_flag, is_odd, is_reduced;
     int result = 0;
     int need_xy = 0;
-    big_int *x1 = NULL, *x2 = NULL, *x3 = NULL;
+    big_int *x1 = NULL, *x2 = NULL, *x3 = NULL, *x4 = NULL, *x5 = NULL;
 
     assert(a != NULL);
     assert(b != NULL);
     assert(gcd != NULL);
     assert(x != y || x == NULL);
 
+    if (b->len == 1 && b->num[0] == 0) {
+        /* division by zero */
+        result = 1;
+        goto end;
+    }
+
     r1 = big_int_dup(a);
     if (r1 == NULL) {
         result = 2;
@@ -301,7 +944,7 @@ int big_int_gcd_extended(const big_int *a, const big_int *b, big_int *gcd, big_i
     }
 
     if (x != NULL || y != NULL) {
-        /* create temporary numbers [x1], [x2], [x3] to calculate [x] and [y] */
+        /* create temporary numbers [x1] - [x5] to calculate [x] and [y] */
         need_xy = 1;
         x1 = big_int_create(1);
         if (x1 == NULL) {
@@ -322,16 +965,102 @@ int big_int_gcd_extended(const big_int *a, const big_int *b, big_int *gcd, big_i
             goto end;
         }
         x3 = big_int_create(1);
-        if (x3 == NULL) {
+        x4 = big_int_create(1);
+        x5 = big_int_create(1);
+        if (x3 == NULL || x4 == NULL || x5 == NULL) {
             result = 9;
             goto end;
         }
     }
 
-    do {
+    /*
+        Lehmer's algorithm needs r1 >= r2. Else the first quotient
+        of Euclid's algorithm is zero, so exchange [r1] and [r2]
+    */
+    big_int_cmp_abs(r1, r2, &cmp_flag);
+    if (cmp_flag < 0) {
+        tmp = r1;
+        r1 = r2;
+        r2 = tmp;
+        tmp = x1;
+        x1 = x2;
+        x2 = tmp;
+    }
+
+    /* allocate temporary buffer for low_level_gcd_matrix_mul() */
+    tmp_buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * 2 * r1->len);
+    if (tmp_buf == NULL) {
+        result = 10;
+        goto end;
+    }
+    if (big_int_realloc(r2, r1->len)) {
+        result = 11;
+        goto end;
+    }
+    if (r1->len >= BIG_INT_GCD_HGCD_THRESHOLD && matrix_create(hm)) {
+        result = 12;
+        goto end;
+    }
+
+    while (r2->len > 1 || r2->num[0] != 0) {
+        len = r1->len;
+        if (len >= BIG_INT_GCD_HGCD_THRESHOLD) {
+            /* reduce numbers approximately twice by half-GCD */
+            if (hgcd(&r1, &r2, hm, &is_odd, &is_reduced)) {
+                result = 13;
+                goto end;
+            }
+            if (is_reduced) {
+                if (big_int_realloc(r2, r1->len)) {
+                    result = 14;
+                    goto end;
+                }
+                if (need_xy) {
+                    /* (x1, x2) = hm^(-1) * (x1, x2) */
+                    t[0] = x3;
+                    t[1] = x4;
+                    t[2] = x5;
+                    if (matrix_apply_inverse(hm, is_odd, x1, x2, t)) {
+                        result = 15;
+                        goto end;
+                    }
+                    x3 = x1;
+                    x4 = x2;
+                    x1 = t[0];
+                    x2 = t[1];
+                }
+                continue;
+            }
+        }
+        if (!need_xy && r2->len == 1) {
+            /* GCD(r1, r2) = GCD(r2, r1 mod r2) */
+            r1->num[0] = low_level_gcd_1(r2->num[0],
+                low_level_divrem_1(r1->num, r1->num + len, r2->num[0], NULL));
+            r1->len = 1;
+            break;
+        }
+
+        /* [r2] is padded by zeros to length of [r1] */
+        while (r2->len < len) {
+            r2->num[r2->len++] = 0;
+        }
+        n_steps = low_level_gcd_lehmer(r1->num, r2->num, len, (size_t) -1, m);
+        if (n_steps > 0) {
+            low_level_gcd_matrix_mul(m, n_steps, r1->num, r2->num, len, tmp_buf);
+            big_int_clear_zeros(r1);
+            big_int_clear_zeros(r2);
+            if (need_xy && cofactors_matrix_mul(m, n_steps, x1, x2, x3, x4, x5)) {
+                result = 16;
+                goto end;
+            }
+            continue;
+        }
+
+        /* quotient is too big for Lehmer's step, so make Euclid's step */
+        big_int_clear_zeros(r2);
         result = big_int_div_extended(r1, r2, q, r1);
         if (result) {
-            result = (result == 1) ? 1 : 10;
+            result = 17;
             goto end;
         }
         /* exchange [r1] and [r2] */
@@ -342,11 +1071,11 @@ int big_int_gcd_extended(const big_int *a, const big_int *b, big_int *gcd, big_i
         if (need_xy) {
             /* calculate x3 = x1 - q * x2 */
             if (big_int_mul(x2, q, x3)) {
-                result = 11;
+                result = 18;
                 goto end;
             }
             if (big_int_sub(x1, x3, x3)) {
-                result = 12;
+                result = 19;
                 goto end;
             }
             tmp = x1;
@@ -354,36 +1083,47 @@ int big_int_gcd_extended(const big_int *a, const big_int *b, big_int *gcd, big_i
             x2 = x3;
             x3 = tmp;
         }
-    } while (r2->len > 1 || r2->num[0] != 0);
+    }
 
     if (y != NULL) {
-        /* calculate y = (r1 - a * x1) / b */
+        /*
+            calculate y = (r1 - abs(a) * x1) / b. Division is exact,
+            because [x1] is calculated for abs(a)
+        */
         if (big_int_mul(x1, a, x3)) {
-            result = 13;
+            result = 20;
+            goto end;
+        }
+        if (a->sign == MINUS && big_int_neg(x3, x3)) {
+            result = 20;
             goto end;
         }
         if (big_int_sub(r1, x3, x3)) {
-            result = 14;
+            result = 21;
             goto end;
         }
-        if (big_int_div(x3, b, y)) {
-            result = 15;
+        if (big_int_divexact(x3, b, y)) {
+            result = 22;
             goto end;
         }
     }
     if (x != NULL) {
         if (big_int_copy(x1, x)) {
-            result = 16;
+            result = 23;
             goto end;
         }
     }
     if (big_int_copy(r1, gcd)) {
-        result = 17;
+        result = 24;
         goto end;
     }
 
 end:
     /* free allocated memory */
+    bi_free(tmp_buf);
+    matrix_destroy(hm);
+    big_int_destroy(x5);
+    big_int_destroy(x4);
     big_int_destroy(x3);
     big_int_destroy(x2);
     big_int_destroy(x1);
@@ -840,8 +1580,11 @@ end:
 int big_int_pow(const big_int *a, int power, big_int *answer)
 {
     size_t answer_len;
-    size_t n_bits;
-    big_int *answer_copy = NULL;
+    big_int **table = NULL;
+    size_t table_cnt = 0, window_bits, window_len, i;
+    big_int_word window;
+    unsigned int n_bits;
+    big_int *answer_copy = NULL, *power_copy = NULL;
     int result = 0;
 
     assert(a != NULL);
@@ -892,45 +1635,94 @@ int big_int_pow(const big_int *a, int power, big_int *answer)
     }
 
     /*
-        calculate answer = pow(a, power) by the following algorithm:
-            answer = 1;
-            while (power) {
-                answer *= answer;
-                if higher bit of power is 1, then
-                    answer *= a;
-                power <<= 1;
-            }
+        calculate answer = pow(a, power) by sliding-window exponentiation,
+        see low_level_pow_window().
+        table = {a, a^3, ..., a^(2 * table_cnt - 1)}
     */
-    if (big_int_from_int(1, answer_copy)) {
+    power_copy = big_int_create(1);
+    if (power_copy == NULL || big_int_from_int(power, power_copy)) {
         result = 5;
         goto end;
     }
-    n_bits = 8 * sizeof(power);
-    while (n_bits && !(power >> (8 * sizeof(power) - 1))) {
-        power <<= 1;
-        n_bits--;
-    }
-    while (n_bits--) {
-        if (big_int_sqr(answer_copy, answer_copy)) {
+    if (power == 0) {
+        if (big_int_from_int(1, answer_copy)) {
             result = 6;
             goto end;
         }
-        if ((power >> (8 * sizeof(power) - 1))) {
-            if (big_int_mul(answer_copy, a, answer_copy)) {
-                result = 7;
+    } else {
+        big_int_bit_length(power_copy, &n_bits);
+        window_bits = low_level_pow_window_bits(n_bits);
+        table_cnt = (size_t) 1 << (window_bits - 1);
+        table = (big_int **) bi_malloc(sizeof(big_int *) * table_cnt);
+        if (table == NULL) {
+            result = 7;
+            goto end;
+        }
+        for (i = 0; i < table_cnt; i++) {
+            table[i] = big_int_create(1);
+        }
+        for (i = 0; i < table_cnt; i++) {
+            if (table[i] == NULL) {
+                result = 8;
                 goto end;
             }
         }
-        power <<= 1;
+        if (big_int_copy(a, table[0])) {
+            result = 9;
+            goto end;
+        }
+        if (table_cnt > 1) {
+            if (big_int_sqr(a, answer_copy)) {
+                result = 10;
+                goto end;
+            }
+            for (i = 1; i < table_cnt; i++) {
+                if (big_int_mul(table[i - 1], answer_copy, table[i])) {
+                    result = 11;
+                    goto end;
+                }
+            }
+        }
+
+        /* the first window always starts with bit 1 */
+        window = low_level_pow_window(power_copy->num, n_bits, window_bits, &window_len);
+        if (big_int_copy(table[window >> 1], answer_copy)) {
+            result = 12;
+            goto end;
+        }
+        n_bits -= window_len;
+        while (n_bits) {
+            window = low_level_pow_window(power_copy->num, n_bits, window_bits, &window_len);
+            n_bits -= window_len;
+            while (window_len--) {
+                if (big_int_sqr(answer_copy, answer_copy)) {
+                    result = 13;
+                    goto end;
+                }
+            }
+            if (window) {
+                if (big_int_mul(answer_copy, table[window >> 1], answer_copy)) {
+                    result = 14;
+                    goto end;
+                }
+            }
+        }
     }
 
     if (big_int_copy(answer_copy, answer)) {
-        result = 8;
+        result = 15;
         goto end;
     }
 
 end:
     /* free allocated memory */
+    if (table != NULL) {
+        for (i = 0; i < table_cnt; i++) {
+            big_int_destroy(table[i]);
+        }
+        bi_free(table);
+    }
+    big_int_destroy(power_copy);
     if (answer != answer_copy) {
         big_int_destroy(answer_copy);
     }
@@ -938,6 +1730,82 @@ end:
     return result;
 }
 
+/**
+    Private function.
+    Calculates product of all integers in range [lo, hi]:
+        answer = lo * (lo + 1) * ... * hi
+
+    The range is splitted in halves recursively (binary splitting), so
+    long numbers are multiplied only with numbers of similar length.
+    It allows big_int_mul() to use fast multiplication algorithms.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+static int range_product(int lo, int hi, big_int *answer)
+{
+    big_int *tmp = NULL;
+    int mid, result = 0;
+
+    assert(lo > 0);
+    assert(lo <= hi);
+
+    tmp = big_int_create(1);
+    if (tmp == NULL) {
+        result = 1;
+        goto end;
+    }
+
+    if (hi - lo < 16) {
+        /* short range. Multiply its numbers one by one */
+        if (big_int_from_int(lo, answer)) {
+            result = 2;
+            goto end;
+        }
+        while (lo < hi) {
+            ++lo;
+            if ((big_int_word) lo == (unsigned int) lo) {
+                /* [lo] fits into one digit */
+                if (big_int_mul_word(answer, (big_int_word) lo, answer)) {
+                    result = 4;
+                    goto end;
+                }
+                continue;
+            }
+            if (big_int_from_int(lo, tmp)) {
+                result = 3;
+                goto end;
+            }
+            if (big_int_mul(answer, tmp, answer)) {
+                result = 4;
+                goto end;
+            }
+        }
+        goto end;
+    }
+
+    mid = lo + (hi - lo) / 2;
+    if (range_product(lo, mid, answer)) {
+        result = 5;
+        goto end;
+    }
+    if (range_product(mid + 1, hi, tmp)) {
+        result = 6;
+        goto end;
+    }
+    if (big_int_mul(answer, tmp, answer)) {
+        result = 7;
+        goto end;
+    }
+
+end:
+    /* free allocated memory */
+    big_int_destroy(tmp);
+
+    return result;
+}
+
 /**
     Calculates factorial of [n]:
         answer = n!
@@ -949,7 +1817,6 @@ end:
 */
 int big_int_fact(int n, big_int *answer)
 {
-    big_int *a = NULL;
     int result = 0;
 
     assert(answer != NULL);
@@ -960,35 +1827,20 @@ int big_int_fact(int n, big_int *answer)
         goto end;
     }
 
-    a = big_int_create(1);
-    if (a == NULL) {
-        result = 2;
-        goto end;
-    }
-    if (big_int_from_int(n, a)) {
-        result = 3;
+    if (n < 2) {
+        if (big_int_from_int(1, answer)) {
+            result = 2;
+            goto end;
+        }
         goto end;
     }
 
-    if (big_int_from_int(1, answer)) {
-        result = 4;
+    if (range_product(2, n, answer)) {
+        result = 3;
         goto end;
     }
-    while (a->len > 1 || a->num[0] > 1) {
-        if (big_int_mul(answer, a, answer)) {
-            result = 5;
-            goto end;
-        }
-        if (big_int_dec(a, a)) {
-            result = 6;
-            goto end;
-        }
-    }
 
 end:
-    /* free allocated memory */
-    big_int_destroy(a);
-
     return result;
 }
 
@@ -0,0 +1,328 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h> /* for assert() */
+#include "big_int.h"
+#include "get_bit_length.h" /* for get_bit_length() function */
+#include "low_level_funcs.h"
+#include "service_funcs.h"
+#include "bitset_funcs.h"
+#include "reciprocal.h"
+
+static int recip_div(const big_int_recip *ctx, const big_int *a,
+    big_int *q, big_int *r, int is_absmod);
+
+/**
+    Creates reciprocal context for [divisor].
+
+    Returns pointer to created context.
+    On error returns NULL pointer.
+
+    Restrictions:
+        1) [divisor] cannot be zero
+*/
+big_int_recip * big_int_recip_create(const big_int *divisor)
+{
+    big_int_recip *ctx;
+    big_int *b = NULL, *v = NULL;
+    big_int_word *tmp = NULL;
+    size_t n_bits, b_len;
+
+    assert(divisor != NULL);
+
+    if (divisor->len == 1 && divisor->num[0] == 0) {
+        return NULL;
+    }
+
+    ctx = (big_int_recip *) bi_malloc(sizeof(big_int_recip));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    b_len = divisor->len;
+    b = big_int_dup(divisor);
+    if (b == NULL) {
+        goto error;
+    }
+    n_bits = BIG_INT_WORD_BITS_CNT - get_bit_length(b->num[b_len - 1]);
+    if (big_int_lshift(b, (int) n_bits, b)) {
+        goto error;
+    }
+    assert(b->len == b_len);
+
+    if (b_len >= BIG_INT_BZ_DIV_THRESHOLD) {
+        /* reciprocal is used only for long divisors. See recip_div() */
+        v = big_int_create(b_len + 1);
+        tmp = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * low_level_recip_tmp_len(b_len));
+        if (v == NULL || tmp == NULL) {
+            goto error;
+        }
+        low_level_recip(b->num, b->num + b_len, v->num, tmp);
+        v->len = b_len + 1;
+        bi_free(tmp);
+    }
+
+    ctx->divisor = b;
+    ctx->recip = v;
+    ctx->inv = low_level_div_inverse(b->num, b->num + b_len);
+    ctx->shift = n_bits;
+
+    return ctx;
+
+error:
+    bi_free(tmp);
+    big_int_destroy(v);
+    big_int_destroy(b);
+    bi_free(ctx);
+    return NULL;
+}
+
+/**
+    Frees memory, allocated for reciprocal context [ctx]
+*/
+void big_int_recip_destroy(big_int_recip *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    big_int_destroy(ctx->recip);
+    big_int_destroy(ctx->divisor);
+    bi_free(ctx);
+}
+
+/**
+    Private function.
+
+    Calculates quotient and reminder of a / divisor:
+        q = a / divisor
+        r = a % divisor
+    If [is_absmod] is not zero, then [r] is non-negative reminder
+    as in big_int_absmod().
+
+    Dividend is shifted by ctx->shift bits directly into temporary
+    buffer, so no allocations are needed except of this buffer.
+    Division algorithm is chosen by lengths of divisor and quotient:
+        - low_level_div_newton() with precomputed reciprocal,
+          if it exists and quotient is long
+        - low_level_fast_div(), if both divisor and quotient
+          are not shorter than BIG_INT_BZ_DIV_THRESHOLD digits
+        - low_level_div_preinv() with precomputed inverse
+          of divisor for other lengths
+
+    [q] or [r] can be NULL, if the result is not needed.
+
+    Returns error number:
+        0 - no errors
+        other - internal errors
+
+    Restrictions:
+        1) address [q] cannot be equal to [r]
+*/
+static int recip_div(const big_int_recip *ctx, const big_int *a,
+    big_int *q, big_int *r, int is_absmod)
+{
+    const big_int *b;
+    big_int_word *buf = NULL, *t, *c, *tmp;
+    big_int_word tmp_word, flag_c;
+    size_t a_len, b_len, c_len, tmp_len, shift, i;
+    sign_type a_sign, q_sign;
+    int use_newton;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(q != r);
+
+    b = ctx->divisor;
+    b_len = b->len;
+    shift = ctx->shift;
+    a_sign = a->sign;
+    q_sign = (a_sign == b->sign) ? PLUS : MINUS;
+
+    /*
+        [t] gets one additional higher word, so its higher digits
+        are less than [b]. Short dividend is padded by zeros, so
+        length(t) > length(b) always.
+    */
+    a_len = ((a->len > b_len) ? a->len : b_len) + 1;
+    c_len = a_len - b_len;
+
+    use_newton = (ctx->recip != NULL && c_len >= BIG_INT_BZ_DIV_THRESHOLD);
+    if (use_newton) {
+        tmp_len = low_level_div_newton_tmp_len(a_len, b_len);
+    } else if (b_len >= BIG_INT_BZ_DIV_THRESHOLD && c_len >= BIG_INT_BZ_DIV_THRESHOLD) {
+        tmp_len = low_level_fast_div_tmp_len(a_len, b_len);
+    } else {
+        tmp_len = 0;
+    }
+
+    /* layout of [buf]: t[a_len], c[c_len], tmp[tmp_len] */
+    buf = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * (a_len + c_len + tmp_len));
+    if (buf == NULL) {
+        result = 1;
+        goto end;
+    }
+    t = buf;
+    c = t + a_len;
+    tmp = c + c_len;
+
+    /* t = abs(a) << shift */
+    tmp_word = 0;
+    for (i = 0; i < a->len; i++) {
+        t[i] = (a->num[i] << shift) | tmp_word;
+        tmp_word = shift ? (a->num[i] >> (BIG_INT_WORD_BITS_CNT - shift)) : 0;
+    }
+    t[i++] = tmp_word;
+    while (i < a_len) {
+        t[i++] = 0;
+    }
+
+    if (use_newton) {
+        low_level_div_newton(t, t + a_len, b->num, b->num + b_len,
+                             ctx->recip->num, c, c + c_len, tmp);
+    } else if (tmp_len) {
+        low_level_fast_div(t, t + a_len, b->num, b->num + b_len, c, c + c_len, tmp);
+    } else {
+        low_level_div_preinv(t, t + a_len, b->num, b->num + b_len, ctx->inv, c, c + c_len);
+    }
+
+    if (r != NULL) {
+        if (is_absmod && a_sign == MINUS) {
+            /* t = abs(b) - t, if reminder is not zero */
+            i = 0;
+            while (i < b_len && t[i] == 0) {
+                i++;
+            }
+            if (i < b_len) {
+                flag_c = 1;
+                for (i = 0; i < b_len; i++) {
+                    t[i] = (big_int_word) ~t[i] + flag_c;
+                    flag_c = (flag_c && t[i] == 0) ? 1 : 0;
+                }
+                low_level_addto(t, t + b_len, b->num, b->num + b_len);
+            }
+            a_sign = PLUS;
+        }
+        if (big_int_realloc(r, b_len)) {
+            result = 2;
+            goto end;
+        }
+        /* r = t >> shift */
+        for (i = 0; i < b_len - 1; i++) {
+            r->num[i] = (t[i] >> shift) | (shift ? (t[i + 1] << (BIG_INT_WORD_BITS_CNT - shift)) : 0);
+        }
+        r->num[i] = t[i] >> shift;
+        r->len = b_len;
+        r->sign = a_sign;
+        big_int_clear_zeros(r);
+    }
+    if (q != NULL) {
+        if (big_int_realloc(q, c_len)) {
+            result = 3;
+            goto end;
+        }
+        for (i = 0; i < c_len; i++) {
+            q->num[i] = c[i];
+        }
+        q->len = c_len;
+        q->sign = q_sign;
+        big_int_clear_zeros(q);
+    }
+
+end:
+    bi_free(buf);
+
+    return result;
+}
+
+/**
+    Calculates quotient and reminder of a / divisor, where [divisor]
+    is the number, passed to big_int_recip_create():
+        q = a / divisor
+        r = a % divisor
+    Results are the same as results of big_int_div_extended().
+
+    [q] or [r] can be NULL, if the result is not needed.
+
+    Returns error number:
+        0 - no errors
+        other - internal errors
+
+    Restrictions:
+        1) address [q] cannot be equal to [r]
+*/
+int big_int_recip_div_extended(const big_int_recip *ctx, const big_int *a,
+    big_int *q, big_int *r)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(q != r);
+
+    return recip_div(ctx, a, q, r, 0);
+}
+
+/**
+    Divides [a] by divisor of context [ctx]:
+        answer = a / divisor
+    Result is the same as result of big_int_div().
+
+    Returns error number:
+        0 - no errors
+        other - internal errors
+*/
+int big_int_recip_div(const big_int_recip *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return recip_div(ctx, a, answer, NULL, 0);
+}
+
+/**
+    Finds reminder of the division [a] by divisor of context [ctx]:
+        answer = a mod divisor
+    Result is the same as result of big_int_mod().
+
+    Returns error number:
+        0 - no errors
+        other - internal errors
+*/
+int big_int_recip_mod(const big_int_recip *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return recip_div(ctx, a, NULL, answer, 0);
+}
+
+/**
+    Calculates non-negative reminder of the division [a]
+    by divisor of context [ctx]:
+        answer = a (mod divisor)
+    Result is the same as result of big_int_absmod().
+
+    Returns error number:
+        0 - no errors
+        other - internal errors
+*/
+int big_int_recip_absmod(const big_int_recip *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return recip_div(ctx, a, NULL, answer, 1);
+}
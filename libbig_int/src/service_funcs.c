@@ -13,10 +13,12 @@
        e-mail:  valyala@gmail.com
 *************************************************************************/
 #include <assert.h> /* for assert() */
-#include <string.h> /* for memcpy */
+#include <string.h> /* for memcpy, memset */
 #include "big_int.h"
+#include "get_bit_length.h" /* for get_bit_length() function */
 #include "low_level_funcs.h" /* for low level add, sub, etc. funcs */
 #include "service_funcs.h"
+#include "num_buffer.h"
 
 /*
     Digits chartable, which used to convert numbers,
@@ -254,11 +256,11 @@ void big_int_clear_zeros(big_int *a)
 */
 int big_int_from_str(const big_int_str *s, unsigned int base, big_int *answer)
 {
-    size_t str_length, len;
-    big_int_word *a, *a_end, *aa;
+    size_t str_length, len, a_len;
+    big_int_word *a;
     char *str, *str_end;
     big_int_word digit, digit_norm;
-    big_int_dword tmp1, base_norm;
+    big_int_dword base_norm;
     unsigned int i, base_pow;
     static big_int_word digit_table[256];
     static int is_not_digit_table = 1;
@@ -332,7 +334,7 @@ int big_int_from_str(const big_int_str *s, unsigned int base, big_int *answer)
 
     /* try to convert number into [big_int] format */
     a = answer->num;
-    a_end = a + len - 1;
+    a_len = 1;
     str_end = str + str_length;
     do {
         /*
@@ -356,14 +358,18 @@ int big_int_from_str(const big_int_str *s, unsigned int base, big_int *answer)
         while (i--) {
             base_norm /= base;
         }
-        tmp1 = 0;
-        aa = a;
-        do {
-            tmp1 += base_norm * (*aa);
-            *aa++ = BIG_INT_LO_WORD(tmp1);
-            tmp1 >>= BIG_INT_WORD_BITS_CNT;
-        } while (aa < a_end);
-        low_level_add(a, a_end, &digit_norm, (&digit_norm) + 1, a);
+        /*
+            a = a * base_norm + digit_norm. Only [a_len] lower digits
+            of [a] can be non-zero, so higher digits are skipped
+        */
+        digit = low_level_mul_1(a, a + a_len, (big_int_word) base_norm, a);
+        if (digit) {
+            a[a_len++] = digit;
+        }
+        low_level_add(a, a + a_len, &digit_norm, (&digit_norm) + 1, a);
+        if (a[a_len]) {
+            a_len++;
+        }
     } while (str < str_end);
 
     answer->len = len;
@@ -384,8 +390,10 @@ int big_int_to_str(const big_int *a, unsigned int base, big_int_str *s)
 {
     size_t len;
     char *str, *str_end, *ss;
-    big_int_word *num, *num_end, *num1;
+    big_int_word *num, *num_end;
+    big_int_word d, v;
     big_int_dword tmp;
+    size_t shift;
     big_int_dword base_norm;
     unsigned int i, base_pow;
     big_int *a_copy = NULL;
@@ -433,20 +441,19 @@ int big_int_to_str(const big_int *a, unsigned int base, big_int_str *s)
         return 3;
     }
 
+    /* normalized [base_norm] and its reciprocal for low_level_divrem_1_preinv() */
+    shift = BIG_INT_WORD_BITS_CNT - get_bit_length((big_int_word) base_norm);
+    d = (big_int_word) (base_norm << shift);
+    v = low_level_div_inverse(&d, (&d) + 1);
+
     num = a_copy->num;
     num_end = num + a_copy->len;
     do {
-        tmp = 0;
         /* skip leading zeros in number */
         while (!*(--num_end) && num_end > num);
+        num_end++;
         /* divide number [a] by base_norm and calculate remainder in [tmp] */
-        num1 = ++num_end;
-        do {
-            tmp <<= BIG_INT_WORD_BITS_CNT;
-            tmp |= *(--num1);
-            *num1 = (big_int_word) (tmp / base_norm);
-            tmp %= base_norm;
-        } while (num1 > num);
+        tmp = low_level_divrem_1_preinv(num, num_end, d, shift, v, num);
         /* convert ramainder [tmp] into char digits */
         i = base_pow;
         do {
@@ -557,20 +564,24 @@ int big_int_to_int(const big_int *a, int *value)
     assert(a != NULL);
     assert(value != NULL);
 
-    if (sizeof(num) < a->len * BIG_INT_WORD_BYTES_CNT) {
-        /* integer overflow */
-        result = 1;
-    }
-
     len = sizeof(num) / BIG_INT_WORD_BYTES_CNT;
     if (len > 1) {
+        if (len < a->len) {
+            /* integer overflow */
+            result = 1;
+        }
         num = 0;
         len = (len < a->len) ? len : a->len;
         for (i = 0; i < len; i++) {
             num |= a->num[i] << (i * BIG_INT_WORD_BITS_CNT);
         }
     } else {
-        num = a->num[0];
+        /* one digit can be longer than [num] */
+        num = (unsigned int) a->num[0];
+        if (a->len > 1 || num != a->num[0]) {
+            /* integer overflow */
+            result = 1;
+        }
     }
     if (num >> (sizeof(num) * 8 - 1)) {
         /* integer overflow */
@@ -764,3 +775,64 @@ int big_int_unserialize(const big_int_str *s, int is_sign, big_int *a)
 
     return 0;
 }
+
+/**
+    Copies digits of [a] to [num] and fills higher digits of [num]
+    with zeros. Sign of [a] is ignored.
+    Private function, see num_buffer.h
+
+    Restrictions:
+        1) length(a) <= len
+        2) [num] must points to array of size [len]
+*/
+void big_int_copy_to_buffer(const big_int *a, big_int_word *num, size_t len)
+{
+    assert(a != NULL);
+    assert(num != NULL);
+    assert(a->len <= len);
+
+    memcpy(num, a->num, BIG_INT_WORD_BYTES_CNT * a->len);
+    memset(num + a->len, 0, BIG_INT_WORD_BYTES_CNT * (len - a->len));
+}
+
+/**
+    Stores non-negative number [num] with length [len] to [answer].
+    Private function, see num_buffer.h
+
+    Returns error number:
+        0 - no errors
+        1 - memory reallocation error
+*/
+int big_int_set_from_buffer(const big_int_word *num, size_t len, big_int *answer)
+{
+    assert(num != NULL);
+    assert(answer != NULL);
+
+    if (big_int_realloc(answer, len)) {
+        return 1;
+    }
+    memcpy(answer->num, num, BIG_INT_WORD_BYTES_CNT * len);
+    answer->len = len;
+    answer->sign = PLUS;
+    big_int_clear_zeros(answer);
+
+    return 0;
+}
+
+/**
+    Returns 1, if 0 <= a < abs(modulus). Else returns 0.
+    Private function, see num_buffer.h
+*/
+int big_int_is_reduced(const big_int *a, const big_int *modulus)
+{
+    assert(a != NULL);
+    assert(modulus != NULL);
+
+    if (a->sign == MINUS && (a->len > 1 || a->num[0])) {
+        return 0;
+    }
+    if (a->len != modulus->len) {
+        return a->len < modulus->len;
+    }
+    return low_level_cmp(a->num, modulus->num, a->len) < 0;
+}
@@ -0,0 +1,457 @@
+/***********************************************************************
+    Copyright 2004, 2005 Alexander Valyalkin
+
+    These sources is free software. You can redistribute it and/or
+    modify it freely. You can use it with any free or commercial
+    software.
+
+    These sources is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY. Without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    You may contact the author by:
+       e-mail:  valyala@gmail.com
+*************************************************************************/
+#include <assert.h> /* for assert() */
+#include <string.h> /* for memcpy, memset */
+#include "big_int.h"
+#include "low_level_funcs.h"
+#include "memory_manager.h"
+#include "service_funcs.h"
+#include "num_buffer.h"
+#include "basic_funcs.h"
+#include "bitset_funcs.h"
+#include "get_bit_length.h" /* for get_bit_length() function */
+#include "modular_arithmetic.h"
+#include "special_mod.h"
+
+static size_t top_bits_cnt(const big_int *a, size_t n_bits, int *bit);
+static size_t nonzero_cnt(const big_int_word *num, size_t len);
+
+/**
+    Private function.
+
+    Returns number of bits of [a], which follow the highest bit
+    and are equal to bit number n_bits - 2. Value of this bit
+    is stored to [bit].
+
+    Restrictions:
+        1) n_bits = length(a) in bits, n_bits >= 2
+*/
+static size_t top_bits_cnt(const big_int *a, size_t n_bits, int *bit)
+{
+    big_int_word fill, w;
+    size_t pos, word_pos, bit_pos, cnt;
+
+    assert(n_bits >= 2);
+
+    /* [pos] - number of bits below the current bit */
+    pos = n_bits - 2;
+    *bit = (int) ((a->num[pos / BIG_INT_WORD_BITS_CNT] >> (pos % BIG_INT_WORD_BITS_CNT)) & 1);
+    fill = *bit ? BIG_INT_MAX_WORD_NUM : 0;
+    cnt = 0;
+    for (;;) {
+        word_pos = pos / BIG_INT_WORD_BITS_CNT;
+        bit_pos = pos % BIG_INT_WORD_BITS_CNT;
+
+        /* bits, which differ from [fill], are set in [w] */
+        w = (big_int_word) (a->num[word_pos] ^ fill);
+        if (bit_pos < BIG_INT_WORD_BITS_CNT - 1) {
+            w &= (big_int_word) (((big_int_word) 1 << (bit_pos + 1)) - 1);
+        }
+        if (w) {
+            while (!(w >> bit_pos)) {
+                bit_pos--;
+                cnt++;
+            }
+            return cnt;
+        }
+        cnt += bit_pos + 1;
+        if (word_pos == 0) {
+            return cnt;
+        }
+        pos -= bit_pos + 1;
+    }
+}
+
+/**
+    Private function.
+
+    Returns number of nonzero digits of [num] with length [len]
+*/
+static size_t nonzero_cnt(const big_int_word *num, size_t len)
+{
+    size_t i, cnt;
+
+    cnt = 0;
+    for (i = 0; i < len; i++) {
+        if (num[i]) {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+/**
+    Creates special-form context for [modulus].
+    Sign of [modulus] is ignored.
+
+    abs(modulus) must be equal to 2^k - c or to 2^k + c, where
+    length of [c] in bits is less than 2/3 of [k]. Then product of two
+    reduced numbers is reduced by at most three foldings.
+    Check of other moduli is fast, so this function can be called
+    just to find out, whether [modulus] has special form.
+
+    Returns pointer to created context.
+    Returns NULL pointer, if [modulus] has not special form, or on error.
+*/
+big_int_special_mod * big_int_special_mod_create(const big_int *modulus)
+{
+    big_int_special_mod *ctx;
+    big_int_word *c, *xh, *x3, *t;
+    big_int_word flag_c;
+    unsigned int n_bits;
+    size_t k, c_len, c_bits, cnt, i;
+    int bit;
+
+    assert(modulus != NULL);
+
+    big_int_bit_length(modulus, &n_bits);
+    if (n_bits < 2) {
+        return NULL;
+    }
+
+    /*
+        modulus = 2^k - c, if bits below the highest bit are ones,
+        or modulus = 2^k + c, if they are zeros.
+        Length of [c] in bits is not greater than k - cnt
+    */
+    cnt = top_bits_cnt(modulus, n_bits, &bit);
+    k = bit ? n_bits : n_bits - 1;
+    if (3 * (k - cnt) >= 2 * k + 3) {
+        return NULL;
+    }
+
+    /* non-adjacent form of [c] can be one bit longer than [c] */
+    c_len = (k - cnt + 1) / BIG_INT_WORD_BITS_CNT + 1;
+    c = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT * 4 * c_len);
+    if (c == NULL) {
+        return NULL;
+    }
+    xh = c + c_len;
+    x3 = xh + c_len;
+    t = x3 + c_len;
+
+    /* c = abs(2^k - modulus) */
+    for (i = 0; i < c_len; i++) {
+        c[i] = (i < modulus->len) ? modulus->num[i] : 0;
+    }
+    if (bit) {
+        /* c = -modulus (mod 2^k) */
+        flag_c = 1;
+        for (i = 0; i < c_len; i++) {
+            c[i] = (big_int_word) (~c[i] + flag_c);
+            if (c[i]) {
+                flag_c = 0;
+            }
+        }
+    }
+    if (k < c_len * BIG_INT_WORD_BITS_CNT) {
+        /* clear bits of [c] starting from bit number [k] */
+        i = k / BIG_INT_WORD_BITS_CNT;
+        c[i] &= (big_int_word) (((big_int_word) 1 << (k % BIG_INT_WORD_BITS_CNT)) - 1);
+        while (++i < c_len) {
+            c[i] = 0;
+        }
+    }
+    c_bits = 0;
+    for (i = c_len; i > 0; i--) {
+        if (c[i - 1]) {
+            c_bits = (i - 1) * BIG_INT_WORD_BITS_CNT + get_bit_length(c[i - 1]);
+            break;
+        }
+    }
+    if (3 * c_bits >= 2 * k) {
+        bi_free(c);
+        return NULL;
+    }
+
+    /*
+        non-adjacent form of [c] is c = t - xh, where
+            xh = floor(c / 2), x3 = c + xh,
+            t = x3 & (xh ^ x3), xh = xh & (xh ^ x3)
+    */
+    flag_c = 0;
+    for (i = 0; i < c_len; i++) {
+        xh[i] = (big_int_word) ((c[i] >> 1) |
+            ((i + 1 < c_len) ? c[i + 1] << (BIG_INT_WORD_BITS_CNT - 1) : 0));
+        x3[i] = (big_int_word) (c[i] + xh[i] + flag_c);
+        flag_c = (x3[i] < c[i] || (flag_c && x3[i] == c[i])) ? 1 : 0;
+    }
+    for (i = 0; i < c_len; i++) {
+        t[i] = (big_int_word) (x3[i] & (xh[i] ^ x3[i]));
+        xh[i] &= (big_int_word) (xh[i] ^ x3[i]);
+    }
+    if (nonzero_cnt(t, c_len) + nonzero_cnt(xh, c_len) < nonzero_cnt(c, c_len)) {
+        /* keep non-adjacent form (t, xh) */
+        memcpy(c, t, BIG_INT_WORD_BYTES_CNT * c_len);
+    } else {
+        /* keep (c, 0) */
+        memset(xh, 0, BIG_INT_WORD_BYTES_CNT * c_len);
+    }
+    if (!bit) {
+        /* modulus = 2^k + c = 2^k - xh + c */
+        memcpy(t, c, BIG_INT_WORD_BYTES_CNT * c_len);
+        memcpy(c, xh, BIG_INT_WORD_BYTES_CNT * c_len);
+        memcpy(xh, t, BIG_INT_WORD_BYTES_CNT * c_len);
+    }
+
+    ctx = (big_int_special_mod *) bi_malloc(sizeof(big_int_special_mod));
+    if (ctx == NULL) {
+        bi_free(c);
+        return NULL;
+    }
+    ctx->modulus = big_int_dup(modulus);
+    if (ctx->modulus == NULL) {
+        bi_free(ctx);
+        bi_free(c);
+        return NULL;
+    }
+    ctx->modulus->sign = PLUS;
+    ctx->c_plus = c;
+    ctx->c_minus = xh;
+    ctx->c_len = c_len;
+    ctx->k = k;
+
+    return ctx;
+}
+
+/**
+    Frees memory, allocated for special-form context [ctx]
+*/
+void big_int_special_mod_destroy(big_int_special_mod *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    bi_free(ctx->c_plus);
+    big_int_destroy(ctx->modulus);
+    bi_free(ctx);
+}
+
+/**
+    Calculates
+        answer = a (mod modulus)
+    Result is the same as result of big_int_absmod().
+    If length(a) in bits is greater than 2 * k, then
+    big_int_absmod() is used.
+
+    Returns error number:
+        0 - no errors
+        other - internal error
+*/
+int big_int_special_mod_reduce(const big_int_special_mod *ctx, const big_int *a, big_int *answer)
+{
+    const big_int *m;
+    big_int_word *x, *tmp;
+    unsigned int n_bits;
+    size_t m_len, x_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    m = ctx->modulus;
+    m_len = m->len;
+    big_int_bit_length(a, &n_bits);
+    if (n_bits > 2 * ctx->k) {
+        return big_int_absmod(a, m, answer) ? 1 : 0;
+    }
+
+    x_len = (a->len > m_len) ? a->len : m_len;
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (x_len + low_level_special_reduce_tmp_len(a->len, m_len, ctx->c_len)));
+    if (x == NULL) {
+        return 2;
+    }
+    tmp = x + x_len;
+    low_level_special_reduce(a->num, a->len, m->num, m_len, ctx->k,
+        ctx->c_plus, ctx->c_minus, ctx->c_len, x, tmp);
+    if (a->sign == MINUS) {
+        /* x = modulus - x for negative [a], if x != 0 */
+        memset(tmp, 0, BIG_INT_WORD_BYTES_CNT * m_len);
+        if (low_level_cmp(x, tmp, m_len) != 0) {
+            memcpy(tmp, m->num, BIG_INT_WORD_BYTES_CNT * m_len);
+            low_level_subfrom(tmp, tmp + m_len, x, x + m_len);
+            memcpy(x, tmp, BIG_INT_WORD_BYTES_CNT * m_len);
+        }
+    }
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(x);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * b (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] or [b] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_special_mod_mul(const big_int_special_mod *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    big_int_word *aa, *bb, *tmp;
+    size_t m_len;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus) || !big_int_is_reduced(b, ctx->modulus)) {
+        return 1;
+    }
+
+    m_len = ctx->modulus->len;
+    aa = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        (2 * m_len + low_level_special_mul_tmp_len(m_len, ctx->c_len)));
+    if (aa == NULL) {
+        return 2;
+    }
+    bb = aa + m_len;
+    tmp = bb + m_len;
+    big_int_copy_to_buffer(a, aa, m_len);
+    if (a == b) {
+        bb = aa;
+    } else {
+        big_int_copy_to_buffer(b, bb, m_len);
+    }
+    low_level_special_mul(aa, bb, ctx->modulus->num, m_len, ctx->k,
+        ctx->c_plus, ctx->c_minus, ctx->c_len, aa, tmp);
+    if (big_int_set_from_buffer(aa, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(aa);
+
+    return result;
+}
+
+/**
+    Calculates
+        answer = a * a (mod modulus)
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_special_mod_sqr(const big_int_special_mod *ctx, const big_int *a, big_int *answer)
+{
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(answer != NULL);
+
+    return big_int_special_mod_mul(ctx, a, a, answer);
+}
+
+/**
+    Calculates
+        answer = pow(a, abs(b)) (mod modulus)
+    Sliding-window exponentiation is used, see low_level_pow_window().
+
+    Returns error number:
+        0 - no errors
+        1 - [a] is out of range [0 .. modulus - 1]
+        2 - memory allocation error
+*/
+int big_int_special_mod_pow(const big_int_special_mod *ctx, const big_int *a, const big_int *b,
+    big_int *answer)
+{
+    const big_int_word *m, *c_plus, *c_minus;
+    big_int_word *x, *table, *tmp;
+    big_int_word window;
+    unsigned int n_bits;
+    size_t m_len, c_len, k, window_bits, window_len, table_cnt, i;
+    int result = 0;
+
+    assert(ctx != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(answer != NULL);
+
+    if (!big_int_is_reduced(a, ctx->modulus)) {
+        return 1;
+    }
+
+    /* pow(a, 0) = 1 (mod modulus), modulus is greater than 1 */
+    if (b->len == 1 && b->num[0] == 0) {
+        return big_int_from_int(1, answer) ? 2 : 0;
+    }
+
+    m = ctx->modulus->num;
+    m_len = ctx->modulus->len;
+    c_plus = ctx->c_plus;
+    c_minus = ctx->c_minus;
+    c_len = ctx->c_len;
+    k = ctx->k;
+
+    big_int_bit_length(b, &n_bits);
+    window_bits = low_level_pow_window_bits(n_bits);
+    table_cnt = (size_t) 1 << (window_bits - 1);
+
+    /*
+        layout of buffer:
+            x - [m_len] digits
+            table = {a, a^3, ..., a^(2 * table_cnt - 1)} - [table_cnt * m_len] digits
+            tmp - the rest
+    */
+    x = (big_int_word *) bi_malloc(BIG_INT_WORD_BYTES_CNT *
+        ((table_cnt + 1) * m_len + low_level_special_mul_tmp_len(m_len, c_len)));
+    if (x == NULL) {
+        return 2;
+    }
+    table = x + m_len;
+    tmp = table + table_cnt * m_len;
+
+    /* table[i] = table[i - 1] * a^2 */
+    big_int_copy_to_buffer(a, table, m_len);
+    if (table_cnt > 1) {
+        low_level_special_mul(table, table, m, m_len, k, c_plus, c_minus, c_len, x, tmp);
+        for (i = 1; i < table_cnt; i++) {
+            low_level_special_mul(table + (i - 1) * m_len, x, m, m_len, k, c_plus, c_minus, c_len,
+                table + i * m_len, tmp);
+        }
+    }
+
+    /* the first window always starts with bit 1 */
+    window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+    memcpy(x, table + (window >> 1) * m_len, BIG_INT_WORD_BYTES_CNT * m_len);
+    n_bits -= window_len;
+    while (n_bits) {
+        window = low_level_pow_window(b->num, n_bits, window_bits, &window_len);
+        n_bits -= window_len;
+        while (window_len--) {
+            low_level_special_mul(x, x, m, m_len, k, c_plus, c_minus, c_len, x, tmp);
+        }
+        if (window) {
+            low_level_special_mul(x, table + (window >> 1) * m_len, m, m_len, k,
+                c_plus, c_minus, c_len, x, tmp);
+        }
+    }
+
+    if (big_int_set_from_buffer(x, m_len, answer)) {
+        result = 2;
+    }
+    bi_free(x);
+
+    return result;
+}
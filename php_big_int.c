@@ -75,10 +75,12 @@ zend_function_entry bi_functions[] =
     ZEND_FE(bi_mulmod, NULL)
     ZEND_FE(bi_divmod, NULL)
     ZEND_FE(bi_powmod, NULL)
+    ZEND_FE(bi_powmod_crt, NULL)
     ZEND_FE(bi_factmod, NULL)
     ZEND_FE(bi_absmod, NULL)
     ZEND_FE(bi_invmod, NULL)
     ZEND_FE(bi_sqrmod, NULL)
+    ZEND_FE(bi_sqrtmod, NULL)
     ZEND_FE(bi_gcd, NULL)
     ZEND_FE(bi_next_prime, NULL)
     ZEND_FE(bi_div_extended, NULL)
@@ -1115,6 +1117,58 @@ ZEND_FUNCTION(bi_powmod)
     tri_op("bi_powmod", big_int_powmod, 2, err, INTERNAL_FUNCTION_PARAM_PASSTHRU);
 }
 
+/**
+    resource bi_powmod_crt(resource c, resource p, resource q, resource dp, resource dq, resource qinv)
+
+    Calculates pow(c, d) (mod p * q) by Chinese remainder theorem,
+    where dp = d (mod p - 1), dq = d (mod q - 1), qinv * q = 1 (mod p).
+    It is RSA private operation with key (p, q, dp, dq, qinv).
+*/
+ZEND_FUNCTION(bi_powmod_crt)
+{
+    const char *errstr = NULL;
+    big_int *answer = NULL;
+    int args_cnt;
+    args_entry args[6] = {0};
+
+    args_cnt = ZEND_NUM_ARGS();
+    if (get_func_args("bi_powmod_crt", 6, 6, &args_cnt, args TSRMLS_CC) == FAILURE) {
+        goto error;
+    }
+
+    answer = big_int_create(1);
+    if (answer == NULL) {
+        errstr = BI_INTERNAL_ERROR;
+        goto error;
+    }
+
+    switch (big_int_powmod_crt(args[0].num, args[1].num, args[2].num,
+        args[3].num, args[4].num, args[5].num, answer)) {
+        case 0: break;
+        case 1:
+            errstr = "bi_powmod_crt(): division by zero";
+            goto error;
+        default:
+            errstr = BI_INTERNAL_ERROR;
+            goto error;
+    }
+
+    free_args(args, args_cnt);
+    /* register [answer] as resource */
+    ZEND_REGISTER_RESOURCE(return_value, answer, resource_type);
+
+    /* do not free [answer], because it is already registered as resource */
+    return;
+
+error:
+    big_int_destroy(answer);
+    free_args(args, args_cnt);
+    if (errstr != NULL) {
+        zend_error(E_WARNING, errstr);
+    }
+    RETVAL_NULL();
+}
+
 /**
     resource bi_factmod(resource a, resource b)
 
@@ -1173,6 +1227,22 @@ ZEND_FUNCTION(bi_sqrmod)
     bin_op("bi_sqrmod", big_int_sqrmod, 1, err, INTERNAL_FUNCTION_PARAM_PASSTHRU);
 }
 
+/**
+    resource bi_sqrtmod(resource a, resource b)
+
+    Calculates sqrt(a) (mod b), where b is prime.
+*/
+ZEND_FUNCTION(bi_sqrtmod)
+{
+    char *err[] = {
+        "bi_sqrtmod(): division by zero",
+        "bi_sqrtmod(): a is not a quadratic residue (mod b)",
+        "bi_sqrtmod(): b is not prime",
+    };
+
+    bin_op("bi_sqrtmod", big_int_sqrtmod, 3, err, INTERNAL_FUNCTION_PARAM_PASSTHRU);
+}
+
 /**
     resource bi_gcd(resource a, resource b)
 
@@ -1347,7 +1417,7 @@ ZEND_FUNCTION(bi_rand)
         }
 
         /* clear higer bits in the higer digit */
-        *(--num) &= (1 << n_bits) - 1;
+        *(--num) &= ((big_int_word) 1 << n_bits) - 1;
 
         big_int_clear_zeros(answer);
     } else {
@@ -177,6 +177,26 @@ SOURCE=libbig_int\src\service_funcs.c
 
 SOURCE=libbig_int\src\str_funcs.c
 # End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\montgomery.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\reciprocal.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\barrett.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\fixed_base.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\special_mod.c
+# End Source File
 # Begin Group "low_level_funcs"
 
 # PROP Default_Filter ""
@@ -220,6 +240,78 @@ SOURCE=libbig_int\src\low_level_funcs\sub.c
 
 SOURCE=libbig_int\src\low_level_funcs\xor.c
 # End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\mul_karatsuba.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\fast_mul.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\toom_cook.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\ntt.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\fast_sqr.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\cpu_features.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\x86_64_adx.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\x86_64_ifma.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\mont_mul.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\pow_window.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\mont_mul_ct.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\div_bz.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\fast_div.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\div_newton.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\barrett_reduce.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\divexact.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\gcd.c
+# End Source File
+# Begin Source File
+
+SOURCE=libbig_int\src\low_level_funcs\special_reduce.c
+# End Source File
 # End Group
 # End Group
 # End Group
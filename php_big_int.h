@@ -28,7 +28,7 @@ extern zend_module_entry bi_module_entry;
 #define BI_VERSION            "1.0.7"
 #define BI_INTERNAL_ERROR     "big_int internal error"
 #define BI_RESOURCE_NAME      "big_int"
-#define BI_MAX_FUNC_ARGS_CNT  3 /* maximum arguments of big_int function, implemented in PHP */
+#define BI_MAX_FUNC_ARGS_CNT  6 /* maximum arguments of big_int function, implemented in PHP */
 
 
 ZEND_MINIT_FUNCTION(bi);
@@ -67,10 +67,12 @@ ZEND_FUNCTION(bi_submod);
 ZEND_FUNCTION(bi_mulmod);
 ZEND_FUNCTION(bi_divmod);
 ZEND_FUNCTION(bi_powmod);
+ZEND_FUNCTION(bi_powmod_crt);
 ZEND_FUNCTION(bi_factmod);
 ZEND_FUNCTION(bi_absmod);
 ZEND_FUNCTION(bi_invmod);
 ZEND_FUNCTION(bi_sqrmod);
+ZEND_FUNCTION(bi_sqrtmod);
 ZEND_FUNCTION(bi_gcd);
 ZEND_FUNCTION(bi_next_prime);
 ZEND_FUNCTION(bi_div_extended);